@@ -0,0 +1,64 @@
+// Politica de Pong 3 -> 8 -> 3 generada por pong_export a partir de Data/pong_model_dense1.weights y Data/pong_model_dense2.weights.
+// No editar a mano: volver a generarla si cambian los pesos.
+#pragma once
+
+#include <array>
+
+namespace pong_policy {
+
+inline constexpr int HIDDEN = 8;
+
+inline constexpr float W1[3][8] = {
+    {-0x1.9fc2a8p-4f, 0x1.7ee7a2p-11f, -0x1.f67dap-5f, 0x1.8a2dd4p-15f, 0x1.0189d8p-4f, -0x1.0babdap-8f, -0x1.ea9098p-6f, 0x1.bc1524p-5f},
+    {0x1.c452aap-5f, 0x1.7145fap-1f, -0x1.0af882p-4f, 0x1.dd4bfp-1f, -0x1.2fa3fcp-3f, 0x1.2701a2p-9f, -0x1.412274p-5f, -0x1.62368cp-4f},
+    {-0x1.57442p-4f, -0x1.b97396p-2f, -0x1.20ebd4p-4f, -0x1.ddc81p-1f, 0x1.fca298p-3f, -0x1.65a8d2p-7f, -0x1.380c16p-4f, -0x1.e7279ap-2f},
+};
+inline constexpr float B1[8] = {-0x1.971e96p-7f, 0x1.290604p-3f, 0x0p+0f, 0x1.ae8b9ap-13f, 0x1.6e72dap-4f, -0x1.17da34p-11f, 0x0p+0f, 0x1.3dc338p-2f};
+inline constexpr float W2[8][3] = {
+    {-0x1.8bbfbcp-4f, -0x1.9afe1ep-6f, 0x1.bca30ap-8f},
+    {-0x1.2a467cp-1f, 0x1.3d16dcp-1f, 0x1.bf0d1cp-8f},
+    {-0x1.116bb2p-4f, 0x1.0b2208p-5f, -0x1.428286p-7f},
+    {0x1.dc68cap-1f, -0x1.dc2396p-1f, 0x1.807db2p-15f},
+    {0x1.06b484p-2f, -0x1.447778p-3f, 0x1.6594bp-6f},
+    {-0x1.446c76p-5f, 0x1.33fdc8p-4f, 0x1.736d8p-5f},
+    {0x1.757944p-4f, 0x1.5cbf8ap-4f, 0x1.01e862p-7f},
+    {-0x1.989ce4p-2f, 0x1.936c58p-2f, -0x1.740f46p-9f},
+};
+inline constexpr float B2[3] = {0x1.b7fdc6p-2f, 0x1.5a01d4p-5f, 0x1.fabe6ap-2f};
+
+constexpr float relu(float x) noexcept { return x > 0.0f ? x : 0.0f; }
+
+/// Salidas de la red para un estado (mismo orden de sumas que PolicySnapshot)
+constexpr std::array<float, 3> outputs(float ball_x, float ball_y, float paddle_y) noexcept {
+    const float h0 = relu(0.0f + ball_x * W1[0][0] + ball_y * W1[1][0] + paddle_y * W1[2][0] + B1[0]);
+    const float h1 = relu(0.0f + ball_x * W1[0][1] + ball_y * W1[1][1] + paddle_y * W1[2][1] + B1[1]);
+    const float h2 = relu(0.0f + ball_x * W1[0][2] + ball_y * W1[1][2] + paddle_y * W1[2][2] + B1[2]);
+    const float h3 = relu(0.0f + ball_x * W1[0][3] + ball_y * W1[1][3] + paddle_y * W1[2][3] + B1[3]);
+    const float h4 = relu(0.0f + ball_x * W1[0][4] + ball_y * W1[1][4] + paddle_y * W1[2][4] + B1[4]);
+    const float h5 = relu(0.0f + ball_x * W1[0][5] + ball_y * W1[1][5] + paddle_y * W1[2][5] + B1[5]);
+    const float h6 = relu(0.0f + ball_x * W1[0][6] + ball_y * W1[1][6] + paddle_y * W1[2][6] + B1[6]);
+    const float h7 = relu(0.0f + ball_x * W1[0][7] + ball_y * W1[1][7] + paddle_y * W1[2][7] + B1[7]);
+    return {
+        0.0f + h0 * W2[0][0] + h1 * W2[1][0] + h2 * W2[2][0] + h3 * W2[3][0] + h4 * W2[4][0] + h5 * W2[5][0] + h6 * W2[6][0] + h7 * W2[7][0] + B2[0],
+        0.0f + h0 * W2[0][1] + h1 * W2[1][1] + h2 * W2[2][1] + h3 * W2[3][1] + h4 * W2[4][1] + h5 * W2[5][1] + h6 * W2[6][1] + h7 * W2[7][1] + B2[1],
+        0.0f + h0 * W2[0][2] + h1 * W2[1][2] + h2 * W2[2][2] + h3 * W2[3][2] + h4 * W2[4][2] + h5 * W2[5][2] + h6 * W2[6][2] + h7 * W2[7][2] + B2[2],
+    };
+}
+
+/// Accion greedy: -1 abajo, 0 quieto, 1 arriba. Si una salida posterior empata con el
+/// maximo vigente devuelve 0, como PongAgent::select_action.
+constexpr int act(float ball_x, float ball_y, float paddle_y) noexcept {
+    const auto o = outputs(ball_x, ball_y, paddle_y);
+    float best = o[0];
+    int index = 0;
+    bool tie = false;
+    if (o[1] > best) { best = o[1]; index = 1; } else if (o[1] == best) { tie = true; }
+    if (o[2] > best) { index = 2; tie = false; } else if (o[2] == best) { tie = true; }
+    return tie ? 0 : index - 1;
+}
+
+/// Misma accion para cualquier estado con campos ball_x, ball_y y paddle_y
+template <typename State>
+constexpr int act(const State& s) noexcept { return act(s.ball_x, s.ball_y, s.paddle_y); }
+
+} // namespace pong_policy
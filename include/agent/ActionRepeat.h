@@ -0,0 +1,165 @@
+#pragma once
+#ifndef ACTION_REPEAT_H
+#define ACTION_REPEAT_H
+
+/**
+ * @file ActionRepeat.h
+ * @brief Repetición de acciones (frame-skip): una decisión del agente vale `repeat` pasos.
+ *
+ * `ActionRepeat` envuelve un EnvGym: aplica la misma acción hasta `repeat` pasos y suma las
+ * recompensas, así que la red se consulta `repeat` veces menos.
+ * `VecActionRepeat` hace lo mismo sobre un VecEnvGym para el entrenamiento y la evaluación en
+ * paralelo. En ambos, con `stop_on_done` la repetición se corta al perder la bola; sin él, el
+ * entorno se reinicia y la acción sigue aplicándose en el episodio nuevo.
+ */
+
+#include "EnvGym.h"
+#include "VecEnvGym.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief EnvGym con cada acción mantenida durante `repeat` pasos.
+class ActionRepeat {
+public:
+    /// @brief Resultado de una decisión repetida.
+    struct Outcome {
+        State state{};                  ///< Estado al terminar la repetición
+        float reward = 0;               ///< Suma de las recompensas de los pasos dados
+        bool done = false;              ///< Algún episodio terminó durante la repetición
+        std::uint32_t steps = 0;        ///< Pasos de entorno dados
+        std::uint32_t hits = 0;         ///< Golpes exitosos
+        std::uint32_t misses = 0;       ///< Bolas perdidas (0 o 1 con stop_on_done)
+        std::uint32_t open_steps = 0;   ///< Pasos del episodio que sigue abierto (0 si terminó y se cortó)
+    };
+
+    /// @param env Entorno a envolver (debe vivir más que el envoltorio)
+    /// @param repeat Pasos por decisión (1 = sin repetir)
+    /// @param stop_on_done Cortar la repetición al terminar el episodio
+    /// @throws std::invalid_argument Si repeat es 0
+    ActionRepeat(EnvGym& env, std::uint32_t repeat, bool stop_on_done = true)
+        : env_(env), repeat_(repeat), stop_on_done_(stop_on_done) {
+        if (repeat == 0) throw std::invalid_argument("ActionRepeat: repeat debe ser mayor que 0");
+    }
+
+    std::uint32_t repeat() const noexcept { return repeat_; }
+    bool stop_on_done() const noexcept { return stop_on_done_; }
+    EnvGym& env() noexcept { return env_; }
+
+    /// @brief Reinicia el entorno envuelto
+    State reset() { return env_.reset(); }
+
+    /// @brief Aplica `action` durante min(repeat, limit) pasos.
+    /// Con stop_on_done y done, el entorno queda en el estado final del episodio (quien llama
+    /// decide cuándo reiniciarlo); sin stop_on_done ya fue reiniciado y sigue en juego.
+    /// @param limit Tope adicional de pasos (para no pasarse de un presupuesto)
+    /// @throws std::invalid_argument Si limit es 0
+    Outcome step(int action, std::uint32_t limit = std::numeric_limits<std::uint32_t>::max()) {
+        if (limit == 0) throw std::invalid_argument("ActionRepeat::step: limit debe ser mayor que 0");
+        Outcome out;
+        const std::uint32_t steps = std::min(repeat_, limit);
+        for (std::uint32_t k = 0; k < steps; ++k) {
+            float reward = 0;
+            bool done = false;
+            env_.step(action, reward, done);
+            ++out.steps;
+            ++out.open_steps;
+            out.reward += reward;
+            if (reward > 0) ++out.hits;
+            if (!done) continue;
+            out.done = true;
+            ++out.misses;
+            out.open_steps = 0;
+            if (stop_on_done_) break;
+            env_.reset();
+        }
+        out.state = env_.state();
+        return out;
+    }
+
+private:
+    EnvGym& env_;
+    std::uint32_t repeat_;
+    bool stop_on_done_;
+};
+
+/// @brief VecEnvGym con cada acción mantenida durante `repeat` pasos en todos los entornos.
+/// Los entornos se reinician solos como en VecEnvGym; con stop_on_done, uno que termina a mitad
+/// de la repetición deja de acumular y se reinicia otra vez al final, así que la próxima
+/// decisión siempre empieza en un saque nuevo.
+class VecActionRepeat {
+public:
+    /// @param envs Entornos a envolver (deben vivir más que el envoltorio)
+    /// @throws std::invalid_argument Si repeat es 0
+    VecActionRepeat(VecEnvGym& envs, std::uint32_t repeat, bool stop_on_done = true)
+        : envs_(envs), repeat_(repeat), stop_on_done_(stop_on_done),
+          rewards_(envs.size()), dones_(envs.size()), hits_(envs.size()), misses_(envs.size()),
+          steps_(envs.size()) {
+        if (repeat == 0) throw std::invalid_argument("VecActionRepeat: repeat debe ser mayor que 0");
+    }
+
+    std::size_t size() const noexcept { return envs_.size(); }
+    std::uint32_t repeat() const noexcept { return repeat_; }
+    VecEnvGym& envs() noexcept { return envs_; }
+
+    /// @brief Aplica cada acción durante `repeat` pasos de su entorno.
+    /// @throws std::invalid_argument Si no hay una acción por entorno
+    void step(std::span<const int> actions) {
+        const std::size_t n = size();
+        std::fill(rewards_.begin(), rewards_.end(), 0.0f);
+        std::fill(dones_.begin(), dones_.end(), 0);
+        std::fill(hits_.begin(), hits_.end(), 0);
+        std::fill(misses_.begin(), misses_.end(), 0);
+        std::fill(steps_.begin(), steps_.end(), 0);
+
+        for (std::uint32_t r = 0; r < repeat_; ++r) {
+            envs_.step(actions);
+            const auto rw = envs_.rewards();
+            const auto dn = envs_.dones();
+            for (std::size_t i = 0; i < n; ++i) {
+                if (stop_on_done_ && dones_[i]) continue;
+                rewards_[i] += rw[i];
+                hits_[i] += rw[i] > 0;
+                misses_[i] += dn[i];
+                dones_[i] |= dn[i];
+                ++steps_[i];
+            }
+        }
+        if (!stop_on_done_) return;
+        for (std::size_t i = 0; i < n; ++i) {
+            // Terminó antes del último paso: lo simulado después no cuenta, vuelve a empezar
+            if (dones_[i] && steps_[i] < repeat_) envs_.reset(i);
+        }
+    }
+
+    /// @brief Copia el estado de cada entorno
+    void observe(std::span<State> out) const { envs_.observe(out); }
+    State state(std::size_t i) const { return envs_.state(i); }
+
+    /// @brief Suma de recompensas de cada entorno en la última repetición
+    std::span<const float> rewards() const noexcept { return rewards_; }
+    /// @brief 1 si el entorno terminó algún episodio en la última repetición
+    std::span<const std::uint8_t> dones() const noexcept { return dones_; }
+    std::span<const std::uint32_t> hits() const noexcept { return hits_; }
+    std::span<const std::uint32_t> misses() const noexcept { return misses_; }
+    /// @brief Pasos que contaron para cada entorno (menos que repeat si se cortó por done)
+    std::span<const std::uint32_t> steps() const noexcept { return steps_; }
+
+private:
+    VecEnvGym& envs_;
+    std::uint32_t repeat_;
+    bool stop_on_done_;
+    std::vector<float> rewards_;
+    std::vector<std::uint8_t> dones_;
+    std::vector<std::uint32_t> hits_, misses_, steps_;
+};
+
+} // namespace utec::nn
+
+#endif // ACTION_REPEAT_H
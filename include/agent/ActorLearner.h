@@ -0,0 +1,262 @@
+#pragma once
+#ifndef ACTOR_LEARNER_H
+#define ACTOR_LEARNER_H
+
+/**
+ * @file ActorLearner.h
+ * @brief DQN con recolección y aprendizaje en hilos separados (arquitectura actor–aprendiz).
+ *
+ * Cada hilo actor tiene su propio VecEnvGym y una copia de solo inferencia de la política
+ * (PolicySnapshot); elige acciones epsilon-greedy, avanza sus entornos y envía cada transición
+ * por su propia cola SPSC sin bloqueos. El aprendiz (el hilo que llama a train()) vacía las
+ * colas por turnos hacia la memoria de repetición, entrena con DQNLearner y cada
+ * `publish_every` actualizaciones publica una política nueva con un intercambio atómico de
+ * puntero: los actores la toman en su siguiente paso sin detenerse.
+ *
+ * El aprendiz conserva la proporción de DQNTrainer (una actualización cada `train_every`
+ * transiciones consumidas), así que el trabajo de aprendizaje es el mismo; lo que cambia es que
+ * simular y elegir acciones ocurre en paralelo en los otros núcleos. Si el aprendiz se atrasa,
+ * las colas se llenan y los actores esperan (la desactualización de la política queda acotada
+ * por `queue_capacity`). El orden entre hilos no es determinista, así que dos corridas con la
+ * misma semilla no dan exactamente el mismo resultado.
+ */
+
+#include "ActionRepeat.h"
+#include "DQNTrainer.h"
+#include "PolicySnapshot.h"
+#include "VecEnvGym.h"
+#include "../utils/random.h"
+#include "../utils/spsc_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Configuración del entrenamiento actor–aprendiz.
+template <typename T>
+struct ActorLearnerConfig {
+    DQNConfig<T> dqn;                 ///< Red, memoria, epsilon y total; dqn.num_envs = entornos por actor
+    size_t num_actors = 0;            ///< Hilos actores; 0 = núcleos disponibles - 1 (al menos 1)
+    size_t queue_capacity = 16384;    ///< Transiciones por cola de actor
+    size_t publish_every = 50;        ///< Actualizaciones entre publicaciones de la política
+};
+
+/// @brief Métricas de una ventana, con los contadores propios de la versión en paralelo.
+struct ActorLearnerStats : DQNStats {
+    size_t actor_stalls = 0;          ///< Veces que un actor encontró su cola llena
+    size_t learner_waits = 0;         ///< Veces que el aprendiz encontró todas las colas vacías
+    std::uint64_t policy_version = 0; ///< Última política publicada
+};
+
+/// @brief Transición tal como viaja de un actor al aprendiz.
+template <typename T>
+struct ActorTransition {
+    State state;
+    State next;
+    T reward = 0;
+    std::int8_t action = 0;
+    bool done = false;
+};
+
+/// @brief Entrenador DQN con varios actores y un aprendiz.
+template <typename T>
+class ActorLearner {
+public:
+    using LogCallback = std::function<void(const ActorLearnerStats&)>;
+
+    /// @throws std::invalid_argument Si queue_capacity, publish_every, num_envs, train_every o
+    /// action_repeat es 0
+    explicit ActorLearner(const ActorLearnerConfig<T>& cfg)
+        : cfg_(cfg), rng_(cfg.dqn.seed), learner_(cfg.dqn, rng_.fork()) {
+        if (cfg.queue_capacity == 0 || cfg.publish_every == 0 || cfg.dqn.num_envs == 0 || cfg.dqn.train_every == 0
+            || cfg.dqn.action_repeat == 0)
+            throw std::invalid_argument(
+                "ActorLearner: queue_capacity, publish_every, num_envs, train_every y action_repeat deben ser mayores que 0");
+        if (cfg_.num_actors == 0) {
+            const unsigned cores = std::thread::hardware_concurrency();
+            cfg_.num_actors = cores > 1 ? cores - 1 : 1;
+        }
+        actors_.reserve(cfg_.num_actors);
+        for (size_t a = 0; a < cfg_.num_actors; ++a)
+            actors_.push_back(std::make_unique<Actor>(cfg_.queue_capacity, rng_.fork()));
+    }
+
+    size_t num_actors() const noexcept { return cfg_.num_actors; }
+    size_t steps() const noexcept { return steps_; }
+    size_t updates() const noexcept { return learner_.updates(); }
+
+    /// @brief Última política publicada (la que usan los actores)
+    const PublishedPolicy<T>& policy() const noexcept { return policy_; }
+
+    /// @brief Lanza los actores y entrena hasta consumir `dqn.total_steps` transiciones.
+    /// @param on_log Se llama cada `log_every` transiciones consumidas
+    /// @return La red en línea entrenada; como en DQNTrainer, se entrega una sola vez
+    /// @throws std::logic_error Si la red ya fue entregada
+    /// @throws Cualquier excepción lanzada dentro de un actor (se relanza al terminar)
+    std::unique_ptr<utec::neural_network::ILayer<T>> train(const LogCallback& on_log = {}) {
+        using Clock = std::chrono::steady_clock;
+        if (released_) throw std::logic_error("ActorLearner::train: la red ya fue entregada");
+        publish();
+
+        std::vector<std::jthread> threads;
+        threads.reserve(actors_.size());
+        for (auto& actor : actors_)
+            threads.emplace_back([this, a = actor.get()](std::stop_token stop) { run_actor(*a, stop); });
+
+        const DQNConfig<T>& dqn = cfg_.dqn;
+        size_t pending_updates = 0;
+        size_t next_log = dqn.log_every;
+        size_t cursor = 0;
+        ActorLearnerStats window;
+        double loss_sum = 0;
+        size_t loss_count = 0;
+        size_t window_steps = 0;
+        size_t window_updates = 0;
+        auto window_start = Clock::now();
+
+        auto consume = [&](const ActorTransition<T>& t) {
+            learner_.push(t.state, t.action, t.reward, t.next, t.done);
+            window.hits += t.reward > 0;
+            window.misses += t.done;
+        };
+
+        while (steps_ < dqn.total_steps && !failed_.load(std::memory_order_acquire)) {
+            // Toma hasta train_every transiciones repartiendo entre colas por turnos
+            const size_t quota = std::min(dqn.train_every, dqn.total_steps - steps_);
+            size_t got = 0;
+            for (size_t k = 0; k < actors_.size() && got < quota; ++k)
+                got += actors_[(cursor + k) % actors_.size()]->queue.consume(consume, quota - got);
+            cursor = (cursor + 1) % actors_.size();
+            if (got == 0) {
+                ++window.learner_waits;
+                std::this_thread::yield();
+                continue;
+            }
+            steps_ += got;
+            window_steps += got;
+            consumed_.store(steps_, std::memory_order_relaxed);
+
+            if (learner_.warmed_up()) {
+                pending_updates += got;
+                for (; pending_updates >= dqn.train_every; pending_updates -= dqn.train_every) {
+                    loss_sum += learner_.update(static_cast<double>(steps_) / static_cast<double>(dqn.total_steps));
+                    ++loss_count;
+                    ++window_updates;
+                    if (learner_.updates() % cfg_.publish_every == 0) publish();
+                }
+            }
+
+            if (dqn.log_every && steps_ >= next_log) {
+                next_log += dqn.log_every;
+                const double seconds = std::chrono::duration<double>(Clock::now() - window_start).count();
+                window.steps = steps_;
+                window.updates = learner_.updates();
+                window.epsilon = DQNTrainer<T>::epsilon_at(dqn, steps_);
+                window.mean_loss = loss_count ? loss_sum / loss_count : 0.0;
+                window.steps_per_sec = seconds > 0 ? window_steps / seconds : 0.0;
+                window.updates_per_sec = seconds > 0 ? window_updates / seconds : 0.0;
+                window.actor_stalls = take_stalls();
+                window.policy_version = policy_.version();
+                if (on_log) on_log(window);
+                window = ActorLearnerStats{};
+                loss_sum = 0;
+                loss_count = 0;
+                window_steps = 0;
+                window_updates = 0;
+                window_start = Clock::now();
+            }
+        }
+
+        for (auto& t : threads) t.request_stop();
+        threads.clear();  // join
+        for (auto& actor : actors_)
+            if (actor->error) std::rethrow_exception(actor->error);
+
+        released_ = true;
+        return learner_.release();
+    }
+
+private:
+    /// @brief Estado propio de un hilo actor
+    struct Actor {
+        utils::SpscQueue<ActorTransition<T>> queue;
+        utils::Xoshiro256 rng;
+        std::atomic<size_t> stalls{0};
+        std::exception_ptr error;
+
+        Actor(size_t capacity, utils::Xoshiro256 stream) : queue(capacity), rng(stream) {}
+    };
+
+    ActorLearnerConfig<T> cfg_;
+    utils::Xoshiro256 rng_;
+    DQNLearner<T> learner_;
+    PublishedPolicy<T> policy_;
+    std::vector<std::unique_ptr<Actor>> actors_;
+    std::atomic<size_t> consumed_{0};   ///< Transiciones consumidas (los actores calculan epsilon con esto)
+    std::atomic<bool> failed_{false};
+    size_t steps_ = 0;
+    std::uint64_t version_ = 0;
+    bool released_ = false;
+
+    /// @brief Copia la red en línea y la publica para los actores
+    void publish() { policy_.publish(std::make_shared<const PolicySnapshot<T>>(learner_.online(), ++version_)); }
+
+    size_t take_stalls() {
+        size_t total = 0;
+        for (auto& actor : actors_) total += actor->stalls.exchange(0, std::memory_order_relaxed);
+        return total;
+    }
+
+    /// @brief Bucle de un actor: política local -> acciones -> paso de entornos -> cola
+    void run_actor(Actor& actor, std::stop_token stop) {
+        try {
+            const size_t n = cfg_.dqn.num_envs;
+            VecEnvGym envs(n, actor.rng.fork());
+            VecActionRepeat repeated(envs, cfg_.dqn.action_repeat);
+            std::vector<State> states(n);
+            std::vector<int> actions(n);
+            std::shared_ptr<const PolicySnapshot<T>> local;
+            envs.observe(states);
+
+            while (!stop.stop_requested()) {
+                policy_.refresh(local);
+                local->act_batch(states, actions);
+                const float eps = DQNTrainer<T>::epsilon_at(cfg_.dqn, consumed_.load(std::memory_order_relaxed));
+                for (auto& a : actions) {
+                    if (actor.rng.uniform01() < eps) a = static_cast<int>(actor.rng.below(3)) - 1;
+                }
+                repeated.step(actions);
+
+                const auto rewards = repeated.rewards();
+                const auto dones = repeated.dones();
+                for (size_t i = 0; i < n; ++i) {
+                    const ActorTransition<T> t{states[i], envs.state(i), static_cast<T>(rewards[i]),
+                                               static_cast<std::int8_t>(actions[i]), dones[i] != 0};
+                    while (!actor.queue.try_push(t)) {
+                        if (stop.stop_requested()) return;
+                        actor.stalls.fetch_add(1, std::memory_order_relaxed);
+                        std::this_thread::yield();
+                    }
+                    states[i] = t.next;
+                }
+            }
+        } catch (...) {
+            actor.error = std::current_exception();
+            failed_.store(true, std::memory_order_release);
+        }
+    }
+};
+
+} // namespace utec::nn
+
+#endif // ACTOR_LEARNER_H
@@ -0,0 +1,265 @@
+#pragma once
+#ifndef COLUMNAR_DATASET_H
+#define COLUMNAR_DATASET_H
+
+/**
+ * @file ColumnarDataset.h
+ * @brief Formato binario por columnas para muestras de Pong, leído sin copias.
+ *
+ * Disposición del archivo (little-endian):
+ *   - ColumnarHeader (32 bytes): magia "PONGCOL1", versión, cantidad de columnas y de filas.
+ *   - Un ColumnDesc (32 bytes) por columna: nombre, tipo y desplazamiento de sus datos.
+ *   - Los datos de cada columna, contiguos y alineados a 64 bytes:
+ *       ball_x, ball_y, ball_vx, ball_vy, paddle_y, reward : float32
+ *       action                                          : int8
+ *
+ * PongColumns proyecta el archivo en memoria y expone cada columna como TensorView, así que
+ * abrir un conjunto de datos no parsea ni copia nada: las páginas se leen al usarlas.
+ */
+
+#include "PongSample.h"
+#include "../algebra/tensor_view.h"
+#include "../utils/mapped_file.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace utec::nn {
+
+static_assert(std::endian::native == std::endian::little, "El formato por columnas es little-endian");
+
+/// @brief Tipo de los elementos de una columna.
+enum class ColumnType : std::uint32_t { Float32 = 0, Int8 = 1 };
+
+/// @brief Cabecera del archivo.
+struct ColumnarHeader {
+    char magic[8];                 ///< "PONGCOL1"
+    std::uint32_t version;         ///< Versión del formato (1)
+    std::uint32_t columns;         ///< Cantidad de ColumnDesc que siguen
+    std::uint64_t rows;            ///< Filas de cada columna
+    std::uint64_t reserved;
+};
+
+/// @brief Esquema de una columna.
+struct ColumnDesc {
+    char name[16];                 ///< Nombre terminado en '\0'
+    ColumnType type;
+    std::uint32_t element_size;    ///< Bytes por elemento
+    std::uint64_t offset;          ///< Desde el inicio del archivo, múltiplo de COLUMN_ALIGNMENT
+};
+
+static_assert(sizeof(ColumnarHeader) == 32 && sizeof(ColumnDesc) == 32);
+
+inline constexpr char COLUMNAR_MAGIC[8] = {'P', 'O', 'N', 'G', 'C', 'O', 'L', '1'};
+inline constexpr std::uint32_t COLUMNAR_VERSION = 1;
+inline constexpr std::size_t COLUMN_ALIGNMENT = 64;
+
+/// @brief Columnas del formato, en el orden en que se escriben.
+enum class PongColumn : std::size_t { BallX, BallY, BallVx, BallVy, PaddleY, Action, Reward, Count };
+
+inline constexpr std::array<std::string_view, 7> PONG_COLUMN_NAMES = {
+    "ball_x", "ball_y", "ball_vx", "ball_vy", "paddle_y", "action", "reward"};
+
+/// @brief ¿El archivo empieza con la magia del formato por columnas?
+inline bool is_columnar_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[8] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) == 0;
+}
+
+/// @brief Escribe un archivo por columnas de `rows` filas, por tramos y en cualquier orden.
+/// La cabecera se escribe al crearlo; cada write() copia su tramo de filas a las siete columnas.
+class ColumnarWriter {
+public:
+    /// @throws std::runtime_error Si el archivo no se puede crear
+    ColumnarWriter(const std::string& path, std::uint64_t rows) : path_(path), rows_(rows) {
+        constexpr std::size_t n_columns = static_cast<std::size_t>(PongColumn::Count);
+        ColumnarHeader header{};
+        std::memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+        header.version = COLUMNAR_VERSION;
+        header.columns = n_columns;
+        header.rows = rows;
+
+        auto align = [](std::uint64_t x) { return (x + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT; };
+        std::uint64_t offset = align(sizeof(ColumnarHeader) + sizeof(ColumnDesc) * n_columns);
+        for (std::size_t c = 0; c < n_columns; ++c) {
+            auto& d = descs_[c];
+            std::memcpy(d.name, PONG_COLUMN_NAMES[c].data(), PONG_COLUMN_NAMES[c].size());
+            const bool label = c == static_cast<std::size_t>(PongColumn::Action);
+            d.type = label ? ColumnType::Int8 : ColumnType::Float32;
+            d.element_size = label ? 1 : 4;
+            d.offset = offset;
+            end_ = offset + rows * d.element_size;
+            offset = align(end_);
+        }
+
+        out_.open(path, std::ios::binary | std::ios::trunc);
+        if (!out_) throw std::runtime_error("No se pudo crear el archivo: " + path);
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out_.write(reinterpret_cast<const char*>(descs_.data()), sizeof(ColumnDesc) * n_columns);
+    }
+
+    /// @brief Escribe las filas [first_row, first_row + samples.size())
+    /// @throws std::out_of_range Si el tramo excede las filas declaradas
+    /// @throws std::invalid_argument Si una acción no cabe en int8
+    void write(std::uint64_t first_row, std::span<const PongSample> samples) {
+        if (first_row > rows_ || samples.size() > rows_ - first_row)
+            throw std::out_of_range("ColumnarWriter: filas fuera del archivo");
+        for (std::size_t c = 0; c < descs_.size(); ++c) {
+            const std::size_t size = descs_[c].element_size;
+            scratch_.resize(samples.size() * size);
+            for (std::size_t r = 0; r < samples.size(); ++r) {
+                const PongSample& s = samples[r];
+                if (c == static_cast<std::size_t>(PongColumn::Action)) {
+                    if (s.action < std::numeric_limits<std::int8_t>::min() || s.action > std::numeric_limits<std::int8_t>::max())
+                        throw std::invalid_argument("Accion fuera del rango de int8 en la fila " + std::to_string(first_row + r));
+                    scratch_[r] = static_cast<char>(static_cast<std::int8_t>(s.action));
+                    continue;
+                }
+                const float value = c == 0 ? s.ball_x : c == 1 ? s.ball_y : c == 2 ? s.ball_vx
+                                  : c == 3 ? s.ball_vy : c == 4 ? s.paddle_y : s.reward;
+                std::memcpy(scratch_.data() + r * 4, &value, 4);
+            }
+            out_.seekp(static_cast<std::streamoff>(descs_[c].offset + first_row * size));
+            out_.write(scratch_.data(), static_cast<std::streamsize>(scratch_.size()));
+        }
+        if (!out_) throw std::runtime_error("Error al escribir el archivo: " + path_);
+    }
+
+    /// @brief Cierra el archivo; las filas que no se escribieron quedan en cero
+    /// @throws std::runtime_error Si falla la escritura
+    void close() {
+        if (!out_.is_open()) return;
+        out_.close();
+        if (!out_) throw std::runtime_error("Error al escribir el archivo: " + path_);
+        std::filesystem::resize_file(path_, end_);
+    }
+
+    ~ColumnarWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+private:
+    std::string path_;
+    std::uint64_t rows_;
+    std::uint64_t end_ = 0;   ///< Fin de la última columna (tamaño final del archivo)
+    std::array<ColumnDesc, static_cast<std::size_t>(PongColumn::Count)> descs_{};
+    std::ofstream out_;
+    std::vector<char> scratch_;
+};
+
+/// @brief Escribe muestras en el formato por columnas.
+/// @throws std::invalid_argument Si una acción no cabe en int8
+/// @throws std::runtime_error Si el archivo no se puede escribir
+inline void save_pong_columns(const std::string& path, std::span<const PongSample> samples) {
+    ColumnarWriter writer(path, samples.size());
+    writer.write(0, samples);
+    writer.close();
+}
+
+/// @brief Conjunto de datos por columnas proyectado en memoria (solo lectura, movible).
+class PongColumns {
+public:
+    using FloatColumn = utec::algebra::TensorView<const float, 1>;
+    using LabelColumn = utec::algebra::TensorView<const std::int8_t, 1>;
+
+    /// @brief Proyecta y valida `path`.
+    /// @throws std::runtime_error Si el archivo no existe, no tiene el formato o está truncado
+    explicit PongColumns(const std::string& path) : file_(path) {
+        constexpr std::size_t n_columns = static_cast<std::size_t>(PongColumn::Count);
+        const char* base = file_.data();
+        const std::size_t size = file_.size();
+
+        ColumnarHeader header{};
+        if (size < sizeof(header)) throw std::runtime_error("Archivo por columnas truncado: " + path);
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, COLUMNAR_MAGIC, sizeof(header.magic)) != 0)
+            throw std::runtime_error("No es un archivo por columnas de Pong: " + path);
+        if (header.version != COLUMNAR_VERSION)
+            throw std::runtime_error("Version de formato no soportada en " + path + ": " + std::to_string(header.version));
+        if (header.columns > 64 || size < sizeof(header) + header.columns * sizeof(ColumnDesc))
+            throw std::runtime_error("Archivo por columnas truncado: " + path);
+        rows_ = header.rows;
+
+        // Las columnas se buscan por nombre; el orden en el archivo no importa
+        std::array<bool, n_columns> found{};
+        for (std::size_t i = 0; i < header.columns; ++i) {
+            ColumnDesc d{};
+            std::memcpy(&d, base + sizeof(header) + i * sizeof(ColumnDesc), sizeof(d));
+            d.name[sizeof(d.name) - 1] = '\0';
+            const std::string_view name(d.name);
+            for (std::size_t c = 0; c < n_columns; ++c) {
+                if (name != PONG_COLUMN_NAMES[c]) continue;
+                const bool label = c == static_cast<std::size_t>(PongColumn::Action);
+                const ColumnType expected = label ? ColumnType::Int8 : ColumnType::Float32;
+                if (d.type != expected || d.element_size != (label ? 1u : 4u))
+                    throw std::runtime_error("Tipo inesperado en la columna " + std::string(name) + " de " + path);
+                if (d.offset % COLUMN_ALIGNMENT != 0 || d.offset > size || (size - d.offset) / d.element_size < rows_)
+                    throw std::runtime_error("Columna " + std::string(name) + " fuera del archivo: " + path);
+                data_[c] = base + d.offset;
+                found[c] = true;
+            }
+        }
+        for (std::size_t c = 0; c < n_columns; ++c)
+            if (!found[c]) throw std::runtime_error("Falta la columna " + std::string(PONG_COLUMN_NAMES[c]) + " en " + path);
+    }
+
+    std::size_t rows() const noexcept { return rows_; }
+    std::size_t bytes() const noexcept { return file_.size(); }
+
+    /// @brief Vista de una columna float32 (todas menos `action`)
+    FloatColumn column(PongColumn c) const {
+        if (c == PongColumn::Action || c >= PongColumn::Count)
+            throw std::invalid_argument("La columna no es float32");
+        return {reinterpret_cast<const float*>(data_[static_cast<std::size_t>(c)]), {rows_}};
+    }
+
+    FloatColumn ball_x() const { return column(PongColumn::BallX); }
+    FloatColumn ball_y() const { return column(PongColumn::BallY); }
+    FloatColumn ball_vx() const { return column(PongColumn::BallVx); }
+    FloatColumn ball_vy() const { return column(PongColumn::BallVy); }
+    FloatColumn paddle_y() const { return column(PongColumn::PaddleY); }
+    FloatColumn reward() const { return column(PongColumn::Reward); }
+
+    /// @brief Etiquetas (-1, 0, 1) como int8
+    LabelColumn action() const {
+        return {reinterpret_cast<const std::int8_t*>(data_[static_cast<std::size_t>(PongColumn::Action)]), {rows_}};
+    }
+
+    /// @brief Fila `r` reconstruida como PongSample
+    PongSample sample(std::size_t r) const {
+        return {ball_x()[r], ball_y()[r], ball_vx()[r], ball_vy()[r], paddle_y()[r], action()[r], reward()[r]};
+    }
+
+    /// @brief Copia todas las filas a PongSample (para el código que trabaja por filas)
+    std::vector<PongSample> samples() const {
+        std::vector<PongSample> out(rows_);
+        for (std::size_t r = 0; r < rows_; ++r) out[r] = sample(r);
+        return out;
+    }
+
+private:
+    utils::MappedFile file_;
+    std::size_t rows_ = 0;
+    std::array<const char*, static_cast<std::size_t>(PongColumn::Count)> data_{};
+};
+
+} // namespace utec::nn
+
+#endif // COLUMNAR_DATASET_H
@@ -0,0 +1,322 @@
+#pragma once
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+/**
+ * @file CsvLoader.h
+ * @brief Carga de CSV de entrenamiento sin copias: archivo proyectado en memoria y std::from_chars.
+ *
+ * El archivo se proyecta con MappedFile y se recorre directamente, sin getline ni stringstream:
+ *   1. se divide en bloques que terminan en un salto de línea (uno por hilo);
+ *   2. cada bloque cuenta sus filas buscando '\n' con SSE2 (16 bytes por comparación), y con
+ *      esos conteos se reserva el vector de salida una sola vez;
+ *   3. cada bloque parsea sus filas con std::from_chars directo en su tramo del vector; las
+ *      comas de cada fila también se cuentan con SSE2 para saber el formato antes de parsear.
+ *
+ * Formatos aceptados (el encabezado es opcional y se reconoce por tener letras):
+ *   - 7 columnas: ball_x, ball_y, ball_vx, ball_vy, paddle_y, action, reward
+ *   - 5 columnas (juego manual): ball_x, ball_y, paddle_y, action, reward (velocidades en 0)
+ * Se toleran filas vacías, finales de línea "\r\n" y espacios o tabuladores alrededor de los campos.
+ * append_pong_csv y write_pong_csv escriben el formato de 7 columnas.
+ */
+
+#include "PongSample.h"
+#include "../utils/mapped_file.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace utec::nn {
+
+/// @brief Opciones de carga.
+struct CsvLoadOptions {
+    std::size_t threads = 0;      ///< Hilos de parseo; 0 = uno cada 16 MiB, hasta los núcleos disponibles
+    bool skip_invalid = false;    ///< Saltar filas mal formadas en lugar de lanzar una excepción
+};
+
+/// @brief Muestras cargadas y datos de la carga.
+struct CsvLoadResult {
+    std::vector<PongSample> samples;
+    std::size_t skipped = 0;      ///< Filas mal formadas que se saltaron (solo con skip_invalid)
+    std::size_t bytes = 0;        ///< Tamaño del archivo
+};
+
+namespace csv_detail {
+
+/// @brief Cantidad de bytes iguales a `c` en [p, end)
+inline std::size_t count_byte(const char* p, const char* end, char c) {
+    std::size_t n = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; p + 16 <= end; p += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        n += std::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+    }
+#endif
+    for (; p < end; ++p) n += *p == c;
+    return n;
+}
+
+/// @brief Primer byte igual a `c` en [p, end), o `end` si no hay
+inline const char* find_byte(const char* p, const char* end, char c) {
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; p + 16 <= end; p += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        if (mask) return p + std::countr_zero(mask);
+    }
+#endif
+    for (; p < end; ++p)
+        if (*p == c) return p;
+    return end;
+}
+
+/// @brief Primer byte de [p, end) que no es espacio ni tabulador
+inline const char* skip_blanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+/// @brief Parsea un campo numérico y consume la coma que lo sigue (salvo en el último).
+/// Se toleran espacios y tabuladores antes del número y antes de la coma, como con stof/stoi.
+template <typename V>
+bool field(const char*& p, const char* end, V& value, bool last) {
+    p = skip_blanks(p, end);
+    auto [ptr, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc{}) return false;
+    if (last) return ptr == end;
+    ptr = skip_blanks(ptr, end);
+    if (ptr == end || *ptr != ',') return false;
+    p = ptr + 1;
+    return true;
+}
+
+enum class Row { Sample, Blank, Invalid };
+
+/// @brief Parsea una fila [p, eol) sin el salto de línea
+inline Row parse_row(const char* p, const char* eol, PongSample& s) {
+    while (eol > p && (eol[-1] == '\r' || eol[-1] == ' ' || eol[-1] == '\t')) --eol;
+    if (p == eol) return Row::Blank;
+    switch (count_byte(p, eol, ',')) {
+        case 6:
+            return field(p, eol, s.ball_x, false) && field(p, eol, s.ball_y, false)
+                           && field(p, eol, s.ball_vx, false) && field(p, eol, s.ball_vy, false)
+                           && field(p, eol, s.paddle_y, false) && field(p, eol, s.action, false)
+                           && field(p, eol, s.reward, true)
+                       ? Row::Sample
+                       : Row::Invalid;
+        case 4:
+            s.ball_vx = s.ball_vy = 0.0f;
+            return field(p, eol, s.ball_x, false) && field(p, eol, s.ball_y, false)
+                           && field(p, eol, s.paddle_y, false) && field(p, eol, s.action, false)
+                           && field(p, eol, s.reward, true)
+                       ? Row::Sample
+                       : Row::Invalid;
+        default:
+            return Row::Invalid;
+    }
+}
+
+/// @brief Resultado de parsear un bloque
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::size_t first_line = 0;   ///< Número de línea (desde 1) de la primera fila del bloque
+    std::size_t capacity = 0;     ///< Filas del bloque (cota superior de muestras)
+    std::size_t offset = 0;       ///< Primera posición del bloque en el vector de salida
+    std::size_t count = 0;        ///< Muestras escritas
+    std::size_t skipped = 0;
+    std::size_t bad_line = 0;     ///< Primera línea inválida (0 si no hubo)
+};
+
+/// @brief Parsea las filas de un bloque en out[offset, offset + capacity)
+inline void parse_chunk(Chunk& c, PongSample* out, bool skip_invalid) {
+    const char* p = c.begin;
+    std::size_t line = c.first_line;
+    while (p < c.end) {
+        const char* eol = find_byte(p, c.end, '\n');
+        const Row row = parse_row(p, eol, out[c.offset + c.count]);
+        if (row == Row::Sample) {
+            ++c.count;
+        } else if (row == Row::Invalid) {
+            if (!skip_invalid) {
+                c.bad_line = line;
+                return;
+            }
+            ++c.skipped;
+        }
+        p = eol + 1;
+        ++line;
+    }
+}
+
+/// @brief ¿La primera línea es un encabezado? (tiene letras; los números pueden tener 'e')
+inline bool is_header(const char* p, const char* eol) {
+    for (; p < eol; ++p) {
+        const char ch = *p;
+        if ((ch >= 'a' && ch <= 'z' && ch != 'e') || (ch >= 'A' && ch <= 'Z' && ch != 'E') || ch == '_') return true;
+    }
+    return false;
+}
+
+} // namespace csv_detail
+
+/// @brief Parsea un CSV de muestras de Pong ya proyectado en memoria.
+/// @param name Nombre usado en los mensajes de error
+/// @throws std::runtime_error Sin skip_invalid, si una fila está mal formada (indica la línea)
+inline CsvLoadResult load_pong_csv(const utils::MappedFile& file, const CsvLoadOptions& opts = {},
+                                   const std::string& name = "CSV") {
+    using namespace csv_detail;
+    CsvLoadResult result;
+    result.bytes = file.size();
+    const char* p = file.data();
+    const char* end = p + file.size();
+    if (!p) return result;
+
+    // BOM de UTF-8 y encabezado opcional
+    std::size_t first_line = 1;
+    if (end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+    if (const char* eol = find_byte(p, end, '\n'); is_header(p, eol)) {
+        p = eol == end ? end : eol + 1;
+        first_line = 2;
+    }
+
+    constexpr std::size_t BYTES_PER_THREAD = std::size_t{16} << 20;
+    std::size_t threads = opts.threads;
+    if (threads == 0) {
+        const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::clamp<std::size_t>(static_cast<std::size_t>(end - p) / BYTES_PER_THREAD, 1, cores);
+    }
+
+    // Bloques que terminan justo después de un '\n'
+    std::vector<Chunk> chunks;
+    for (std::size_t i = 0; i < threads && p < end; ++i) {
+        const char* stop = end;
+        if (i + 1 < threads) {
+            stop = find_byte(p + static_cast<std::size_t>(end - p) / (threads - i), end, '\n');
+            if (stop != end) ++stop;
+        }
+        if (stop > p) chunks.push_back({p, stop});
+        p = stop;
+    }
+
+    std::unique_ptr<utils::ThreadPool> pool;
+    if (chunks.size() > 1) pool = std::make_unique<utils::ThreadPool>(chunks.size());
+    auto for_each_chunk = [&](auto&& fn) {
+        if (pool)
+            pool->parallel_for(chunks.size(), [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) fn(chunks[i]);
+            });
+        else
+            for (auto& c : chunks) fn(c);
+    };
+
+    // 1. Filas por bloque (la última puede no terminar en '\n')
+    for_each_chunk([](Chunk& c) {
+        c.capacity = count_byte(c.begin, c.end, '\n') + (c.end[-1] != '\n');
+    });
+    std::size_t total = 0;
+    for (auto& c : chunks) {
+        c.offset = total;
+        c.first_line = first_line + total;
+        total += c.capacity;
+    }
+
+    // 2. Parseo directo en el vector de salida
+    result.samples.resize(total);
+    PongSample* out = result.samples.data();
+    for_each_chunk([&](Chunk& c) { parse_chunk(c, out, opts.skip_invalid); });
+
+    // 3. Juntar los tramos (las filas vacías o saltadas dejan huecos al final de cada bloque)
+    std::size_t filled = 0;
+    for (const auto& c : chunks) {
+        if (c.bad_line)
+            throw std::runtime_error("Fila mal formada en " + name + ", linea " + std::to_string(c.bad_line));
+        if (c.offset != filled) std::memmove(out + filled, out + c.offset, c.count * sizeof(PongSample));
+        filled += c.count;
+        result.skipped += c.skipped;
+    }
+    result.samples.resize(filled);
+    return result;
+}
+
+/// @brief Encabezado de los CSV de 7 columnas que escribe el proyecto
+inline constexpr std::string_view PONG_CSV_HEADER = "ball_x,ball_y,ball_vx,ball_vy,paddle_y,action,reward\n";
+
+/// @brief Agrega a `out` la fila CSV de `s`, con cada float en el texto más corto que
+/// load_pong_csv vuelve a leer como el mismo valor.
+inline void append_pong_csv(std::string& out, const PongSample& s) {
+    char buf[128];
+    char* p = buf;
+    for (const float v : {s.ball_x, s.ball_y, s.ball_vx, s.ball_vy, s.paddle_y}) {
+        p = std::to_chars(p, buf + sizeof(buf), v).ptr;
+        *p++ = ',';
+    }
+    p = std::to_chars(p, buf + sizeof(buf), s.action).ptr;
+    *p++ = ',';
+    p = std::to_chars(p, buf + sizeof(buf), s.reward).ptr;
+    *p++ = '\n';
+    out.append(buf, p);
+}
+
+namespace csv_detail {
+
+/// @brief Escribe `size` bytes en `file`
+/// @return Bytes escritos
+/// @throws std::runtime_error Si fwrite escribe menos
+inline std::uint64_t write_all(std::FILE* file, const char* data, std::size_t size, const std::string& path) {
+    if (std::fwrite(data, 1, size, file) != size) throw std::runtime_error("Error al escribir el archivo: " + path);
+    return size;
+}
+
+} // namespace csv_detail
+
+/// @brief Crea `path` con el encabezado de 7 columnas y llama a `body(write)`; cada
+/// `write(text)` agrega texto ya formateado (p. ej. con append_pong_csv) al final del archivo.
+/// @return Bytes escritos, encabezado incluido
+/// @throws std::runtime_error Si el archivo no se puede crear o escribir
+template <typename Body>
+std::uint64_t write_pong_csv(const std::string& path, Body&& body) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("No se pudo crear el archivo: " + path);
+    std::uint64_t bytes = 0;
+    try {
+        bytes = csv_detail::write_all(file, PONG_CSV_HEADER.data(), PONG_CSV_HEADER.size(), path);
+        body([&](std::string_view text) { bytes += csv_detail::write_all(file, text.data(), text.size(), path); });
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) throw std::runtime_error("Error al escribir el archivo: " + path);
+    return bytes;
+}
+
+/// @brief Carga un CSV de muestras de Pong.
+/// @throws std::runtime_error Si el archivo no se puede abrir o, sin skip_invalid, si una fila
+/// está mal formada (el mensaje indica la línea)
+inline CsvLoadResult load_pong_csv(const std::string& path, const CsvLoadOptions& opts = {}) {
+    const utils::MappedFile file(path);
+    return load_pong_csv(file, opts, path);
+}
+
+} // namespace utec::nn
+
+#endif // CSV_LOADER_H
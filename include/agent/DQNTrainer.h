@@ -0,0 +1,347 @@
+#pragma once
+#ifndef DQN_TRAINER_H
+#define DQN_TRAINER_H
+
+/**
+ * @file DQNTrainer.h
+ * @brief Entrenamiento por refuerzo (Deep Q-Learning) directamente contra el entorno Pong.
+ *
+ * La red de PongAgent (3 -> oculta -> 3) se usa como función Q: la salida j estima el retorno
+ * de la acción j - 1. Los entornos avanzan en paralelo con VecEnvGym (misma física que EnvGym),
+ * las transiciones van a una ReplayBuffer preasignada y cada actualización:
+ *   1. muestrea un lote,
+ *   2. calcula en un solo forward de la red objetivo los TD-targets y = r + γ·max Q'(s', ·),
+ *   3. hace forward/backward de la red en línea con pérdida Huber solo en la acción tomada.
+ * La red objetivo se sincroniza copiando los pesos cada `target_sync` actualizaciones.
+ * Con `prioritized` se usa PrioritizedReplay: los lotes se eligen según el último error TD y
+ * el gradiente se pondera con los pesos de importancia (β sube linealmente hasta 1).
+ * Con `action_repeat` > 1 cada transición abarca varios pasos de entorno con la misma acción
+ * (VecActionRepeat) y su recompensa es la suma de las de esos pasos.
+ */
+
+#include "ActionRepeat.h"
+#include "PongAgent.h"
+#include "ReplayBuffer.h"
+#include "PrioritizedReplay.h"
+#include "VecEnvGym.h"
+#include "../utils/random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Hiperparámetros de DQN.
+template <typename T>
+struct DQNConfig {
+    size_t hidden_size = 32;                        ///< Neuronas de la capa oculta
+    T learning_rate = 0.001;
+    OptimizerKind optimizer = OptimizerKind::Adam;
+    T gamma = 0.95;                                 ///< Descuento
+    size_t batch_size = 64;
+    size_t buffer_capacity = 100000;                ///< Transiciones en la memoria
+    size_t warmup = 2000;                           ///< Transiciones antes de la primera actualización
+    size_t train_every = 4;                         ///< Transiciones por actualización
+    size_t target_sync = 500;                       ///< Actualizaciones entre copias a la red objetivo
+    size_t num_envs = 8;                            ///< Entornos simulados a la vez
+    std::uint32_t action_repeat = 1;                ///< Pasos de entorno por transición (misma acción)
+    size_t total_steps = 300000;                    ///< Transiciones totales a recolectar
+    float epsilon_start = 1.0f;
+    float epsilon_end = 0.05f;
+    size_t epsilon_decay = 100000;                  ///< Transiciones para bajar epsilon linealmente
+    size_t log_every = 20000;                       ///< Transiciones entre reportes
+    std::uint64_t seed = 1;
+    bool prioritized = false;                       ///< Memoria priorizada (PER) en vez de uniforme
+    double per_alpha = 0.6;                         ///< Exponente de prioridad
+    double per_beta_start = 0.4;                    ///< β inicial de los pesos de importancia
+};
+
+/// @brief Métricas de una ventana de entrenamiento (entre dos reportes).
+struct DQNStats {
+    size_t steps = 0;            ///< Transiciones recolectadas en total
+    size_t updates = 0;          ///< Actualizaciones de la red en total
+    float epsilon = 0;
+    double mean_loss = 0;        ///< Pérdida Huber promedio de la ventana
+    size_t hits = 0;             ///< Golpes en la ventana
+    size_t misses = 0;           ///< Bolas perdidas en la ventana
+    double steps_per_sec = 0;    ///< Transiciones por segundo (incluye actualizaciones)
+    double updates_per_sec = 0;  ///< Actualizaciones de la red por segundo
+
+    double hit_rate() const {
+        const size_t events = hits + misses;
+        return events ? static_cast<double>(hits) / events : 0.0;
+    }
+};
+
+/// @brief Núcleo de aprendizaje de DQN: red en línea, red objetivo, optimizador y memoria.
+/// No sabe de entornos: recibe transiciones con push() y entrena con update(). Lo usan tanto
+/// DQNTrainer (recolección y aprendizaje en el mismo hilo) como ActorLearner (hilo aprendiz).
+template <typename T>
+class DQNLearner {
+public:
+    using Model = typename PongAgent<T>::Sequential;
+
+    /// @param cfg Hiperparámetros (se usan los de red, optimizador y memoria)
+    /// @param rng Generador del muestreo de la memoria
+    /// @throws std::invalid_argument Si batch_size o target_sync es 0
+    DQNLearner(const DQNConfig<T>& cfg, utils::Xoshiro256 rng)
+        : cfg_(cfg), rng_(rng),
+          online_(PongAgent<T>::build_sequential(cfg.hidden_size, static_cast<unsigned>(cfg.seed))),
+          target_(PongAgent<T>::build_sequential(cfg.hidden_size, static_cast<unsigned>(cfg.seed))),
+          optimizer_(PongAgent<T>::make_optimizer(cfg.optimizer, cfg.learning_rate)) {
+        if (cfg.batch_size == 0 || cfg.target_sync == 0)
+            throw std::invalid_argument("DQNLearner: batch_size y target_sync deben ser mayores que 0");
+        // Ninguna de las dos redes necesita dX; la objetivo tampoco calcula dW
+        online_->set_requires_input_grad(false);
+        target_->set_requires_input_grad(false);
+        target_->set_frozen(true);
+        sync_target();
+        if (cfg.prioritized)
+            prioritized_ = std::make_unique<PrioritizedReplay<T>>(cfg.buffer_capacity, cfg.per_alpha);
+        else
+            uniform_ = std::make_unique<ReplayBuffer<T>>(cfg.buffer_capacity);
+    }
+
+    /// @brief Guarda una transición en la memoria
+    void push(const State& s, int action, T reward, const State& next, bool done) {
+        if (prioritized_)
+            prioritized_->push(s, action, reward, next, done);
+        else
+            uniform_->push(s, action, reward, next, done);
+    }
+
+    /// @brief Transiciones guardadas en la memoria de repetición
+    size_t replay_size() const noexcept { return prioritized_ ? prioritized_->size() : uniform_->size(); }
+
+    /// @brief ¿Hay suficientes transiciones para empezar a entrenar?
+    bool warmed_up() const noexcept { return replay_size() >= cfg_.warmup; }
+
+    size_t updates() const noexcept { return updates_; }
+
+    /// @brief Red en línea (la que se entrena y decide acciones)
+    /// @throws std::logic_error Si ya fue entregada con release()
+    Model& online() {
+        if (!online_) throw std::logic_error("DQNLearner: la red ya fue entregada");
+        return *online_;
+    }
+
+    /// @brief Red objetivo (congelada; cambia solo con sync_target())
+    const Model& target() const noexcept { return *target_; }
+
+    /// @brief Entrega la red en línea; después el aprendiz ya no puede entrenar
+    std::unique_ptr<Model> release() { return std::move(online_); }
+
+    /// @brief Copia pesos y bias de la red en línea a la objetivo (sin asignar memoria)
+    void sync_target() {
+        target_->l1->weights() = online_->l1->weights();
+        target_->l1->bias() = online_->l1->bias();
+        target_->l2->weights() = online_->l2->weights();
+        target_->l2->bias() = online_->l2->bias();
+    }
+
+    /// @brief Una actualización sobre un lote muestreado.
+    /// @param progress Avance del entrenamiento en [0, 1]; con memoria priorizada sube β hasta 1
+    /// @return Pérdida Huber promedio del lote
+    double update(double progress) {
+        const size_t n = cfg_.batch_size;
+        if (!prioritized_) {
+            uniform_->sample(n, rng_, batch_);
+            return learn(batch_);
+        }
+
+        progress = std::clamp(progress, 0.0, 1.0);
+        const double beta = cfg_.per_beta_start + progress * (1.0 - cfg_.per_beta_start);
+        prioritized_->sample(n, rng_, batch_, beta);
+        const double loss = learn(batch_);
+        prioritized_->update_priorities(batch_.indices, td_errors_);
+        return loss;
+    }
+
+private:
+    DQNConfig<T> cfg_;
+    utils::Xoshiro256 rng_;
+    std::unique_ptr<Model> online_;
+    std::unique_ptr<Model> target_;
+    std::unique_ptr<utec::neural_network::IOptimizer<T>> optimizer_;
+    std::unique_ptr<ReplayBuffer<T>> uniform_;            ///< Memoria uniforme (si no es priorizada)
+    std::unique_ptr<PrioritizedReplay<T>> prioritized_;   ///< Memoria priorizada (opcional)
+    ReplayBatch<T> batch_;
+    utec::algebra::Tensor<T, 2> grad_;
+    std::vector<T> td_errors_;                  ///< Error TD de cada muestra del último lote
+    size_t updates_ = 0;
+
+    /// @brief TD-targets, pérdida Huber y paso del optimizador para un lote ya armado.
+    /// El gradiente se multiplica por `batch.weights` (1 en muestreo uniforme).
+    double learn(ReplayBatch<T>& batch) {
+        const size_t n = batch.size();
+        const auto q_next = target_->forward(batch.next_states);
+        const auto q = online_->forward(batch.states);
+        if (grad_.shape()[0] != n) grad_ = utec::algebra::Tensor<T, 2>(n, 3);
+        grad_.fill(0);
+        td_errors_.resize(n);
+
+        double loss = 0;
+        const T* qn = q_next.data();
+        const T* qc = q.data();
+        for (size_t k = 0; k < n; ++k) {
+            const T best_next = std::max({qn[k * 3], qn[k * 3 + 1], qn[k * 3 + 2]});
+            const T target = batch.rewards[k] + (batch.dones[k] ? T(0) : cfg_.gamma * best_next);
+            const size_t col = static_cast<size_t>(batch.actions[k] + 1);
+            const T diff = qc[k * 3 + col] - target;
+            td_errors_[k] = diff;
+            const T abs_diff = std::abs(diff);
+            loss += batch.weights[k] * (abs_diff <= 1 ? T(0.5) * diff * diff : abs_diff - T(0.5));
+            grad_[k * 3 + col] = batch.weights[k] * std::clamp(diff, T(-1), T(1)) / static_cast<T>(n);
+        }
+
+        online_->backward(grad_);
+        online_->update_params(*optimizer_);
+        if (++updates_ % cfg_.target_sync == 0) sync_target();
+        return loss / static_cast<double>(n);
+    }
+};
+
+/// @brief Entrenador DQN con red objetivo y memoria de repetición.
+template <typename T>
+class DQNTrainer {
+public:
+    using Model = typename DQNLearner<T>::Model;
+    using LogCallback = std::function<void(const DQNStats&)>;
+
+    /// @throws std::invalid_argument Si batch_size, num_envs, train_every, target_sync o
+    /// action_repeat es 0
+    explicit DQNTrainer(const DQNConfig<T>& cfg)
+        : cfg_(cfg), rng_(cfg.seed), learner_(cfg, rng_.fork()),
+          envs_(validated_envs(cfg), rng_.fork()), repeated_(envs_, cfg.action_repeat),
+          observations_(cfg.num_envs, 3), states_(cfg.num_envs), actions_(cfg.num_envs) {}
+
+    /// @brief Recolecta `total_steps` transiciones entrenando sobre la marcha.
+    /// @param on_log Se llama cada `log_every` transiciones con las métricas de la ventana
+    /// @return La red en línea entrenada (lista para PongAgent); el entrenador la entrega,
+    /// así que train() se llama una sola vez
+    /// @throws std::logic_error Si la red ya fue entregada por una llamada anterior
+    std::unique_ptr<utec::neural_network::ILayer<T>> train(const LogCallback& on_log = {}) {
+        using Clock = std::chrono::steady_clock;
+        if (released_) throw std::logic_error("DQNTrainer::train: la red ya fue entregada");
+        envs_.observe(states_);
+        size_t pending_updates = 0;
+        size_t next_log = cfg_.log_every;
+        DQNStats window;
+        double loss_sum = 0;
+        size_t loss_count = 0;
+        auto window_start = Clock::now();
+        size_t window_steps = 0;
+        size_t window_updates = 0;
+
+        while (steps_ < cfg_.total_steps) {
+            const float eps = epsilon();
+            select_actions(eps);
+            repeated_.step(actions_);
+
+            const auto rewards = repeated_.rewards();
+            const auto dones = repeated_.dones();
+            const auto hits = repeated_.hits();
+            for (size_t i = 0; i < cfg_.num_envs; ++i) {
+                // Con done el entorno ya se reinició: el siguiente estado no importa (no se usa)
+                const State next = envs_.state(i);
+                learner_.push(states_[i], actions_[i], static_cast<T>(rewards[i]), next, dones[i]);
+                window.hits += hits[i];
+                window.misses += dones[i];
+                states_[i] = next;
+            }
+            steps_ += cfg_.num_envs;
+            window_steps += cfg_.num_envs;
+
+            if (learner_.warmed_up()) {
+                pending_updates += cfg_.num_envs;
+                for (; pending_updates >= cfg_.train_every; pending_updates -= cfg_.train_every) {
+                    loss_sum += learner_.update(static_cast<double>(steps_) / static_cast<double>(cfg_.total_steps));
+                    ++loss_count;
+                    ++window_updates;
+                }
+            }
+
+            if (cfg_.log_every && steps_ >= next_log) {
+                next_log += cfg_.log_every;
+                const double seconds = std::chrono::duration<double>(Clock::now() - window_start).count();
+                window.steps = steps_;
+                window.updates = learner_.updates();
+                window.epsilon = eps;
+                window.mean_loss = loss_count ? loss_sum / loss_count : 0.0;
+                window.steps_per_sec = seconds > 0 ? window_steps / seconds : 0.0;
+                window.updates_per_sec = seconds > 0 ? window_updates / seconds : 0.0;
+                if (on_log) on_log(window);
+                window = DQNStats{};
+                loss_sum = 0;
+                loss_count = 0;
+                window_steps = 0;
+                window_updates = 0;
+                window_start = Clock::now();
+            }
+        }
+        released_ = true;
+        return learner_.release();
+    }
+
+    /// @brief Epsilon actual (decae linealmente con las transiciones recolectadas)
+    float epsilon() const { return epsilon_at(cfg_, steps_); }
+
+    /// @brief Epsilon tras `steps` transiciones con la configuración `cfg`
+    static float epsilon_at(const DQNConfig<T>& cfg, size_t steps) {
+        if (steps >= cfg.epsilon_decay) return cfg.epsilon_end;
+        const float frac = static_cast<float>(steps) / static_cast<float>(cfg.epsilon_decay);
+        return cfg.epsilon_start + frac * (cfg.epsilon_end - cfg.epsilon_start);
+    }
+
+    size_t steps() const noexcept { return steps_; }
+    size_t updates() const noexcept { return learner_.updates(); }
+
+    /// @brief Transiciones guardadas en la memoria de repetición
+    size_t replay_size() const noexcept { return learner_.replay_size(); }
+
+    /// @brief Copia pesos y bias de la red en línea a la objetivo
+    void sync_target() { learner_.sync_target(); }
+
+private:
+    DQNConfig<T> cfg_;
+    utils::Xoshiro256 rng_;                     ///< Exploración (y origen de los demás flujos)
+    DQNLearner<T> learner_;
+    VecEnvGym envs_;
+    VecActionRepeat repeated_;                  ///< Envuelve envs_ (declarado después)
+    utec::algebra::Tensor<T, 2> observations_;  ///< Estados de todos los entornos (num_envs x 3)
+    std::vector<State> states_;
+    std::vector<int> actions_;
+    size_t steps_ = 0;
+    bool released_ = false;
+
+    static size_t validated_envs(const DQNConfig<T>& cfg) {
+        if (cfg.num_envs == 0 || cfg.train_every == 0)
+            throw std::invalid_argument("DQNTrainer: num_envs y train_every deben ser mayores que 0");
+        return cfg.num_envs;
+    }
+
+    /// @brief Acción epsilon-greedy para cada entorno con un solo forward
+    void select_actions(float eps) {
+        T* in = observations_.data();
+        for (size_t i = 0; i < states_.size(); ++i) {
+            in[i * 3 + 0] = states_[i].ball_x;
+            in[i * 3 + 1] = states_[i].ball_y;
+            in[i * 3 + 2] = states_[i].paddle_y;
+        }
+        const auto q = learner_.online().forward(observations_);
+        PongAgent<T>::select_actions(q.data(), states_.size(), 3, actions_.data());
+        for (auto& a : actions_) {
+            if (rng_.uniform01() < eps) a = static_cast<int>(rng_.below(3)) - 1;
+        }
+    }
+};
+
+} // namespace utec::nn
+
+#endif // DQN_TRAINER_H
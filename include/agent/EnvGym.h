@@ -4,8 +4,9 @@
 
 #include <algorithm>
 #include <cmath>
-#include <cstdlib>  // para rand()
+#include <cstdint>
 #include <iostream>
+#include "../utils/random.h"
 
 namespace utec::nn {
 
@@ -25,10 +26,17 @@ private:
     float ball_vy_ = 0.03f;        ///< Velocidad de la bola en Y
     const float PADDLE_SPEED = 0.05f;   ///< Velocidad de la paleta
     const float PADDLE_HEIGHT = 0.2f;   ///< Altura de la paleta
+    utils::Xoshiro256 rng_;             ///< Generador propio (velocidades de reset)
 
 public:
-    /// @brief Constructor. Llama automáticamente a reset().
-    EnvGym() {
+    /// @brief Constructor. Usa una semilla distinta por instancia y llama a reset().
+    EnvGym() : EnvGym(utils::next_stream_seed()) {}
+
+    /// @brief Constructor con semilla fija (episodios reproducibles).
+    explicit EnvGym(std::uint64_t seed) : EnvGym(utils::Xoshiro256(seed)) {}
+
+    /// @brief Constructor con un flujo ya preparado (por ejemplo, `rng.fork()` por hilo).
+    explicit EnvGym(utils::Xoshiro256 rng) : rng_(rng) {
         reset();
     }
 
@@ -39,12 +47,28 @@ public:
         current_state_ = {0.5f, 0.5f, 0.5f};
 
         // Velocidad aleatoria y rápida (comentada alternativa fija)
-        ball_vx_ = (0.04f + 0.06f * (rand() % 100 / 100.0f)) * (rand() % 2 ? 1 : -1);
-        ball_vy_ = (0.02f + 0.04f * (rand() % 100 / 100.0f)) * (rand() % 2 ? 1 : -1);
+        ball_vx_ = (0.04f + 0.06f * (rng_.below(100) / 100.0f)) * (rng_.below(2) ? 1 : -1);
+        ball_vy_ = (0.02f + 0.04f * (rng_.below(100) / 100.0f)) * (rng_.below(2) ? 1 : -1);
 
         return current_state_;
     }
 
+    /// @brief Fija el estado y la velocidad de la bola (útil para pruebas y repeticiones).
+    void set_state(const State& state, float ball_vx, float ball_vy) {
+        current_state_ = state;
+        ball_vx_ = ball_vx;
+        ball_vy_ = ball_vy;
+    }
+
+    /// @brief Estado actual (sin avanzar)
+    const State& state() const { return current_state_; }
+
+    /// @brief Velocidad actual de la bola en X
+    float ball_vx() const { return ball_vx_; }
+
+    /// @brief Velocidad actual de la bola en Y
+    float ball_vy() const { return ball_vy_; }
+
     /// @brief Ejecuta un paso en la simulación.
     /// @param action Acción del agente: -1 (bajar), 0 (quedarse), 1 (subir)
     /// @param reward Recompensa obtenida
@@ -0,0 +1,208 @@
+#pragma once
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+/**
+ * @file Evaluator.h
+ * @brief Evaluación de políticas en Pong sin pantalla ni pausas.
+ *
+ * `evaluate_policy` juega con un EnvGym y cualquier invocable. `evaluate_repeat` mantiene cada
+ * acción un número fijo de pasos (ActionRepeat). `evaluate_parallel` reparte millones de pasos
+ * entre hilos: cada hilo avanza un VecEnvGym y decide las acciones de todos sus entornos con una política
+ * compartida de solo lectura (PolicySnapshot o PolicyCache), y al final se suman los resultados de todos los hilos.
+ */
+
+#include "ActionRepeat.h"
+#include "EnvGym.h"
+#include "PolicySnapshot.h"
+#include "VecEnvGym.h"
+#include "../utils/random.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Resultado de evaluar una política en EnvGym.
+struct EvalResult {
+    std::size_t steps = 0;          ///< Pasos simulados
+    std::size_t hits = 0;           ///< Golpes exitosos de la paleta
+    std::size_t misses = 0;         ///< Bolas perdidas (episodios terminados)
+    std::size_t episode_steps = 0;  ///< Pasos sumados de los episodios terminados
+    std::size_t decisions = 0;      ///< Consultas a la política
+    double reward = 0;              ///< Recompensa total de los pasos simulados
+    double seconds = 0;             ///< Tiempo de pared de la evaluación
+
+    /// @brief Fracción de contactos que fueron golpes exitosos
+    double hit_rate() const {
+        const std::size_t events = hits + misses;
+        return events ? static_cast<double>(hits) / events : 0.0;
+    }
+
+    /// @brief Bolas perdidas cada 1000 pasos
+    double misses_per_1000() const { return steps ? 1000.0 * misses / steps : 0.0; }
+
+    /// @brief Duración media de un episodio terminado (0 si ninguno terminó)
+    double mean_episode_length() const { return misses ? static_cast<double>(episode_steps) / misses : 0.0; }
+
+    double steps_per_sec() const { return seconds > 0 ? steps / seconds : 0.0; }
+
+    /// @brief Acumula los contadores de otra evaluación (el tiempo no se suma: lo fija quien une)
+    EvalResult& operator+=(const EvalResult& other) {
+        steps += other.steps;
+        hits += other.hits;
+        misses += other.misses;
+        episode_steps += other.episode_steps;
+        decisions += other.decisions;
+        reward += other.reward;
+        return *this;
+    }
+};
+
+/// @brief Evalúa una política durante `steps` pasos, reiniciando el entorno al perder la bola.
+/// @tparam Policy Invocable `int(const State&)` que devuelve -1, 0 o 1
+template <typename Policy>
+EvalResult evaluate_policy(Policy&& policy, EnvGym& env, std::size_t steps) {
+    const auto start = std::chrono::steady_clock::now();
+    EvalResult result;
+    State state = env.reset();
+    float reward = 0;
+    bool done = false;
+    std::size_t episode = 0;
+
+    for (std::size_t i = 0; i < steps; ++i) {
+        state = env.step(policy(state), reward, done);
+        ++result.steps;
+        ++result.decisions;
+        result.reward += reward;
+        ++episode;
+        if (reward > 0) ++result.hits;
+        if (done) {
+            ++result.misses;
+            result.episode_steps += episode;
+            episode = 0;
+            state = env.reset();
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/// @brief Evalúa una política que decide cada `env.repeat()` pasos (ver ActionRepeat).
+/// Simula exactamente `steps` pasos de entorno; `decisions` cuenta las consultas a la política.
+/// @tparam Policy Invocable `int(const State&)` que devuelve -1, 0 o 1
+template <typename Policy>
+EvalResult evaluate_repeat(Policy&& policy, ActionRepeat& env, std::size_t steps) {
+    const auto start = std::chrono::steady_clock::now();
+    EvalResult result;
+    State state = env.reset();
+    std::size_t episode = 0;
+
+    while (result.steps < steps) {
+        const auto limit = static_cast<std::uint32_t>(
+            std::min<std::size_t>(steps - result.steps, std::numeric_limits<std::uint32_t>::max()));
+        const ActionRepeat::Outcome out = env.step(policy(state), limit);
+        state = out.state;
+        ++result.decisions;
+        result.steps += out.steps;
+        result.reward += out.reward;
+        result.hits += out.hits;
+        result.misses += out.misses;
+        if (out.misses) {
+            // Todos los pasos previos al episodio abierto pertenecen a episodios terminados
+            result.episode_steps += episode + out.steps - out.open_steps;
+            episode = 0;
+            if (env.stop_on_done()) state = env.reset();
+        }
+        episode += out.open_steps;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/// @brief Opciones de la evaluación en paralelo.
+struct ParallelEvalOptions {
+    std::size_t steps = 1000000;       ///< Pasos totales (sumando todos los entornos)
+    std::size_t episodes = 0;          ///< Si > 0, termina al completar estos episodios (steps sigue siendo el tope)
+    std::size_t threads = 0;           ///< Hilos; 0 = std::thread::hardware_concurrency()
+    std::size_t envs_per_thread = 64;  ///< Entornos que avanza cada hilo a la vez
+    std::uint64_t seed = 1;            ///< Con la misma semilla y los mismos hilos el resultado se repite
+    std::uint32_t action_repeat = 1;   ///< Pasos que se mantiene cada acción (ver VecActionRepeat)
+};
+
+/// @brief Evalúa `policy` en muchos entornos repartidos entre hilos, sin dibujar nada.
+/// Cada hilo recibe una parte igual de los pasos (y de los episodios) y su propio flujo
+/// aleatorio, derivado de `seed` en orden: con la misma semilla y la misma cantidad de hilos
+/// el resultado es idéntico, sin importar cómo el sistema planifique los hilos.
+/// Con action_repeat > 1 cada consulta vale hasta action_repeat pasos (cortados al perder la
+/// bola) y el total puede pasarse de `steps` en menos de action_repeat pasos por hilo.
+/// @throws std::invalid_argument Si steps, envs_per_thread o action_repeat es 0
+/// @tparam Policy PolicySnapshot, PolicyCache o cualquier tipo con
+/// `act_batch(span<const State>, span<int>) const` seguro de llamar desde varios hilos
+template <typename Policy>
+EvalResult evaluate_parallel(const Policy& policy, const ParallelEvalOptions& opts) {
+    if (opts.steps == 0 || opts.envs_per_thread == 0 || opts.action_repeat == 0)
+        throw std::invalid_argument("evaluate_parallel: steps, envs_per_thread y action_repeat deben ser mayores que 0");
+    const auto start = std::chrono::steady_clock::now();
+
+    utils::ThreadPool pool(opts.threads);
+    const std::size_t shards = std::min(pool.size(), opts.steps);
+    std::vector<EvalResult> partial(shards);
+    std::vector<utils::Xoshiro256> streams;
+    utils::Xoshiro256 root(opts.seed);
+    for (std::size_t s = 0; s < shards; ++s) streams.push_back(root.fork());
+
+    pool.parallel_for(shards, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t s = begin; s < end; ++s) {
+            const std::size_t step_quota = opts.steps / shards + (s < opts.steps % shards);
+            const std::size_t episode_quota = opts.episodes / shards + (s < opts.episodes % shards);
+            const std::size_t n = std::min(opts.envs_per_thread, step_quota);
+
+            VecEnvGym envs(n, streams[s]);
+            VecActionRepeat repeated(envs, opts.action_repeat);
+            std::vector<State> states(n);
+            std::vector<int> actions(n);
+            std::vector<std::size_t> episode(n, 0);
+            EvalResult& r = partial[s];
+            envs.observe(states);
+
+            while (r.steps < step_quota && (opts.episodes == 0 || r.misses < episode_quota)) {
+                policy.act_batch(states, actions);
+                repeated.step(actions);
+                const auto steps = repeated.steps();
+                const auto hits = repeated.hits();
+                const auto dones = repeated.dones();
+                const auto rewards = repeated.rewards();
+                // Al final solo se cuentan los entornos que caben en la cuota
+                for (std::size_t i = 0; i < n && r.steps < step_quota; ++i) {
+                    episode[i] += steps[i];
+                    r.steps += steps[i];
+                    r.hits += hits[i];
+                    r.reward += rewards[i];
+                    ++r.decisions;
+                    if (dones[i]) {
+                        ++r.misses;
+                        r.episode_steps += episode[i];
+                        episode[i] = 0;
+                    }
+                }
+                envs.observe(states);
+            }
+        }
+    });
+
+    EvalResult total;
+    for (const auto& r : partial) total += r;
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+} // namespace utec::nn
+
+#endif // EVALUATOR_H
@@ -0,0 +1,282 @@
+#pragma once
+#ifndef EVOLUTION_STRATEGIES_H
+#define EVOLUTION_STRATEGIES_H
+
+/**
+ * @file EvolutionStrategies.h
+ * @brief Entrenamiento sin gradientes (estrategias evolutivas) de la red de PongAgent.
+ *
+ * Los parámetros de Dense(3, H) -> ReLU -> Dense(H, 3) se tratan como un vector plano θ. En cada
+ * generación:
+ *   1. se eligen `population / 2` perturbaciones ε_i como tramos de una tabla de ruido gaussiano
+ *      compartida (solo se guarda un desplazamiento por perturbación);
+ *   2. cada política θ ± σ·ε_i juega `episodes` episodios de EnvGym en un hilo del pool (todas
+ *      con los mismos saques, para que las diferencias vengan de los pesos y no de la suerte);
+ *   3. los retornos se reemplazan por su rango centrado en [-0.5, 0.5] y
+ *      θ += lr · (Σ_i (w⁺_i − w⁻_i)·ε_i / (population·σ) − weight_decay·θ).
+ * Evaluar a los miembros no comparte estado mutable, así que escala con los núcleos, y como el
+ * retorno de cada uno solo depende de θ, ε y los saques, el resultado no cambia con la
+ * cantidad de hilos. Cada
+ * `eval_every` generaciones se mide la tasa de golpes de θ y se registra el tiempo hasta el
+ * objetivo (sin contar esas evaluaciones).
+ */
+
+#include "Evaluator.h"
+#include "PolicySnapshot.h"
+#include "PongAgent.h"
+#include "../utils/random.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Hiperparámetros de las estrategias evolutivas.
+template <typename T>
+struct ESConfig {
+    size_t hidden_size = 16;             ///< Neuronas de la capa oculta
+    size_t population = 128;             ///< Políticas evaluadas por generación (par: ±ε)
+    T sigma = 0.1;                       ///< Escala de las perturbaciones
+    T learning_rate = 0.05;
+    T weight_decay = 0.005;              ///< Encoge θ en cada paso (evita pesos enormes)
+    size_t episodes = 64;                ///< Episodios por política evaluada (con pocos, los golpes
+                                         ///< del primer contacto no alcanzan para ordenar la población)
+    size_t max_episode_steps = 1000;     ///< Tope de pasos por episodio (los peloteos pueden no terminar)
+    size_t generations = 200;
+    size_t noise_size = size_t{1} << 22; ///< Valores de la tabla de ruido compartida
+    size_t threads = 0;                  ///< Hilos del pool (0 = todos los núcleos)
+    double target_hit_rate = 0.9;        ///< Objetivo para el tiempo hasta calidad
+    size_t eval_every = 5;               ///< Generaciones entre evaluaciones de θ (0 = nunca)
+    size_t eval_steps = 200000;          ///< Pasos de cada evaluación
+    bool stop_at_target = false;         ///< Terminar al alcanzar el objetivo
+    std::uint64_t seed = 1;
+};
+
+/// @brief Métricas de una generación.
+struct ESStats {
+    size_t generation = 0;
+    double mean_return = 0;      ///< Retorno medio por episodio de la población
+    double best_return = 0;      ///< Mejor retorno medio de un miembro
+    double hit_rate = -1;        ///< Tasa de golpes de θ (-1 si no se evaluó en esta generación)
+    double seconds = 0;          ///< Tiempo de entrenamiento acumulado (sin evaluaciones)
+    double episodes_per_sec = 0; ///< Episodios jugados por segundo en esta generación
+};
+
+/// @brief Tabla de ruido N(0, 1) compartida: una perturbación es un tramo contiguo de la tabla.
+template <typename T>
+class NoiseTable {
+public:
+    /// @throws std::invalid_argument Si size es 0
+    NoiseTable(size_t size, std::uint64_t seed) : values_(size) {
+        if (size == 0) throw std::invalid_argument("NoiseTable: el tamaño debe ser mayor que 0");
+        utils::Xoshiro256 rng(seed);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        for (auto& v : values_) v = static_cast<T>(normal(rng));
+    }
+
+    size_t size() const noexcept { return values_.size(); }
+
+    /// @brief Desplazamiento aleatorio de un tramo de `length` valores
+    /// @throws std::invalid_argument Si el tramo no cabe en la tabla
+    size_t sample(size_t length, utils::Xoshiro256& rng) const {
+        if (length > values_.size())
+            throw std::invalid_argument("NoiseTable: la perturbacion es mas larga que la tabla");
+        return rng.below(static_cast<std::uint32_t>(values_.size() - length + 1));
+    }
+
+    std::span<const T> slice(size_t offset, size_t length) const { return {values_.data() + offset, length}; }
+
+private:
+    std::vector<T> values_;
+};
+
+/// @brief Entrenador por estrategias evolutivas con evaluación en paralelo.
+template <typename T>
+class EvolutionStrategies {
+public:
+    using Model = typename PongAgent<T>::Sequential;
+    using LogCallback = std::function<void(const ESStats&)>;
+
+    /// @throws std::invalid_argument Si population es impar o 0, o si episodes,
+    /// max_episode_steps o hidden_size es 0
+    explicit EvolutionStrategies(const ESConfig<T>& cfg)
+        : cfg_(validated(cfg)), rng_(cfg.seed), noise_(cfg.noise_size, rng_()), pool_(cfg.threads) {
+        auto model = PongAgent<T>::build_sequential(cfg.hidden_size, static_cast<unsigned>(cfg.seed));
+        params_ = flatten(*model);
+    }
+
+    /// @brief Ejecuta las generaciones.
+    /// @param on_log Se llama al final de cada generación
+    /// @return La red con los parámetros finales (lista para PongAgent)
+    std::unique_ptr<utec::neural_network::ILayer<T>> train(const LogCallback& on_log = {}) {
+        using Clock = std::chrono::steady_clock;
+        const size_t n = params_.size();
+        const size_t pairs = cfg_.population / 2;
+        std::vector<size_t> offsets(pairs);
+        std::vector<double> returns(cfg_.population);
+        std::vector<T> grad(n);
+        Clock::duration eval_time{};
+        const auto start = Clock::now();
+
+        for (size_t gen = 0; gen < cfg_.generations; ++gen) {
+            const auto gen_start = Clock::now();
+            for (auto& o : offsets) o = noise_.sample(n, rng_);
+            const std::uint64_t serves = rng_();  // mismos saques para toda la generación
+
+            pool_.parallel_for(cfg_.population, [&](size_t begin, size_t end) {
+                std::vector<T> theta(n);
+                for (size_t m = begin; m < end; ++m) {
+                    const auto eps = noise_.slice(offsets[m / 2], n);
+                    const T step = (m % 2 == 0 ? cfg_.sigma : -cfg_.sigma);
+                    for (size_t j = 0; j < n; ++j) theta[j] = params_[j] + step * eps[j];
+                    returns[m] = play(PolicySnapshot<T>(theta, cfg_.hidden_size, 0), serves);
+                }
+            });
+
+            const auto weights = centered_ranks(returns);
+            std::fill(grad.begin(), grad.end(), T{0});
+            for (size_t p = 0; p < pairs; ++p) {
+                const T c = static_cast<T>(weights[2 * p] - weights[2 * p + 1]);
+                const auto eps = noise_.slice(offsets[p], n);
+                for (size_t j = 0; j < n; ++j) grad[j] += c * eps[j];
+            }
+            const T scale = T{1} / (static_cast<T>(cfg_.population) * cfg_.sigma);
+            for (size_t j = 0; j < n; ++j)
+                params_[j] += cfg_.learning_rate * (grad[j] * scale - cfg_.weight_decay * params_[j]);
+
+            ESStats stats;
+            stats.generation = gen + 1;
+            stats.mean_return = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+            stats.best_return = *std::max_element(returns.begin(), returns.end());
+            const double gen_seconds = std::chrono::duration<double>(Clock::now() - gen_start).count();
+            stats.episodes_per_sec = gen_seconds > 0 ? cfg_.population * cfg_.episodes / gen_seconds : 0.0;
+            stats.seconds = std::chrono::duration<double>(Clock::now() - start - eval_time).count();
+            generations_ = gen + 1;
+
+            if (cfg_.eval_every && (gen + 1) % cfg_.eval_every == 0) {
+                const auto eval_start = Clock::now();
+                stats.hit_rate = evaluate().hit_rate();
+                eval_time += Clock::now() - eval_start;
+                if (stats.hit_rate >= cfg_.target_hit_rate && time_to_quality_ < 0) {
+                    time_to_quality_ = stats.seconds;
+                    generation_to_quality_ = static_cast<int>(gen + 1);
+                }
+            }
+            if (on_log) on_log(stats);
+            if (cfg_.stop_at_target && time_to_quality_ >= 0) break;
+        }
+        return to_model();
+    }
+
+    /// @brief Tasa de golpes y demás métricas de los parámetros actuales
+    EvalResult evaluate() const {
+        ParallelEvalOptions opts;
+        opts.steps = cfg_.eval_steps;
+        opts.threads = cfg_.threads;
+        opts.seed = cfg_.seed;
+        return evaluate_parallel(PolicySnapshot<T>(params_, cfg_.hidden_size, 0), opts);
+    }
+
+    /// @brief Red nueva con los parámetros actuales
+    std::unique_ptr<Model> to_model() const {
+        auto model = PongAgent<T>::build_sequential(cfg_.hidden_size, static_cast<unsigned>(cfg_.seed));
+        unflatten(params_, *model);
+        return model;
+    }
+
+    std::span<const T> parameters() const noexcept { return params_; }
+    size_t generations() const noexcept { return generations_; }
+
+    /// @brief Segundos de entrenamiento hasta el objetivo (-1: no lo alcanzó)
+    double time_to_quality() const noexcept { return time_to_quality_; }
+    /// @brief Generación en que se alcanzó el objetivo (-1: no lo alcanzó)
+    int generation_to_quality() const noexcept { return generation_to_quality_; }
+
+    /// @brief Parámetros planos de `model` en el orden de PolicySnapshot: W1, b1, W2, b2
+    static std::vector<T> flatten(const Model& model) {
+        std::vector<T> flat;
+        for (const auto* t : {&model.l1->weights(), &model.l1->bias(), &model.l2->weights(), &model.l2->bias()})
+            flat.insert(flat.end(), t->data(), t->data() + t->size());
+        return flat;
+    }
+
+    /// @brief Copia parámetros planos (orden de flatten) a `model`
+    /// @throws std::invalid_argument Si el tamaño no coincide con el modelo
+    static void unflatten(std::span<const T> flat, Model& model) {
+        size_t total = 0;
+        for (const auto* t : {&model.l1->weights(), &model.l1->bias(), &model.l2->weights(), &model.l2->bias()})
+            total += t->size();
+        if (flat.size() != total) throw std::invalid_argument("EvolutionStrategies: cantidad de parametros distinta");
+        const T* p = flat.data();
+        for (auto* t : {&model.l1->weights(), &model.l1->bias(), &model.l2->weights(), &model.l2->bias()}) {
+            std::copy(p, p + t->size(), t->data());
+            p += t->size();
+        }
+    }
+
+    /// @brief Rango de cada retorno reescalado a [-0.5, 0.5]; los empates reciben el rango
+    /// promedio, así que una población sin diferencias no mueve θ
+    static std::vector<double> centered_ranks(std::span<const double> values) {
+        std::vector<size_t> order(values.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] < values[b]; });
+        std::vector<double> ranks(values.size(), 0.0);
+        if (values.size() < 2) return ranks;
+        for (size_t first = 0; first < order.size();) {
+            size_t last = first;
+            while (last + 1 < order.size() && values[order[last + 1]] == values[order[first]]) ++last;
+            const double rank = 0.5 * static_cast<double>(first + last);
+            for (size_t r = first; r <= last; ++r)
+                ranks[order[r]] = rank / static_cast<double>(values.size() - 1) - 0.5;
+            first = last + 1;
+        }
+        return ranks;
+    }
+
+private:
+    ESConfig<T> cfg_;
+    utils::Xoshiro256 rng_;      ///< Perturbaciones y saques
+    NoiseTable<T> noise_;
+    utils::ThreadPool pool_;
+    std::vector<T> params_;      ///< θ
+    size_t generations_ = 0;
+    double time_to_quality_ = -1;
+    int generation_to_quality_ = -1;
+
+    static const ESConfig<T>& validated(const ESConfig<T>& cfg) {
+        if (cfg.population == 0 || cfg.population % 2 != 0)
+            throw std::invalid_argument("EvolutionStrategies: population debe ser par y mayor que 0");
+        if (cfg.episodes == 0 || cfg.max_episode_steps == 0 || cfg.hidden_size == 0)
+            throw std::invalid_argument("EvolutionStrategies: episodes, max_episode_steps y hidden_size deben ser mayores que 0");
+        return cfg;
+    }
+
+    /// @brief Retorno medio por episodio de una política; `serves` fija los saques
+    double play(const PolicySnapshot<T>& policy, std::uint64_t serves) const {
+        EnvGym env(serves);
+        double total = 0;
+        for (size_t e = 0; e < cfg_.episodes; ++e) {
+            State s = env.reset();
+            float reward = 0;
+            bool done = false;
+            for (size_t k = 0; k < cfg_.max_episode_steps && !done; ++k) {
+                s = env.step(policy.act(s), reward, done);
+                total += reward;
+            }
+        }
+        return total / static_cast<double>(cfg_.episodes);
+    }
+};
+
+} // namespace utec::nn
+
+#endif // EVOLUTION_STRATEGIES_H
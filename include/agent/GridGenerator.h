@@ -0,0 +1,222 @@
+#pragma once
+#ifndef GRID_GENERATOR_H
+#define GRID_GENERATOR_H
+
+/**
+ * @file GridGenerator.h
+ * @brief Generación en paralelo de datos sintéticos sobre una grilla de estados de Pong.
+ *
+ * Cada punto de la grilla es una combinación (ball_x, ball_y, ball_vx, ball_vy, paddle_y) y se
+ * identifica por un índice entero; sus coordenadas se calculan como i / (pasos - 1), así que no
+ * se acumula error como al sumar 0.1f en un bucle. Por cada punto se escribe la acción ideal
+ * (recompensa 1) y, opcionalmente, una acción incorrecta (recompensa -1).
+ *
+ * La grilla se reparte en bloques de puntos que los hilos generan en búferes propios; el hilo
+ * principal escribe los bloques en orden mientras los demás siguen generando. Los valores de
+ * cada eje se formatean una sola vez, así que una fila de CSV se arma copiando texto.
+ */
+
+#include "ColumnarDataset.h"
+#include "CsvLoader.h"
+#include "PongSample.h"
+#include "../utils/thread_pool.h"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Resolución y valores de la grilla.
+struct GridSpec {
+    std::size_t ball_x_steps = 11;                  ///< Puntos de ball_x en [0, 1]
+    std::size_t ball_y_steps = 11;                  ///< Puntos de ball_y en [0, 1]
+    std::size_t paddle_steps = 11;                  ///< Puntos de paddle_y en [0, 1]
+    std::vector<float> ball_vx = {-0.02f, 0.02f};   ///< Velocidades X de la bola
+    std::vector<float> ball_vy = {-0.01f, 0.01f};   ///< Velocidades Y de la bola
+    float dead_zone = 0.05f;                        ///< Distancia bola-paleta sin moverse
+    bool wrong_actions = true;                      ///< Agregar una fila con la acción incorrecta
+};
+
+/// @brief Resultado de escribir la grilla.
+struct GridWriteStats {
+    std::uint64_t rows = 0;
+    std::uint64_t bytes = 0;
+    double seconds = 0.0;
+    double rows_per_sec() const { return seconds > 0 ? static_cast<double>(rows) / seconds : 0.0; }
+};
+
+/// @brief Grilla de estados indexada por enteros.
+class GridGenerator {
+public:
+    /// @throws std::invalid_argument Si algún eje no tiene puntos
+    explicit GridGenerator(GridSpec spec) : spec_(std::move(spec)) {
+        if (spec_.ball_x_steps == 0 || spec_.ball_y_steps == 0 || spec_.paddle_steps == 0
+            || spec_.ball_vx.empty() || spec_.ball_vy.empty())
+            throw std::invalid_argument("GridGenerator: cada eje necesita al menos un punto");
+        axes_[0] = axis(spec_.ball_x_steps);
+        axes_[1] = axis(spec_.ball_y_steps);
+        axes_[2] = spec_.ball_vx;
+        axes_[3] = spec_.ball_vy;
+        axes_[4] = axis(spec_.paddle_steps);
+        for (std::size_t a = 0; a < axes_.size(); ++a)
+            for (const float v : axes_[a]) text_[a].push_back(format(v));
+    }
+
+    const GridSpec& spec() const noexcept { return spec_; }
+    std::size_t rows_per_point() const noexcept { return spec_.wrong_actions ? 2 : 1; }
+
+    /// @brief Puntos de la grilla (producto de los tamaños de los ejes)
+    std::uint64_t points() const noexcept {
+        std::uint64_t n = 1;
+        for (const auto& a : axes_) n *= a.size();
+        return n;
+    }
+    std::uint64_t rows() const noexcept { return points() * rows_per_point(); }
+
+    /// @brief Acción ideal: seguir la bola fuera de la zona muerta
+    static int ideal_action(float ball_y, float paddle_y, float dead_zone) {
+        if (ball_y > paddle_y + dead_zone) return 1;
+        if (ball_y < paddle_y - dead_zone) return -1;
+        return 0;
+    }
+
+    /// @brief Acción incorrecta asociada (la opuesta; si la ideal es quedarse, subir)
+    static int wrong_action(int action) { return action == 1 ? -1 : 1; }
+
+    /// @brief Muestras de los puntos [first_point, first_point + count), en orden
+    void generate(std::uint64_t first_point, std::uint64_t count, std::vector<PongSample>& out) const {
+        out.clear();
+        out.reserve(count * rows_per_point());
+        for_points(first_point, count, [&](const std::array<std::size_t, 5>& i) {
+            const float by = axes_[1][i[1]];
+            const float py = axes_[4][i[4]];
+            PongSample s{axes_[0][i[0]], by, axes_[2][i[2]], axes_[3][i[3]], py,
+                         ideal_action(by, py, spec_.dead_zone), 1.0f};
+            out.push_back(s);
+            if (spec_.wrong_actions) {
+                s.action = wrong_action(s.action);
+                s.reward = -1.0f;
+                out.push_back(s);
+            }
+        });
+    }
+
+    /// @brief Deja en `text` las filas CSV de los puntos [first_point, first_point + count)
+    void format_csv(std::uint64_t first_point, std::uint64_t count, std::string& text) const {
+        text.clear();
+        std::string prefix;
+        for_points(first_point, count, [&](const std::array<std::size_t, 5>& i) {
+            const int action = ideal_action(axes_[1][i[1]], axes_[4][i[4]], spec_.dead_zone);
+            prefix.clear();
+            for (std::size_t a = 0; a < 5; ++a) {
+                prefix += text_[a][i[a]];
+                prefix += ',';
+            }
+            text += prefix;
+            text += action == 1 ? "1,1\n" : action == -1 ? "-1,1\n" : "0,1\n";
+            if (spec_.wrong_actions) {
+                text += prefix;
+                text += wrong_action(action) == 1 ? "1,-1\n" : "-1,-1\n";
+            }
+        });
+    }
+
+    /// @brief Escribe la grilla completa como CSV
+    /// @param threads Hilos de generación (0 = todos los núcleos)
+    /// @throws std::runtime_error Si el archivo no se puede escribir
+    GridWriteStats write_csv(const std::string& path, std::size_t threads = 0) const {
+        const auto t0 = std::chrono::steady_clock::now();
+        GridWriteStats stats;
+        stats.bytes = write_pong_csv(path, [&](auto&& write) {
+            run_blocks<std::string>(threads,
+                [this](std::uint64_t first, std::uint64_t count, std::string& text) { format_csv(first, count, text); },
+                [&](std::uint64_t, const std::string& text) { write(text); });
+        });
+        stats.rows = rows();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return stats;
+    }
+
+    /// @brief Escribe la grilla completa en el formato binario por columnas
+    /// @param threads Hilos de generación (0 = todos los núcleos)
+    GridWriteStats write_columns(const std::string& path, std::size_t threads = 0) const {
+        const auto t0 = std::chrono::steady_clock::now();
+        ColumnarWriter writer(path, rows());
+        run_blocks<std::vector<PongSample>>(threads,
+            [this](std::uint64_t first, std::uint64_t count, std::vector<PongSample>& out) { generate(first, count, out); },
+            [&](std::uint64_t first, const std::vector<PongSample>& out) { writer.write(first * rows_per_point(), out); });
+        writer.close();
+        GridWriteStats stats;
+        stats.rows = rows();
+        stats.bytes = std::filesystem::file_size(path);
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return stats;
+    }
+
+    /// @brief Puntos por bloque de trabajo
+    static constexpr std::uint64_t BLOCK_POINTS = std::uint64_t{1} << 15;
+
+private:
+    GridSpec spec_;
+    std::array<std::vector<float>, 5> axes_;        ///< bx, by, vx, vy, py
+    std::array<std::vector<std::string>, 5> text_;  ///< Los mismos valores ya formateados
+
+    static std::vector<float> axis(std::size_t steps) {
+        std::vector<float> v(steps);
+        for (std::size_t i = 0; i < steps; ++i)
+            v[i] = steps == 1 ? 0.0f : static_cast<float>(i) / static_cast<float>(steps - 1);
+        return v;
+    }
+
+    /// @brief Texto más corto que se vuelve a leer como el mismo float
+    static std::string format(float v) {
+        char buf[32];
+        const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+        return std::string(buf, end);
+    }
+
+    /// @brief Llama fn(índices) para los puntos [first, first + count) en orden
+    /// (bx, by, vx, vy, py; py varía más rápido)
+    template <typename F>
+    void for_points(std::uint64_t first, std::uint64_t count, F&& fn) const {
+        std::array<std::size_t, 5> i{};
+        std::uint64_t rest = first;
+        for (std::size_t a = 5; a-- > 0;) {
+            i[a] = static_cast<std::size_t>(rest % axes_[a].size());
+            rest /= axes_[a].size();
+        }
+        for (std::uint64_t p = 0; p < count; ++p) {
+            fn(i);
+            for (std::size_t a = 5; a-- > 0;) {
+                if (++i[a] < axes_[a].size()) break;
+                i[a] = 0;
+            }
+        }
+    }
+
+    /// @brief Genera los bloques en paralelo y los entrega en orden a `consume` en este hilo
+    template <typename Buffer, typename Produce, typename Consume>
+    void run_blocks(std::size_t threads, Produce produce, Consume consume) const {
+        utils::ThreadPool pool(threads);
+        const std::uint64_t total = points();
+        const std::uint64_t blocks = (total + BLOCK_POINTS - 1) / BLOCK_POINTS;
+        pool.ordered_for(
+            blocks,
+            [&](std::size_t b) {
+                Buffer buffer;
+                produce(b * BLOCK_POINTS, std::min(BLOCK_POINTS, total - b * BLOCK_POINTS), buffer);
+                return buffer;
+            },
+            [&](std::size_t b, const Buffer& buffer) { consume(b * BLOCK_POINTS, buffer); });
+    }
+};
+
+} // namespace utec::nn
+
+#endif // GRID_GENERATOR_H
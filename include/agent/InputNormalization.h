@@ -0,0 +1,167 @@
+#pragma once
+#ifndef INPUT_NORMALIZATION_H
+#define INPUT_NORMALIZATION_H
+
+/**
+ * @file InputNormalization.h
+ * @brief Estadísticas por característica en una pasada y estandarización de las entradas.
+ *
+ * feature_stats recorre las filas una sola vez con el algoritmo de Welford (media y varianza
+ * sin restar números grandes parecidos). Las filas se cortan en bloques de tamaño fijo que se
+ * procesan en paralelo y se combinan en orden con la fórmula de Chan, así el resultado no
+ * depende de la cantidad de hilos.
+ *
+ * InputNormalization estandariza cada entrada, x' = (x - media) / desvío, durante el
+ * entrenamiento. Al terminar, fold_into la pliega en la primera capa Dense:
+ *   W'(i, j) = W(i, j) / desvío_i        b'(j) = b(j) - Σ_i W(i, j) · media_i / desvío_i
+ * y la red resultante recibe las entradas crudas, así que la inferencia no paga nada.
+ */
+
+#include "../nn/dense.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Media y varianza de una característica, acumuladas con pesos (Welford).
+struct RunningStats {
+    double weight = 0;   ///< Suma de pesos (cantidad de filas si todas pesan 1)
+    double mean = 0;
+    double m2 = 0;       ///< Suma de pesos por cuadrados de desvíos respecto de la media
+
+    void add(double x, double w = 1.0) {
+        if (w <= 0) return;
+        weight += w;
+        const double delta = x - mean;
+        mean += delta * w / weight;
+        m2 += w * delta * (x - mean);
+    }
+
+    /// @brief Combina con las estadísticas de otro bloque de filas (Chan et al.)
+    void merge(const RunningStats& other) {
+        if (other.weight <= 0) return;
+        if (weight <= 0) {
+            *this = other;
+            return;
+        }
+        const double total = weight + other.weight;
+        const double delta = other.mean - mean;
+        mean += delta * other.weight / total;
+        m2 += other.m2 + delta * delta * weight * other.weight / total;
+        weight = total;
+    }
+
+    /// @brief Varianza poblacional (0 sin filas)
+    double variance() const { return weight > 0 ? std::max(0.0, m2 / weight) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+};
+
+/// @brief Estadísticas de N características.
+template <std::size_t N>
+struct FeatureStats {
+    std::array<RunningStats, N> features{};
+
+    void add(const std::array<double, N>& x, double w = 1.0) {
+        for (std::size_t i = 0; i < N; ++i) features[i].add(x[i], w);
+    }
+
+    void merge(const FeatureStats& other) {
+        for (std::size_t i = 0; i < N; ++i) features[i].merge(other.features[i]);
+    }
+
+    double weight() const { return features[0].weight; }
+    const RunningStats& operator[](std::size_t i) const { return features[i]; }
+};
+
+/// @brief Filas por bloque de feature_stats (también el mínimo para usar hilos)
+inline constexpr std::size_t STATS_BLOCK_ROWS = std::size_t{1} << 16;
+
+/// @brief Estadísticas de `count` filas en una pasada.
+/// @param row `row(i, x)` completa las N características de la fila i y devuelve su peso
+/// @param threads Hilos (0 = todos los núcleos); con un solo bloque no se crea ningún hilo
+template <std::size_t N, typename Row>
+FeatureStats<N> feature_stats(std::size_t count, Row&& row, std::size_t threads = 0) {
+    const std::size_t blocks = (count + STATS_BLOCK_ROWS - 1) / STATS_BLOCK_ROWS;
+    std::vector<FeatureStats<N>> partial(blocks);
+    auto run = [&](std::size_t first, std::size_t last) {
+        std::array<double, N> x{};
+        for (std::size_t b = first; b < last; ++b) {
+            const std::size_t end = std::min(count, (b + 1) * STATS_BLOCK_ROWS);
+            for (std::size_t i = b * STATS_BLOCK_ROWS; i < end; ++i) {
+                const double w = row(i, x);
+                partial[b].add(x, w);
+            }
+        }
+    };
+    if (blocks > 1 && threads != 1) {
+        utec::utils::ThreadPool pool(threads);
+        pool.parallel_for(blocks, run);
+    } else {
+        run(0, blocks);
+    }
+
+    FeatureStats<N> total;
+    for (const auto& p : partial) total.merge(p);
+    return total;
+}
+
+/// @brief Estandarización de las 3 entradas de la red (ball_x, ball_y, paddle_y).
+template <typename T>
+struct InputNormalization {
+    std::array<T, 3> mean{0, 0, 0};
+    std::array<T, 3> scale{1, 1, 1};   ///< 1 / desvío
+
+    /// @brief Normalización a partir de estadísticas. Una entrada constante (desvío menor que
+    /// `min_stddev`) solo se centra.
+    static InputNormalization from_stats(const FeatureStats<3>& stats, double min_stddev = 1e-6) {
+        InputNormalization norm;
+        for (std::size_t i = 0; i < 3; ++i) {
+            norm.mean[i] = static_cast<T>(stats[i].mean);
+            const double sd = stats[i].stddev();
+            norm.scale[i] = static_cast<T>(sd >= min_stddev ? 1.0 / sd : 1.0);
+        }
+        return norm;
+    }
+
+    /// @brief Estandariza en el lugar las filas de `input` (n x 3)
+    void apply(utec::algebra::Tensor<T, 2>& input) const {
+        T* x = input.data();
+        for (std::size_t r = 0, n = input.shape()[0]; r < n; ++r, x += 3)
+            for (std::size_t i = 0; i < 3; ++i) x[i] = (x[i] - mean[i]) * scale[i];
+    }
+
+    /// @brief Pliega la normalización en `layer` (3 x H): después `layer` recibe entradas crudas
+    /// y da las mismas salidas que antes con entradas estandarizadas.
+    /// @throws std::invalid_argument Si la capa no tiene 3 entradas
+    void fold_into(utec::neural_network::Dense<T>& layer) const {
+        auto& W = layer.weights();
+        auto& b = layer.bias();
+        if (W.shape()[0] != 3) throw std::invalid_argument("InputNormalization: la capa debe tener 3 entradas");
+        for (std::size_t j = 0; j < W.shape()[1]; ++j) {
+            double shift = 0;
+            for (std::size_t i = 0; i < 3; ++i) {
+                shift += static_cast<double>(W(i, j)) * scale[i] * mean[i];
+                W(i, j) = W(i, j) * scale[i];
+            }
+            b[j] = static_cast<T>(b[j] - shift);
+        }
+    }
+
+    /// @brief Copia de `layer` con la normalización plegada (la original no cambia)
+    std::unique_ptr<utec::neural_network::Dense<T>> folded(const utec::neural_network::Dense<T>& layer) const {
+        auto copy = std::make_unique<utec::neural_network::Dense<T>>(layer);
+        fold_into(*copy);
+        return copy;
+    }
+};
+
+} // namespace utec::nn
+
+#endif // INPUT_NORMALIZATION_H
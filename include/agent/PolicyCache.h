@@ -0,0 +1,182 @@
+#pragma once
+#ifndef POLICY_CACHE_H
+#define POLICY_CACHE_H
+
+/**
+ * @file PolicyCache.h
+ * @brief Tabla precalculada de acciones: act() en O(1) con una sola lectura de memoria.
+ *
+ * La entrada de la política es (ball_x, ball_y, paddle_y) en [0, 1]³. `PolicyCache` divide ese
+ * cubo en una rejilla de celdas, evalúa la red una vez en el centro de cada celda y guarda la
+ * acción ganadora con 2 bits por celda (32 celdas por palabra de 64 bits): con 64³ celdas la
+ * tabla ocupa 64 KiB y entra en la caché L2. act() cuantiza el estado y lee esos 2 bits.
+ *
+ * La tabla recuerda la versión y el hash de pesos de la PolicySnapshot con la que se construyó;
+ * refresh() la reconstruye solo si cambia alguno de los dos (así, dos copias con la misma versión
+ * y pesos distintos también la invalidan). Es una aproximación: agreement() mide qué fracción de
+ * estados recibe la misma acción que la red exacta.
+ */
+
+#include "PolicySnapshot.h"
+#include "../utils/random.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Resolución de la rejilla (celdas por eje).
+struct PolicyCacheGrid {
+    std::size_t ball_x = 64;
+    std::size_t ball_y = 64;
+    std::size_t paddle_y = 64;
+
+    std::size_t cells() const noexcept { return ball_x * ball_y * paddle_y; }
+};
+
+/// @brief Coincidencia entre la tabla y la red exacta.
+struct CacheAgreement {
+    std::size_t samples = 0;   ///< Estados comparados
+    std::size_t matches = 0;   ///< Estados con la misma acción
+
+    double rate() const { return samples ? static_cast<double>(matches) / samples : 0.0; }
+};
+
+/// @brief Política servida desde una tabla de 2 bits por celda.
+template <typename T>
+class PolicyCache {
+public:
+    /// @brief Construye la tabla evaluando `policy` en el centro de cada celda.
+    /// @param pool Si se pasa, las celdas se reparten entre sus hilos
+    /// @throws std::invalid_argument Si algún eje tiene 0 celdas
+    PolicyCache(const PolicySnapshot<T>& policy, PolicyCacheGrid grid = {}, utils::ThreadPool* pool = nullptr)
+        : grid_(grid) {
+        if (grid.ball_x == 0 || grid.ball_y == 0 || grid.paddle_y == 0)
+            throw std::invalid_argument("PolicyCache: cada eje necesita al menos una celda");
+        words_.resize((grid.cells() + CELLS_PER_WORD - 1) / CELLS_PER_WORD);
+        build(policy, pool);
+    }
+
+    const PolicyCacheGrid& grid() const noexcept { return grid_; }
+
+    /// @brief Versión de la PolicySnapshot con la que se construyó la tabla
+    std::uint64_t version() const noexcept { return version_; }
+
+    /// @brief Bytes que ocupa la tabla
+    std::size_t bytes() const noexcept { return words_.size() * sizeof(std::uint64_t); }
+
+    /// @brief Hash de pesos de la PolicySnapshot con la que se construyó la tabla
+    std::uint64_t weights_hash() const noexcept { return hash_; }
+
+    /// @brief Reconstruye la tabla si `policy` tiene otra versión u otros pesos.
+    /// @return true si se reconstruyó
+    bool refresh(const PolicySnapshot<T>& policy, utils::ThreadPool* pool = nullptr) {
+        if (policy.version() == version_ && policy.weights_hash() == hash_) return false;
+        build(policy, pool);
+        return true;
+    }
+
+    /// @brief Reconstruye la tabla si la política publicada tiene otra versión u otros pesos.
+    /// @return true si se reconstruyó
+    bool refresh(const PublishedPolicy<T>& published, utils::ThreadPool* pool = nullptr) {
+        const auto latest = published.load();
+        return latest ? refresh(*latest, pool) : false;
+    }
+
+    /// @brief Acción (-1, 0 o 1) de la celda que contiene `s`; fuera de [0, 1] se usa el borde
+    int act(const State& s) const noexcept {
+        const std::size_t cell = index(axis(s.ball_x, grid_.ball_x), axis(s.ball_y, grid_.ball_y),
+                                       axis(s.paddle_y, grid_.paddle_y));
+        return code(cell) - 1;
+    }
+
+    /// @brief Acción para cada estado
+    /// @throws std::invalid_argument Si los tamaños no coinciden
+    void act_batch(std::span<const State> states, std::span<int> actions) const {
+        if (actions.size() != states.size())
+            throw std::invalid_argument("PolicyCache::act_batch: states y actions deben tener el mismo tamaño");
+        for (std::size_t i = 0; i < states.size(); ++i) actions[i] = act(states[i]);
+    }
+
+    /// @brief Compara la tabla con la red exacta en los estados dados
+    CacheAgreement agreement(const PolicySnapshot<T>& policy, std::span<const State> states) const {
+        CacheAgreement result;
+        for (const State& s : states) {
+            ++result.samples;
+            result.matches += act(s) == policy.act(s);
+        }
+        return result;
+    }
+
+    /// @brief Compara la tabla con la red exacta en `samples` estados uniformes en [0, 1]³
+    CacheAgreement agreement(const PolicySnapshot<T>& policy, std::size_t samples, utils::Xoshiro256& rng) const {
+        CacheAgreement result;
+        for (std::size_t i = 0; i < samples; ++i) {
+            const State s{rng.uniform01(), rng.uniform01(), rng.uniform01()};
+            ++result.samples;
+            result.matches += act(s) == policy.act(s);
+        }
+        return result;
+    }
+
+private:
+    static constexpr std::size_t CELLS_PER_WORD = 32;
+
+    PolicyCacheGrid grid_;
+    std::uint64_t version_ = 0;
+    std::uint64_t hash_ = 0;
+    std::vector<std::uint64_t> words_;
+
+    /// @brief Celda de un eje con `n` celdas (satura en los bordes)
+    static std::size_t axis(float v, std::size_t n) noexcept {
+        const float scaled = v * static_cast<float>(n);
+        if (!(scaled > 0.0f)) return 0;
+        return std::min(static_cast<std::size_t>(scaled), n - 1);
+    }
+
+    std::size_t index(std::size_t x, std::size_t y, std::size_t p) const noexcept {
+        return (x * grid_.ball_y + y) * grid_.paddle_y + p;
+    }
+
+    /// @brief Código guardado (acción + 1) de una celda
+    int code(std::size_t cell) const noexcept {
+        return static_cast<int>((words_[cell / CELLS_PER_WORD] >> (2 * (cell % CELLS_PER_WORD))) & 3u);
+    }
+
+    /// @brief Llena las palabras [begin, end); cada palabra la escribe un solo hilo
+    void fill(const PolicySnapshot<T>& policy, std::size_t begin, std::size_t end) {
+        const std::size_t cells = grid_.cells();
+        for (std::size_t w = begin; w < end; ++w) {
+            std::uint64_t word = 0;
+            const std::size_t first = w * CELLS_PER_WORD;
+            const std::size_t last = std::min(first + CELLS_PER_WORD, cells);
+            for (std::size_t cell = first; cell < last; ++cell) {
+                const std::size_t p = cell % grid_.paddle_y;
+                const std::size_t y = (cell / grid_.paddle_y) % grid_.ball_y;
+                const std::size_t x = cell / (grid_.paddle_y * grid_.ball_y);
+                // Centro de la celda
+                const State s{(x + 0.5f) / grid_.ball_x, (y + 0.5f) / grid_.ball_y, (p + 0.5f) / grid_.paddle_y};
+                word |= static_cast<std::uint64_t>(policy.act(s) + 1) << (2 * (cell - first));
+            }
+            words_[w] = word;
+        }
+    }
+
+    void build(const PolicySnapshot<T>& policy, utils::ThreadPool* pool) {
+        if (pool)
+            pool->parallel_for(words_.size(), [&](std::size_t begin, std::size_t end) { fill(policy, begin, end); });
+        else
+            fill(policy, 0, words_.size());
+        version_ = policy.version();
+        hash_ = policy.weights_hash();
+    }
+};
+
+} // namespace utec::nn
+
+#endif // POLICY_CACHE_H
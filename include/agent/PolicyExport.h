@@ -0,0 +1,146 @@
+#pragma once
+#ifndef POLICY_EXPORT_H
+#define POLICY_EXPORT_H
+
+/**
+ * @file PolicyExport.h
+ * @brief Exporta una red 3 -> H -> 3 como un header de C++ autocontenido.
+ *
+ * El header generado no depende de este proyecto: tiene los pesos como arreglos `constexpr` y
+ * funciones `constexpr` `outputs()` y `act()` desenrolladas para la topología exacta (una línea
+ * por neurona oculta y por salida). Quien lo incluye no lee ningún archivo al arrancar y el
+ * compilador puede plegar constantes y vectorizar toda la pasada hacia adelante; con
+ * argumentos constantes la acción se calcula en tiempo de compilación.
+ *
+ * Los pesos se escriben como literales hexadecimales (`%a`), así que el valor es exactamente
+ * el del modelo, y las sumas siguen el orden de PolicySnapshot: para el mismo estado el header
+ * da las mismas salidas y la misma acción (incluida la regla de empates de PongAgent).
+ */
+
+#include "PongAgent.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace utec::nn {
+
+/// @brief Opciones del header generado.
+struct PolicyExportOptions {
+    std::string name_space = "pong_policy";   ///< Espacio de nombres de los pesos y funciones
+    std::string source;                       ///< Origen de los pesos, para el comentario inicial
+};
+
+namespace export_detail {
+
+/// @brief Literal exacto de `v` (hexadecimal, con sufijo f para float)
+template <typename T>
+std::string literal(T v) {
+    if (!std::isfinite(v)) throw std::invalid_argument("export_policy_header: el modelo tiene pesos no finitos");
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%a", static_cast<double>(v));
+    return std::string(buf) + (std::is_same_v<T, float> ? "f" : "");
+}
+
+} // namespace export_detail
+
+/// @brief Texto del header para `model`.
+/// @throws std::invalid_argument Si el modelo no es 3 -> H -> 3, tiene pesos no finitos o el
+///         espacio de nombres está vacío
+template <typename T>
+std::string export_policy_header(const typename PongAgent<T>::Sequential& model,
+                                 const PolicyExportOptions& opts = {}) {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "export_policy_header: float o double");
+    using export_detail::literal;
+
+    const auto& w1 = model.l1->weights();
+    const auto& b1 = model.l1->bias();
+    const auto& w2 = model.l2->weights();
+    const auto& b2 = model.l2->bias();
+    if (w1.shape()[0] != 3 || w2.shape()[1] != 3 || w1.shape()[1] != w2.shape()[0])
+        throw std::invalid_argument("export_policy_header: se esperaba un modelo 3 -> H -> 3");
+    if (opts.name_space.empty()) throw std::invalid_argument("export_policy_header: falta el espacio de nombres");
+
+    const size_t H = w1.shape()[1];
+    const std::string t = std::is_same_v<T, float> ? "float" : "double";
+    const std::string zero = std::is_same_v<T, float> ? "0.0f" : "0.0";
+    const char* inputs[3] = {"ball_x", "ball_y", "paddle_y"};
+    std::ostringstream os;
+
+    os << "// Politica de Pong 3 -> " << H << " -> 3 generada por pong_export";
+    if (!opts.source.empty()) os << " a partir de " << opts.source;
+    os << ".\n// No editar a mano: volver a generarla si cambian los pesos.\n"
+       << "#pragma once\n\n#include <array>\n\nnamespace " << opts.name_space << " {\n\n"
+       << "inline constexpr int HIDDEN = " << H << ";\n\n";
+
+    auto matrix = [&](const char* name, const auto& m, size_t rows, size_t cols) {
+        os << "inline constexpr " << t << ' ' << name << '[' << rows << "][" << cols << "] = {\n";
+        for (size_t r = 0; r < rows; ++r) {
+            os << "    {";
+            for (size_t c = 0; c < cols; ++c) os << (c ? ", " : "") << literal(m(r, c));
+            os << "},\n";
+        }
+        os << "};\n";
+    };
+    auto vector = [&](const char* name, const auto& v, size_t n) {
+        os << "inline constexpr " << t << ' ' << name << '[' << n << "] = {";
+        for (size_t i = 0; i < n; ++i) os << (i ? ", " : "") << literal(v[i]);
+        os << "};\n";
+    };
+    matrix("W1", w1, 3, H);
+    vector("B1", b1, H);
+    matrix("W2", w2, H, 3);
+    vector("B2", b2, 3);
+
+    os << "\nconstexpr " << t << " relu(" << t << " x) noexcept { return x > " << zero << " ? x : " << zero
+       << "; }\n\n"
+       << "/// Salidas de la red para un estado (mismo orden de sumas que PolicySnapshot)\n"
+       << "constexpr std::array<" << t << ", 3> outputs(" << t << " ball_x, " << t << " ball_y, " << t
+       << " paddle_y) noexcept {\n";
+    for (size_t i = 0; i < H; ++i) {
+        os << "    const " << t << " h" << i << " = relu(" << zero;
+        for (size_t k = 0; k < 3; ++k) os << " + " << inputs[k] << " * W1[" << k << "][" << i << ']';
+        os << " + B1[" << i << "]);\n";
+    }
+    os << "    return {\n";
+    for (size_t j = 0; j < 3; ++j) {
+        os << "        " << zero;
+        for (size_t i = 0; i < H; ++i) os << " + h" << i << " * W2[" << i << "][" << j << ']';
+        os << " + B2[" << j << "],\n";
+    }
+    os << "    };\n}\n\n"
+       << "/// Accion greedy: -1 abajo, 0 quieto, 1 arriba. Si una salida posterior empata con el\n"
+       << "/// maximo vigente devuelve 0, como PongAgent::select_action.\n"
+       << "constexpr int act(" << t << " ball_x, " << t << " ball_y, " << t << " paddle_y) noexcept {\n"
+       << "    const auto o = outputs(ball_x, ball_y, paddle_y);\n"
+       << "    " << t << " best = o[0];\n"
+       << "    int index = 0;\n"
+       << "    bool tie = false;\n"
+       << "    if (o[1] > best) { best = o[1]; index = 1; } else if (o[1] == best) { tie = true; }\n"
+       << "    if (o[2] > best) { index = 2; tie = false; } else if (o[2] == best) { tie = true; }\n"
+       << "    return tie ? 0 : index - 1;\n"
+       << "}\n\n"
+       << "/// Misma accion para cualquier estado con campos ball_x, ball_y y paddle_y\n"
+       << "template <typename State>\n"
+       << "constexpr int act(const State& s) noexcept { return act(s.ball_x, s.ball_y, s.paddle_y); }\n\n"
+       << "} // namespace " << opts.name_space << '\n';
+    return os.str();
+}
+
+/// @brief Escribe el header de `model` en `path`.
+/// @throws std::runtime_error Si no se puede escribir el archivo
+template <typename T>
+void write_policy_header(const std::string& path, const typename PongAgent<T>::Sequential& model,
+                         const PolicyExportOptions& opts = {}) {
+    const std::string text = export_policy_header<T>(model, opts);
+    std::ofstream file(path, std::ios::binary);
+    if (!(file << text) || !file.flush()) throw std::runtime_error("No se pudo escribir el header: " + path);
+}
+
+} // namespace utec::nn
+
+#endif // POLICY_EXPORT_H
@@ -0,0 +1,207 @@
+#pragma once
+#ifndef POLICY_RELOADER_H
+#define POLICY_RELOADER_H
+
+/**
+ * @file PolicyReloader.h
+ * @brief Recarga en caliente de los archivos de pesos en una simulación que sigue corriendo.
+ *
+ * PolicyHotReloader vigila el par de archivos de pesos (tamaño y hora de modificación) desde
+ * un hilo propio. Cuando cambian y se mantienen iguales durante un intervalo completo (así no
+ * se lee un archivo que se está escribiendo), arma un PolicySnapshot nuevo fuera de la
+ * simulación y lo publica en un PublishedPolicy. Quien juega nunca espera: sigue usando su
+ * copia inmutable y toma la nueva en su próximo refresh(); la copia vieja se libera cuando el
+ * último lector la suelta (estilo RCU). Si los archivos no se pueden leer, la política
+ * vigente no cambia y se vuelve a intentar cuando los archivos cambien otra vez.
+ *
+ * save_policy_weights escribe cada archivo en un temporal y lo renombra, así el vigilante
+ * nunca ve un archivo a medias.
+ */
+
+#include "PolicySnapshot.h"
+#include "PongAgent.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace utec::nn {
+
+/// @brief Tamaño y hora de modificación de un archivo (exists = false si no se pudo leer).
+struct FileStamp {
+    bool exists = false;
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type time{};
+
+    bool operator==(const FileStamp&) const = default;
+};
+
+inline FileStamp file_stamp(const std::string& path) {
+    std::error_code ec1, ec2;
+    FileStamp stamp;
+    stamp.size = std::filesystem::file_size(path, ec1);
+    stamp.time = std::filesystem::last_write_time(path, ec2);
+    stamp.exists = !ec1 && !ec2;
+    if (!stamp.exists) stamp = {};
+    return stamp;
+}
+
+/// @brief Lee un par de archivos de pesos como una política inmutable.
+/// @throws std::runtime_error Si los archivos faltan, están incompletos o no son 3 -> H -> 3
+template <typename T>
+std::shared_ptr<const PolicySnapshot<T>> load_policy_snapshot(const std::string& weights1,
+                                                              const std::string& weights2, std::uint64_t version) {
+    auto model = PongAgent<T>::create_sequential_with_weights(weights1, weights2);
+    return std::make_shared<const PolicySnapshot<T>>(static_cast<const typename PongAgent<T>::Sequential&>(*model),
+                                                     version);
+}
+
+/// @brief Guarda las dos capas de `model` escribiendo cada archivo en un temporal y renombrándolo.
+/// @throws std::runtime_error Si no se puede escribir o renombrar
+template <typename T>
+void save_policy_weights(const typename PongAgent<T>::Sequential& model, const std::string& weights1,
+                         const std::string& weights2) {
+    auto save = [](const auto& layer, const std::string& path) {
+        const std::string tmp = path + ".tmp";
+        layer.save_weights(tmp);
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::remove(tmp.c_str());
+            throw std::runtime_error("No se pudo guardar el archivo de pesos: " + path);
+        }
+    };
+    save(*model.l1, weights1);
+    save(*model.l2, weights2);
+}
+
+/// @brief Vigila un par de archivos de pesos y publica cada versión nueva.
+template <typename T>
+class PolicyHotReloader {
+public:
+    /// @brief Empieza a vigilar. Los archivos tal como están ahora cuentan como ya cargados:
+    /// solo se publica cuando cambian.
+    /// @param target Dónde se publican las políticas nuevas
+    /// @param poll Intervalo entre revisiones; un cambio se publica entre uno y dos intervalos después
+    /// @param watch Si es false no se crea el hilo y las revisiones se hacen con poll_once()
+    PolicyHotReloader(PublishedPolicy<T>& target, std::string weights1, std::string weights2,
+                      std::chrono::milliseconds poll = std::chrono::milliseconds(250), bool watch = true)
+        : target_(target), paths_{std::move(weights1), std::move(weights2)}, poll_(poll) {
+        seen_ = stamps();
+        if (watch) watcher_ = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    ~PolicyHotReloader() {
+        watcher_.request_stop();
+        if (watcher_.joinable()) watcher_.join();
+    }
+
+    PolicyHotReloader(const PolicyHotReloader&) = delete;
+    PolicyHotReloader& operator=(const PolicyHotReloader&) = delete;
+
+    /// @brief Revisa los archivos una vez
+    /// @return true si se publicó una política nueva
+    bool poll_once() {
+        std::lock_guard lock(mutex_);
+        const auto now = stamps();
+        if (now == seen_) {
+            pending_ = false;
+            return false;
+        }
+        // Cambiaron: se espera a verlos iguales en dos revisiones seguidas
+        if (!pending_ || now != candidate_) {
+            candidate_ = now;
+            pending_ = true;
+            return false;
+        }
+        pending_ = false;
+        seen_ = now;
+        if (!now[0].exists || !now[1].exists) return false;
+        try {
+            target_.publish(load_policy_snapshot<T>(paths_[0], paths_[1], target_.version() + 1));
+            ++reloads_;
+            return true;
+        } catch (const std::exception& e) {
+            ++failures_;
+            last_error_ = e.what();
+            return false;
+        }
+    }
+
+    /// @brief Políticas publicadas desde que empezó a vigilar
+    std::uint64_t reloads() const {
+        std::lock_guard lock(mutex_);
+        return reloads_;
+    }
+
+    /// @brief Cambios que no se pudieron cargar (la política vigente se mantuvo)
+    std::uint64_t failures() const {
+        std::lock_guard lock(mutex_);
+        return failures_;
+    }
+
+    std::string last_error() const {
+        std::lock_guard lock(mutex_);
+        return last_error_;
+    }
+
+private:
+    using Stamps = std::array<FileStamp, 2>;
+
+    PublishedPolicy<T>& target_;
+    std::array<std::string, 2> paths_;
+    std::chrono::milliseconds poll_;
+
+    mutable std::mutex mutex_;   ///< Protege el estado de las revisiones (hilo propio y poll_once)
+    Stamps seen_{};              ///< Archivos ya cargados (o descartados por error)
+    Stamps candidate_{};         ///< Cambio visto en la revisión anterior
+    bool pending_ = false;
+    std::uint64_t reloads_ = 0;
+    std::uint64_t failures_ = 0;
+    std::string last_error_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable_any sleep_;
+    std::jthread watcher_;       ///< Último miembro: se detiene antes de destruir lo demás
+
+    Stamps stamps() const { return {file_stamp(paths_[0]), file_stamp(paths_[1])}; }
+
+    void run(std::stop_token stop) {
+        while (!stop.stop_requested()) {
+            poll_once();
+            std::unique_lock lock(sleep_mutex_);
+            sleep_.wait_for(lock, stop, poll_, [] { return false; });
+        }
+    }
+};
+
+/// @brief Vista de un PublishedPolicy para evaluate_parallel: cada lote usa la última política
+/// publicada, y una recarga a mitad de la evaluación se aplica desde el lote siguiente.
+template <typename T>
+class LivePolicy {
+public:
+    explicit LivePolicy(const PublishedPolicy<T>& published) : published_(published) {}
+
+    /// @throws std::logic_error Si todavía no se publicó ninguna política
+    void act_batch(std::span<const State> states, std::span<int> actions) const {
+        const auto snapshot = published_.load();
+        if (!snapshot) throw std::logic_error("LivePolicy: no hay ninguna politica publicada");
+        snapshot->act_batch(states, actions);
+    }
+
+private:
+    const PublishedPolicy<T>& published_;
+};
+
+} // namespace utec::nn
+
+#endif // POLICY_RELOADER_H
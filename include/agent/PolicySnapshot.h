@@ -0,0 +1,186 @@
+#pragma once
+#ifndef POLICY_SNAPSHOT_H
+#define POLICY_SNAPSHOT_H
+
+/**
+ * @file PolicySnapshot.h
+ * @brief Copia inmutable, solo de inferencia, de la red del agente y su publicación entre hilos.
+ *
+ * Un `PolicySnapshot` guarda los pesos de Dense(3, H) -> ReLU -> Dense(H, 3) en arreglos
+ * contiguos y evalúa sin asignar memoria ni tocar estado mutable, así que varios hilos pueden
+ * usar la misma copia a la vez. `PublishedPolicy` la comparte por un
+ * `std::atomic<std::shared_ptr>`: quien publica reemplaza el puntero de una vez y los lectores
+ * siguen usando su copia hasta que ven un número de versión nuevo (ninguno espera al otro).
+ */
+
+#include "PongAgent.h"
+#include "../utils/hash.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Red 3 -> H -> 3 congelada para elegir acciones.
+template <typename T>
+class PolicySnapshot {
+public:
+    using Model = typename PongAgent<T>::Sequential;
+
+    /// @brief Copia los pesos actuales de `model`.
+    /// @param version Número que identifica esta copia (crece con cada publicación)
+    /// @throws std::invalid_argument Si el modelo no es 3 -> H -> 3
+    PolicySnapshot(const Model& model, std::uint64_t version) : version_(version) {
+        const auto& w1 = model.l1->weights();
+        const auto& w2 = model.l2->weights();
+        if (w1.shape()[0] != 3 || w2.shape()[1] != 3 || w1.shape()[1] != w2.shape()[0])
+            throw std::invalid_argument("PolicySnapshot: se esperaba un modelo 3 -> H -> 3");
+        hidden_ = w1.shape()[1];
+        // W1 se guarda transpuesta (H x 3): cada neurona oculta lee 3 pesos seguidos
+        w1_.resize(hidden_ * 3);
+        for (size_t i = 0; i < hidden_; ++i)
+            for (size_t k = 0; k < 3; ++k) w1_[i * 3 + k] = w1(k, i);
+        b1_.assign(model.l1->bias().data(), model.l1->bias().data() + hidden_);
+        w2_.assign(w2.data(), w2.data() + hidden_ * 3);
+        b2_.assign(model.l2->bias().data(), model.l2->bias().data() + 3);
+        hash_ = hash_weights();
+    }
+
+    /// @brief Copia desde parámetros planos en el orden de las capas Dense: W1 (3 x H, por
+    /// filas), b1 (H), W2 (H x 3, por filas), b2 (3).
+    /// @throws std::invalid_argument Si hidden es 0 o params no tiene parameter_count(hidden) valores
+    PolicySnapshot(std::span<const T> params, size_t hidden, std::uint64_t version)
+        : version_(version), hidden_(hidden) {
+        if (hidden == 0 || params.size() != parameter_count(hidden))
+            throw std::invalid_argument("PolicySnapshot: se esperaban 7 * H + 3 parametros");
+        const T* p = params.data();
+        w1_.resize(hidden_ * 3);
+        for (size_t k = 0; k < 3; ++k)
+            for (size_t i = 0; i < hidden_; ++i) w1_[i * 3 + k] = *p++;
+        b1_.assign(p, p + hidden_);
+        p += hidden_;
+        w2_.assign(p, p + hidden_ * 3);
+        p += hidden_ * 3;
+        b2_.assign(p, p + 3);
+        hash_ = hash_weights();
+    }
+
+    /// @brief Parámetros de una red 3 -> H -> 3
+    static constexpr size_t parameter_count(size_t hidden) noexcept { return 7 * hidden + 3; }
+
+    std::uint64_t version() const noexcept { return version_; }
+    size_t hidden() const noexcept { return hidden_; }
+
+    /// @brief Hash de W1, b1, W2 y b2: distingue copias con la misma versión y otros pesos
+    std::uint64_t weights_hash() const noexcept { return hash_; }
+
+    /// @brief Red Dense -> ReLU -> Dense entrenable con los mismos pesos (para seguir usándola
+    /// con PongAgent o guardarla)
+    std::unique_ptr<Model> to_model() const {
+        using utec::algebra::Tensor;
+        using utec::neural_network::Dense;
+        auto l1 = std::make_unique<Dense<T>>(
+            3, hidden_,
+            [this](Tensor<T, 2>& w) {
+                for (size_t i = 0; i < hidden_; ++i)
+                    for (size_t k = 0; k < 3; ++k) w(k, i) = w1_[i * 3 + k];
+            },
+            [this](Tensor<T, 2>& b) { std::copy(b1_.begin(), b1_.end(), b.data()); });
+        auto l2 = std::make_unique<Dense<T>>(
+            hidden_, 3, [this](Tensor<T, 2>& w) { std::copy(w2_.begin(), w2_.end(), w.data()); },
+            [this](Tensor<T, 2>& b) { std::copy(b2_.begin(), b2_.end(), b.data()); });
+        return std::make_unique<Model>(std::move(l1), std::make_unique<utec::neural_network::ReLU<T>>(),
+                                       std::move(l2));
+    }
+
+    /// @brief Valores de salida de la red para un estado (mismo orden de sumas que Dense)
+    void outputs(const State& s, T out[3]) const {
+        out[0] = out[1] = out[2] = 0;
+        for (size_t i = 0; i < hidden_; ++i) {
+            const T* w = &w1_[i * 3];
+            T h = 0;
+            h += s.ball_x * w[0];
+            h += s.ball_y * w[1];
+            h += s.paddle_y * w[2];
+            h += b1_[i];
+            if (!(h > 0)) continue;
+            out[0] += h * w2_[i * 3 + 0];
+            out[1] += h * w2_[i * 3 + 1];
+            out[2] += h * w2_[i * 3 + 2];
+        }
+        for (size_t j = 0; j < 3; ++j) out[j] += b2_[j];
+    }
+
+    /// @brief Acción greedy (-1, 0 o 1) con la regla de empates de PongAgent
+    int act(const State& s) const {
+        T out[3];
+        outputs(s, out);
+        return PongAgent<T>::select_action(out, 3);
+    }
+
+    /// @brief Acción greedy para cada estado
+    /// @throws std::invalid_argument Si los tamaños no coinciden
+    void act_batch(std::span<const State> states, std::span<int> actions) const {
+        if (actions.size() != states.size())
+            throw std::invalid_argument("PolicySnapshot::act_batch: states y actions deben tener el mismo tamaño");
+        for (size_t i = 0; i < states.size(); ++i) actions[i] = act(states[i]);
+    }
+
+private:
+    std::uint64_t version_;
+    std::uint64_t hash_ = 0;
+    size_t hidden_ = 0;
+    std::vector<T> w1_;   ///< H x 3 (transpuesta de l1)
+    std::vector<T> b1_;   ///< H
+    std::vector<T> w2_;   ///< H x 3
+    std::vector<T> b2_;   ///< 3
+
+    std::uint64_t hash_weights() const noexcept {
+        std::uint64_t h = hidden_;
+        for (const auto* v : {&w1_, &b1_, &w2_, &b2_}) h = utils::hash_bytes(v->data(), v->size() * sizeof(T), h);
+        return h;
+    }
+};
+
+/// @brief Última política publicada, compartida entre un escritor y muchos lectores.
+template <typename T>
+class PublishedPolicy {
+public:
+    using Snapshot = PolicySnapshot<T>;
+
+    /// @brief Reemplaza la política vigente; los lectores la toman en su próximo refresh()
+    void publish(std::shared_ptr<const Snapshot> snapshot) {
+        const std::uint64_t version = snapshot ? snapshot->version() : 0;
+        current_.store(std::move(snapshot), std::memory_order_release);
+        version_.store(version, std::memory_order_release);
+    }
+
+    /// @brief Política vigente (puede ser nula si nunca se publicó)
+    std::shared_ptr<const Snapshot> load() const { return current_.load(std::memory_order_acquire); }
+
+    /// @brief Versión de la política vigente; leerla es un solo atómico, sin contador de referencias
+    std::uint64_t version() const noexcept { return version_.load(std::memory_order_acquire); }
+
+    /// @brief Actualiza `local` solo si se publicó una versión distinta.
+    /// @return true si `local` cambió
+    bool refresh(std::shared_ptr<const Snapshot>& local) const {
+        if (local && local->version() == version()) return false;
+        auto latest = load();
+        if (latest == local) return false;
+        local = std::move(latest);
+        return true;
+    }
+
+private:
+    std::atomic<std::shared_ptr<const Snapshot>> current_;
+    std::atomic<std::uint64_t> version_{0};
+};
+
+} // namespace utec::nn
+
+#endif // POLICY_SNAPSHOT_H
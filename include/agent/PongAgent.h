@@ -7,23 +7,50 @@
 #include "../nn/loss.h"
 #include "../nn/optimizer.h"
 #include "../nn/activation.h"
+#include "../nn/telemetry.h"
+#include "ColumnarDataset.h"
+#include "CsvLoader.h"
 #include "EnvGym.h"
+#include "InputNormalization.h"
+#include "PongSample.h"
+#include "PreparedDataset.h"
+#include "SampleStream.h"
+#include "SessionRecorder.h"
+#include "../utils/random.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <iostream>
-#include <cstdlib>
+#include <functional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
 
 namespace utec::nn {
 
-/// @brief Representa un ejemplo de entrenamiento para Pong.
-struct PongSample {
-    float ball_x, ball_y, ball_vx, ball_vy, paddle_y;
-    int action;     ///< Acción tomada en ese estado (-1, 0, 1)
-    float reward;   ///< Recompensa obtenida por esa acción
+/// @brief Optimizador usado por el entrenamiento supervisado.
+enum class OptimizerKind { SGD, Adam };
+
+/// @brief Hiperparámetros del entrenamiento supervisado de PongAgent.
+template <typename T>
+struct TrainConfig {
+    size_t hidden_size = 8;                        ///< Neuronas de la capa oculta
+    T learning_rate = 0.001;                       ///< Tasa pasada directamente al optimizador
+    OptimizerKind optimizer = OptimizerKind::SGD;  ///< SGD o Adam
+    size_t batch_size = 1;                         ///< Muestras por actualización
+    int epochs = 100;                              ///< Épocas de entrenamiento
+    unsigned seed = 0;                             ///< Semilla de los pesos iniciales (0: una distinta en cada llamada)
+    bool verbose = false;                          ///< Imprime la pérdida cada 10 épocas
+    bool normalize_inputs = false;                 ///< Estandariza las entradas (ver InputNormalization.h);
+                                                   ///< el modelo devuelto las recibe crudas igual
 };
 
 /// @brief Agente basado en red neuronal para el entorno Pong.
@@ -36,6 +63,7 @@ public:
         std::unique_ptr<utec::neural_network::Dense<T>> l1;
         std::unique_ptr<utec::neural_network::ReLU<T>> act;
         std::unique_ptr<utec::neural_network::Dense<T>> l2;
+        utec::neural_network::TrainingTelemetry* telemetry = nullptr; ///< Tiempos por capa (opcional)
 
         Sequential(std::unique_ptr<utec::neural_network::Dense<T>> a,
                    std::unique_ptr<utec::neural_network::ReLU<T>> b,
@@ -44,29 +72,89 @@ public:
 
         /// @brief Propagación hacia adelante.
         utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& x) override {
-            return l2->forward(act->forward(l1->forward(x)));
+            sync_grad_requirements();
+            if (!telemetry) return l2->forward(act->forward(l1->forward(x)));
+
+            using utec::neural_network::Phase;
+            using utec::neural_network::ScopedPhase;
+            utec::algebra::Tensor<T, 2> h, a;
+            { ScopedPhase p(telemetry, 0, Phase::Forward); h = l1->forward(x); }
+            { ScopedPhase p(telemetry, 1, Phase::Forward); a = act->forward(h); }
+            ScopedPhase p(telemetry, 2, Phase::Forward);
+            return l2->forward(a);
         }
 
         /// @brief Retropropagación del gradiente.
+        /// Si l1 está congelada y nadie pide dX del modelo, termina después de l2.
         utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& grad) override {
-            return l1->backward(act->backward(l2->backward(grad)));
+            const bool below = needs_grad_below_l2();
+            if (!telemetry) {
+                auto g2 = l2->backward(grad);
+                if (!below) return {};
+                return l1->backward(act->backward(g2));
+            }
+
+            using utec::neural_network::Phase;
+            using utec::neural_network::ScopedPhase;
+            utec::algebra::Tensor<T, 2> g2, g1;
+            { ScopedPhase p(telemetry, 2, Phase::Backward); g2 = l2->backward(grad); }
+            if (!below) return {};
+            { ScopedPhase p(telemetry, 1, Phase::Backward); g1 = act->backward(g2); }
+            ScopedPhase p(telemetry, 0, Phase::Backward);
+            return l1->backward(g1);
+        }
+
+        /// @brief Congela (o descongela) ambas capas densas
+        void set_frozen(bool frozen) override {
+            utec::neural_network::ILayer<T>::set_frozen(frozen);
+            l1->set_frozen(frozen);
+            l2->set_frozen(frozen);
         }
 
+        /// @brief El modelo se entrena si alguna de sus capas densas lo hace
+        bool trainable() const override { return l1->trainable() || l2->trainable(); }
+
         /// @brief Actualiza los parámetros del modelo con un optimizador.
         void update_params(utec::neural_network::IOptimizer<T>& opt) override {
-            l1->update_params(opt);
-            l2->update_params(opt);
+            using utec::neural_network::Phase;
+            using utec::neural_network::ScopedPhase;
+            { ScopedPhase p(telemetry, 0, Phase::Update); l1->update_params(opt); }
+            { ScopedPhase p(telemetry, 2, Phase::Update); l2->update_params(opt); }
+        }
+
+        /// @brief Hace falta propagar por debajo de l2 si l1 se entrena o si se pide dX del modelo
+        bool needs_grad_below_l2() const { return l1->trainable() || this->requires_input_grad_; }
+
+        /// @brief Propaga a las subcapas qué gradientes de entrada se necesitan.
+        /// Se llama en cada forward por si l1 o l2 se congelaron directamente.
+        void sync_grad_requirements() {
+            const bool below = needs_grad_below_l2();
+            l1->set_requires_input_grad(this->requires_input_grad_);
+            act->set_requires_input_grad(below);
+            l2->set_requires_input_grad(below);
+        }
+
+        /// @brief Nombres de las capas, en el orden usado por la telemetría
+        std::vector<std::string> layer_names() const {
+            return {"Dense(" + std::to_string(l1->in_features()) + "->" + std::to_string(l1->out_features()) + ")",
+                    "ReLU",
+                    "Dense(" + std::to_string(l2->in_features()) + "->" + std::to_string(l2->out_features()) + ")"};
         }
     };
 
+    /// @brief Callback por época: (época, pérdida promedio, modelo). Devolver false detiene el entrenamiento.
+    using EpochCallback = std::function<bool(int, T, utec::neural_network::ILayer<T>&)>;
+
 private:
     std::unique_ptr<utec::neural_network::ILayer<T>> model_;
-
-    /// @brief Inicializador aleatorio de pesos.
-    static void initialize_weights(utec::algebra::Tensor<T, 2>& t) {
-        for (size_t i = 0; i < t.shape()[0]; ++i)
-            for (size_t j = 0; j < t.shape()[1]; ++j)
-                t(i, j) = static_cast<T>((rand() / (T)RAND_MAX - 0.5) * 0.2);
+    utec::algebra::Tensor<T, 2> batch_input_;  ///< Entrada reutilizada por act_batch
+    utils::Xoshiro256 rng_;                    ///< Generador propio de la exploración
+
+    /// @brief Inicializador aleatorio de pesos, uniforme en [-0.1, 0.1).
+    /// El generador lo pasa quien construye la red: reproducible y seguro entre hilos.
+    static void initialize_weights(utec::algebra::Tensor<T, 2>& t, utils::Xoshiro256& rng) {
+        for (size_t i = 0; i < t.size(); ++i)
+            t[i] = static_cast<T>(rng.uniform(-0.1f, 0.1f));
     }
 
     /// @brief Inicializa con ceros (para bias).
@@ -75,15 +163,38 @@ private:
     }
 
 public:
+    /// @brief Construye Dense(3, hidden) -> ReLU -> Dense(hidden, 3) con pesos aleatorios.
+    /// Con `seed` == 0 se toma una semilla nueva en cada llamada.
+    static std::unique_ptr<Sequential> build_sequential(size_t hidden, unsigned seed) {
+        utils::Xoshiro256 rng(seed != 0 ? seed : utils::next_stream_seed());
+        auto init = [&rng](utec::algebra::Tensor<T, 2>& t) { initialize_weights(t, rng); };
+        auto capa1 = std::make_unique<utec::neural_network::Dense<T>>(3, hidden, init, initialize_zeros);
+        auto capa2 = std::make_unique<utec::neural_network::Dense<T>>(hidden, 3, init, initialize_zeros);
+        auto relu = std::make_unique<utec::neural_network::ReLU<T>>();
+        return std::make_unique<Sequential>(std::move(capa1), std::move(relu), std::move(capa2));
+    }
+
+    /// @brief Crea el optimizador pedido por la configuración.
+    static std::unique_ptr<utec::neural_network::IOptimizer<T>> make_optimizer(OptimizerKind kind, T lr) {
+        if (kind == OptimizerKind::Adam)
+            return std::make_unique<utec::neural_network::Adam<T>>(lr);
+        return std::make_unique<utec::neural_network::SGD<T>>(lr);
+    }
+
     /// @brief Constructor que recibe un modelo entrenado.
-    explicit PongAgent(std::unique_ptr<utec::neural_network::ILayer<T>> m)
-        : model_(std::move(m)) {}
+    /// @param seed Semilla de la exploración epsilon-greedy (por defecto, una distinta por agente)
+    explicit PongAgent(std::unique_ptr<utec::neural_network::ILayer<T>> m,
+                       std::uint64_t seed = utils::next_stream_seed())
+        : model_(std::move(m)), rng_(seed) {}
+
+    /// @brief Reinicia el generador de exploración (para repetir exactamente una partida)
+    void seed(std::uint64_t seed) { rng_.seed(seed); }
 
     /// @brief Decide una acción dada un estado.
     /// Si `epsilon` > 0, permite exploración aleatoria (exploración epsilon-greedy).
     int act(const State& s, float epsilon = 0.1f) {
-        if ((float)rand() / RAND_MAX < epsilon) {
-            return (rand() % 3) - 1;
+        if (rng_.uniform01() < epsilon) {
+            return static_cast<int>(rng_.below(3)) - 1;
         }
 
         utec::algebra::Tensor<T, 2> input(1, 3);
@@ -92,16 +203,22 @@ public:
         input(0, 2) = s.paddle_y;
 
         utec::algebra::Tensor<T, 2> output = model_->forward(input);
+        return select_action(output.data(), output.shape()[1]);
+    }
 
-        T max_val = output(0, 0);
+    /// @brief Acción greedy a partir de una fila de salidas de la red.
+    /// Índice del máximo menos 1; si un valor posterior empata con el máximo vigente
+    /// se devuelve 0 (quedarse).
+    static int select_action(const T* row, size_t n) {
+        T max_val = row[0];
         int max_idx = 0;
         bool tie = false;
-        for (size_t j = 1; j < output.shape()[1]; ++j) {
-            if (output(0, j) > max_val) {
-                max_val = output(0, j);
+        for (size_t j = 1; j < n; ++j) {
+            if (row[j] > max_val) {
+                max_val = row[j];
                 max_idx = j;
                 tie = false;
-            } else if (output(0, j) == max_val) {
+            } else if (row[j] == max_val) {
                 tie = true;
             }
         }
@@ -109,9 +226,81 @@ public:
         return tie ? 0 : max_idx - 1;
     }
 
+    /// @brief Decide acciones para muchos estados con un solo forward.
+    /// Empaqueta los N estados en una matriz N x 3, ejecuta un único forward y aplica el
+    /// argmax por filas con la misma regla de empates que act().
+    /// @param states Estados a evaluar
+    /// @param actions Destino de las acciones (mismo tamaño que `states`)
+    void act_batch(std::span<const State> states, std::span<int> actions) {
+        if (actions.size() != states.size())
+            throw std::invalid_argument("act_batch: states y actions deben tener el mismo tamaño");
+        if (states.empty()) return;
+
+        const size_t n = states.size();
+        if (batch_input_.shape()[0] != n) batch_input_ = utec::algebra::Tensor<T, 2>(n, 3);
+        T* in = batch_input_.data();
+        for (size_t i = 0; i < n; ++i) {
+            in[i * 3 + 0] = states[i].ball_x;
+            in[i * 3 + 1] = states[i].ball_y;
+            in[i * 3 + 2] = states[i].paddle_y;
+        }
+
+        auto output = model_->forward(batch_input_);
+        select_actions(output.data(), n, output.shape()[1], actions.data());
+    }
+
+    /// @brief Igual que act_batch(states, actions) con exploración epsilon-greedy.
+    /// El generador lo pasa quien llama (uno por hilo, por ejemplo `rng.fork()`).
+    void act_batch(std::span<const State> states, std::span<int> actions, float epsilon, utils::Xoshiro256& rng) {
+        act_batch(states, actions);
+        if (epsilon <= 0) return;
+
+        for (auto& a : actions) {
+            if (rng.uniform01() < epsilon) a = static_cast<int>(rng.below(3)) - 1;
+        }
+    }
+
+    /// @brief act_batch con exploración usando el generador propio del agente.
+    void act_batch(std::span<const State> states, std::span<int> actions, float epsilon) {
+        act_batch(states, actions, epsilon, rng_);
+    }
+
+    /// @brief Argmax por filas de una matriz de salidas (rows x n), con la regla de select_action().
+    /// Para n == 3 (el caso de Pong) el bucle no tiene saltos y el compilador puede vectorizarlo.
+    static void select_actions(const T* out, size_t rows, size_t n, int* actions) {
+        if (n != 3) {
+            for (size_t i = 0; i < rows; ++i) actions[i] = select_action(out + i * n, n);
+            return;
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            const T a = out[i * 3], b = out[i * 3 + 1], c = out[i * 3 + 2];
+            const bool b_gt = b > a;
+            const T m1 = b_gt ? b : a;
+            const int i1 = b_gt ? 1 : 0;
+            const bool t1 = b == a;
+            const bool c_gt = c > m1;
+            const int i2 = c_gt ? 2 : i1;
+            const bool tie = !c_gt && (t1 || c == m1);
+            actions[i] = tie ? 0 : i2 - 1;
+        }
+    }
+
+    /// @brief Acción greedy de un modelo cualquiera (sin exploración).
+    static int greedy_action(utec::neural_network::ILayer<T>& model, const State& s) {
+        utec::algebra::Tensor<T, 2> input(1, 3);
+        input(0, 0) = s.ball_x;
+        input(0, 1) = s.ball_y;
+        input(0, 2) = s.paddle_y;
+        auto output = model.forward(input);
+        return select_action(output.data(), output.shape()[1]);
+    }
+
     /// @brief Obtiene el modelo completo (puntero).
     utec::neural_network::ILayer<T>* get_model() { return model_.get(); }
 
+    /// @brief Reemplaza el modelo (por ejemplo, por uno recargado); la exploración sigue igual.
+    void set_model(std::unique_ptr<utec::neural_network::ILayer<T>> m) { model_ = std::move(m); }
+
     /// @brief Accede a la primera capa densa si existe.
     utec::neural_network::Dense<T>* get_dense1() {
         auto* seq = dynamic_cast<Sequential*>(model_.get());
@@ -124,104 +313,346 @@ public:
         return seq ? seq->l2.get() : nullptr;
     }
 
-    /// @brief Carga datos de entrenamiento desde un archivo CSV.
+    /// @brief Carga datos de entrenamiento desde un archivo CSV (ver load_pong_csv).
+    /// Si el archivo no se puede abrir informa el error y devuelve un vector vacío; una fila
+    /// mal formada lanza std::runtime_error con el número de línea.
     static std::vector<PongSample> load_training_data(const std::string& filename) {
-        std::vector<PongSample> data;
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "No se pudo abrir el archivo: " << filename << std::endl;
-            return data;
+        std::optional<utils::MappedFile> file;
+        try {
+            file.emplace(filename);
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return {};
         }
+        return load_pong_csv(*file, {}, filename).samples;
+    }
 
-        std::string line;
-        std::getline(file, line); // Saltar encabezado
+    /// @brief Entrena un modelo secuencial sobre muestras ya cargadas.
+    /// `data` solo se lee, así que varios entrenamientos pueden compartirlo entre hilos.
+    /// @param data Muestras de entrenamiento
+    /// @param cfg Hiperparámetros (capa oculta, optimizador, lote, épocas, semilla)
+    /// @param telemetry Telemetría opcional (tiempos por capa, muestras/s, pérdida por época)
+    /// @param on_epoch Se llama al final de cada época con la pérdida promedio; si devuelve
+    ///        false el entrenamiento se detiene
+    /// @return Modelo entrenado
+    static std::unique_ptr<utec::neural_network::ILayer<T>> train_from_samples(
+        const std::vector<PongSample>& data, const TrainConfig<T>& cfg,
+        utec::neural_network::TrainingTelemetry* telemetry = nullptr,
+        const EpochCallback& on_epoch = {}) {
+
+        return train_batches(cfg, telemetry, on_epoch, IndexedRows{data.size(), [&](size_t row) {
+            const auto& sample = data[row];
+            return BatchRow{sample.ball_x, sample.ball_y, sample.paddle_y, sample.action};
+        }});
+    }
 
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            std::stringstream ss(line);
-            PongSample sample;
-            std::string val;
+    /// @brief Entrena sobre un conjunto de datos por columnas proyectado en memoria.
+    /// Los lotes se arman leyendo directamente las vistas de las columnas, sin pasar por
+    /// PongSample; mismo resultado que train_from_samples(columns.samples(), ...).
+    static std::unique_ptr<utec::neural_network::ILayer<T>> train_from_columns(
+        const PongColumns& columns, const TrainConfig<T>& cfg,
+        utec::neural_network::TrainingTelemetry* telemetry = nullptr,
+        const EpochCallback& on_epoch = {}) {
+
+        const auto ball_x = columns.ball_x();
+        const auto ball_y = columns.ball_y();
+        const auto paddle_y = columns.paddle_y();
+        const auto action = columns.action();
+        return train_batches(cfg, telemetry, on_epoch, IndexedRows{columns.rows(), [&](size_t row) {
+            return BatchRow{ball_x[row], ball_y[row], paddle_y[row], action[row]};
+        }});
+    }
 
-            std::getline(ss, val, ','); sample.ball_x = std::stof(val);
-            std::getline(ss, val, ','); sample.ball_y = std::stof(val);
-            std::getline(ss, val, ','); sample.ball_vx = std::stof(val);
-            std::getline(ss, val, ','); sample.ball_vy = std::stof(val);
-            std::getline(ss, val, ','); sample.paddle_y = std::stof(val);
-            std::getline(ss, val, ','); sample.action = std::stoi(val);
-            std::getline(ss, val, ','); sample.reward = std::stof(val);
+    /// @brief Entrena sobre un conjunto ya preparado (ver PreparedDataset.h). Cada lote copia un
+    /// tramo contiguo de entradas y objetivos; las filas fusionadas pesan lo que sus repeticiones.
+    /// Sin fusión da los mismos pesos que train_from_samples con las mismas muestras.
+    static std::unique_ptr<utec::neural_network::ILayer<T>> train_from_prepared(
+        const PreparedDataset<T>& data, const TrainConfig<T>& cfg,
+        utec::neural_network::TrainingTelemetry* telemetry = nullptr,
+        const EpochCallback& on_epoch = {}) {
 
-            data.push_back(sample);
-        }
-        return data;
+        return train_batches(cfg, telemetry, on_epoch, PreparedRows{data});
     }
 
-    /// @brief Entrena un modelo secuencial a partir de un CSV.
-    /// @param csv_path Ruta del archivo CSV
-    /// @param epochs Número de épocas de entrenamiento
-    /// @param lr Tasa de aprendizaje
-    /// @return Modelo entrenado
-    static std::unique_ptr<utec::neural_network::ILayer<T>> train_from_csv(
-        const std::string& csv_path, int epochs = 100, T lr = 0.01) {
+    /// @brief Entrena leyendo un flujo por bloques (ver SampleStream.h): cada época rebobina el
+    /// flujo y consume una pasada completa, con memoria constante sin importar el tamaño de los datos.
+    static std::unique_ptr<utec::neural_network::ILayer<T>> train_from_stream(
+        SampleStream& stream, const TrainConfig<T>& cfg,
+        utec::neural_network::TrainingTelemetry* telemetry = nullptr,
+        const EpochCallback& on_epoch = {}) {
 
-        auto data = load_training_data(csv_path);
+        return train_batches(cfg, telemetry, on_epoch, StreamRows{stream, {}});
+    }
 
-        auto capa1 = std::make_unique<utec::neural_network::Dense<T>>(3, 8, initialize_weights, initialize_zeros);
-        auto relu = std::make_unique<utec::neural_network::ReLU<T>>();
-        auto capa2 = std::make_unique<utec::neural_network::Dense<T>>(8, 3, initialize_weights, initialize_zeros);
+private:
+    /// @brief Entrada y etiqueta de una fila, leídas de la fuente de datos
+    struct BatchRow {
+        float ball_x, ball_y, paddle_y;
+        int action;
+    };
+
+    /// @brief Lote listo para la red
+    struct Batch {
+        utec::algebra::Tensor<T, 2> input{0, 3};
+        utec::algebra::Tensor<T, 2> target{0, 3};
+        const T* weight = nullptr;   ///< Peso de cada fila; nullptr = todas pesan 1
+
+        /// @brief Deja input y target con `rows` filas (reutiliza la memoria si ya la tienen)
+        void resize(size_t rows) {
+            if (input.shape()[0] == rows) return;
+            input = utec::algebra::Tensor<T, 2>(rows, 3);
+            target = utec::algebra::Tensor<T, 2>(rows, 3);
+        }
 
-        auto model = std::make_unique<Sequential>(std::move(capa1), std::move(relu), std::move(capa2));
-        utec::neural_network::SGD<T> optimizer(lr * 0.1);
+        /// @brief Arma entradas y objetivos one-hot a partir de filas sueltas
+        void pack(std::span<const BatchRow> rows) {
+            resize(rows.size());
+            weight = nullptr;
+            for (size_t r = 0; r < rows.size(); ++r) {
+                const BatchRow& sample = rows[r];
+                input(r, 0) = sample.ball_x;
+                input(r, 1) = sample.ball_y;
+                input(r, 2) = sample.paddle_y;
+                target(r, 0) = (sample.action == -1) ? 1 : 0;
+                target(r, 1) = (sample.action == 0) ? 1 : 0;
+                target(r, 2) = (sample.action == 1) ? 1 : 0;
+            }
+        }
+    };
 
-        for (int epoch = 0; epoch < epochs; ++epoch) {
+    /// @brief Filas indexadas (datos en memoria o proyectados): `row_at(i)` devuelve la fila i
+    template <typename RowAt>
+    struct IndexedRows {
+        size_t rows;
+        RowAt row_at;
+        size_t next = 0;
+        std::vector<BatchRow> scratch{};
+
+        void rewind() { next = 0; }
+        FeatureStats<3> input_stats() {
+            return feature_stats<3>(rows, [this](size_t i, std::array<double, 3>& x) {
+                const BatchRow r = row_at(i);
+                x = {r.ball_x, r.ball_y, r.paddle_y};
+                return 1.0;
+            });
+        }
+        size_t fill(size_t max_rows, Batch& batch) {
+            const size_t n = std::min(max_rows, rows - next);
+            scratch.resize(n);
+            for (size_t r = 0; r < n; ++r) scratch[r] = row_at(next + r);
+            next += n;
+            if (n) batch.pack(scratch);
+            return n;
+        }
+    };
+
+    /// @brief Filas leídas de un SampleStream
+    struct StreamRows {
+        SampleStream& stream;
+        std::vector<PongSample> samples{};
+        std::vector<BatchRow> scratch{};
+
+        void rewind() { stream.reset(); }
+        /// @brief Una pasada por el flujo, de a bloques; cada bloque se procesa en paralelo
+        FeatureStats<3> input_stats() {
+            FeatureStats<3> total;
+            stream.reset();
+            samples.resize(STATS_BLOCK_ROWS * 4);
+            while (const size_t n = stream.next_batch(std::span<PongSample>(samples)))
+                total.merge(feature_stats<3>(n, [this](size_t i, std::array<double, 3>& x) {
+                    x = {samples[i].ball_x, samples[i].ball_y, samples[i].paddle_y};
+                    return 1.0;
+                }));
+            stream.reset();
+            return total;
+        }
+        size_t fill(size_t max_rows, Batch& batch) {
+            samples.resize(max_rows);
+            const size_t n = stream.next_batch(std::span<PongSample>(samples));
+            scratch.resize(n);
+            for (size_t r = 0; r < n; ++r)
+                scratch[r] = BatchRow{samples[r].ball_x, samples[r].ball_y, samples[r].paddle_y, samples[r].action};
+            if (n) batch.pack(scratch);
+            return n;
+        }
+    };
+
+    /// @brief Filas de un PreparedDataset: cada lote es una copia de filas consecutivas
+    struct PreparedRows {
+        const PreparedDataset<T>& data;
+        size_t next = 0;
+
+        void rewind() { next = 0; }
+        /// @brief Cada fila fusionada cuenta tantas veces como sus repeticiones
+        FeatureStats<3> input_stats() {
+            return feature_stats<3>(data.rows(), [this](size_t i, std::array<double, 3>& x) {
+                x = {data.inputs(i, 0), data.inputs(i, 1), data.inputs(i, 2)};
+                return static_cast<double>(data.weights[i]);
+            });
+        }
+        size_t fill(size_t max_rows, Batch& batch) {
+            const size_t n = std::min(max_rows, data.rows() - next);
+            if (n == 0) return 0;
+            batch.resize(n);
+            std::copy_n(data.inputs.data() + next * 3, n * 3, batch.input.data());
+            std::copy_n(data.targets.data() + next * 3, n * 3, batch.target.data());
+            batch.weight = data.weights.data() + next;
+            next += n;
+            return n;
+        }
+    };
+
+    /// @brief Bucle de entrenamiento por lotes. Cada época llama `rows.rewind()` y pide lotes
+    /// con `rows.fill(tamaño, lote)` hasta que devuelve 0. Cada fila aporta su gradiente
+    /// multiplicado por su peso (1 si la fuente no da pesos) y el lote se promedia por cantidad
+    /// de filas: una época sobre filas fusionadas suma lo mismo que sobre las filas repetidas.
+    /// Con `cfg.normalize_inputs` una pasada previa (`rows.input_stats()`) da media y desvío, cada
+    /// lote se estandariza y al final la normalización se pliega en l1; `on_epoch` recibe una
+    /// copia ya plegada, así que también puede evaluar el modelo con entradas crudas.
+    template <typename Rows>
+    static std::unique_ptr<utec::neural_network::ILayer<T>> train_batches(
+        const TrainConfig<T>& cfg, utec::neural_network::TrainingTelemetry* telemetry,
+        const EpochCallback& on_epoch, Rows rows_source) {
+
+        auto model = build_sequential(cfg.hidden_size, cfg.seed);
+        auto optimizer = make_optimizer(cfg.optimizer, cfg.learning_rate);
+        const size_t batch_size = std::max<size_t>(1, cfg.batch_size);
+
+        model->telemetry = telemetry;
+        model->set_requires_input_grad(false);  // el gradiente de la entrada no se usa
+        if (telemetry) telemetry->begin_run("PongAgent::train_from_csv", model->layer_names());
+
+        std::optional<InputNormalization<T>> norm;
+        if (cfg.normalize_inputs) norm = InputNormalization<T>::from_stats(rows_source.input_stats());
+
+        Batch batch;
+        for (int epoch = 0; epoch < cfg.epochs; ++epoch) {
             T total_loss = 0;
-            for (const auto& sample : data) {
-                utec::algebra::Tensor<T, 2> input(1, 3);
-                input(0, 0) = sample.ball_x;
-                input(0, 1) = sample.ball_y;
-                input(0, 2) = sample.paddle_y;
-
-                utec::algebra::Tensor<T, 2> target(1, 3);
-                target(0, 0) = (sample.action == -1) ? 1 : 0;
-                target(0, 1) = (sample.action == 0) ? 1 : 0;
-                target(0, 2) = (sample.action == 1) ? 1 : 0;
-
-                auto output = model->forward(input);
-
-                utec::algebra::Tensor<T, 2> grad(1, 3);
-                T loss = 0;
-                for (int i = 0; i < 3; ++i) {
-                    grad(0, i) = 2 * (output(0, i) - target(0, i));
-                    loss += (output(0, i) - target(0, i)) * (output(0, i) - target(0, i));
+            double total_weight = 0;
+            if (telemetry) telemetry->begin_epoch(epoch);
+            rows_source.rewind();
+            while (true) {
+                if (telemetry) telemetry->begin_step();
+                const size_t rows = rows_source.fill(batch_size, batch);
+                if (rows == 0) break;
+                if (norm) norm->apply(batch.input);
+
+                auto output = model->forward(batch.input);
+
+                // Gradiente de la MSE por muestra, por el peso de la fila y promediado sobre el lote
+                total_weight += batch.weight ? std::accumulate(batch.weight, batch.weight + rows, 0.0)
+                                             : static_cast<double>(rows);
+
+                utec::algebra::Tensor<T, 2> grad(rows, 3);
+                for (size_t r = 0; r < rows; ++r) {
+                    const T w = batch.weight ? batch.weight[r] : T(1);
+                    T loss = 0;
+                    for (int i = 0; i < 3; ++i) {
+                        T diff = output(r, i) - batch.target(r, i);
+                        grad(r, i) = 2 * diff * w / static_cast<T>(rows);
+                        loss += diff * diff;
+                    }
+                    total_loss += w * loss / 3.0;
                 }
-                total_loss += loss / 3.0;
 
                 model->backward(grad);
-                model->update_params(optimizer);
+                model->update_params(*optimizer);
+                if (telemetry) telemetry->end_step(rows);
+            }
+            const T epoch_loss = total_loss / static_cast<T>(total_weight);
+            if (telemetry) telemetry->end_epoch(epoch_loss);
+
+            if (cfg.verbose && epoch % 10 == 0) {
+                std::cout << "Epoch " << epoch << ", Loss: " << epoch_loss << "\n";
+                std::cout << "Primeros pesos de la capa 1: ";
+                for (int i = 0; i < 3; ++i)
+                    std::cout << model->l1->weights()(i, 0) << " ";
+                std::cout << std::endl;
             }
 
-            if (epoch % 10 == 0) {
-                auto* seq = dynamic_cast<Sequential*>(model.get());
-                std::cout << "Epoch " << epoch << ", Loss: " << total_loss / data.size() << "\n";
-
-                if (seq && seq->l1) {
-                    std::cout << "Primeros pesos de la capa 1: ";
-                    for (int i = 0; i < 3; ++i)
-                        std::cout << seq->l1->weights()(i, 0) << " ";
-                    std::cout << std::endl;
+            if (on_epoch) {
+                if (!norm) {
+                    if (!on_epoch(epoch, epoch_loss, *model)) break;
+                    continue;
                 }
+                Sequential folded(norm->folded(*model->l1), std::make_unique<utec::neural_network::ReLU<T>>(),
+                                  std::make_unique<utec::neural_network::Dense<T>>(*model->l2));
+                if (!on_epoch(epoch, epoch_loss, folded)) break;
             }
         }
 
+        if (norm) norm->fold_into(*model->l1);
+        if (telemetry) telemetry->end_run();
+        model->telemetry = nullptr;
         return model;
     }
 
+public:
+    /// @brief Entrena un modelo secuencial a partir de un CSV.
+    /// Si el archivo está en el formato binario por columnas (ver ColumnarDataset.h) se proyecta
+    /// en memoria y se entrena sobre sus columnas sin parsear nada; si es una grabación de
+    /// SessionRecorder se leen sus pasos. Un CSV de más de `stream_above_bytes` no se carga
+    /// entero: se lee por bloques con un SampleStream. Las entradas se estandarizan durante el
+    /// entrenamiento y el modelo devuelto ya tiene la normalización plegada en su primera capa.
+    /// @param csv_path Ruta del archivo CSV, binario o grabación
+    /// @param epochs Número de épocas de entrenamiento
+    /// @param lr Tasa de aprendizaje
+    /// @param telemetry Telemetría opcional (tiempos por capa, muestras/s, pérdida por época)
+    /// @param stream_above_bytes Tamaño desde el cual el CSV se lee por bloques
+    /// @param prepare Preparación de un CSV o grabación en memoria; la fusión de filas repetidas
+    ///        (`merge_duplicates`) cambia el paso por lote, así que solo se usa si se pide
+    /// @return Modelo entrenado
+    static std::unique_ptr<utec::neural_network::ILayer<T>> train_from_csv(
+        const std::string& csv_path, int epochs = 100, T lr = 0.01,
+        utec::neural_network::TrainingTelemetry* telemetry = nullptr,
+        std::uintmax_t stream_above_bytes = std::uintmax_t{1} << 30, const PrepareOptions& prepare = {}) {
+
+        TrainConfig<T> cfg;
+        cfg.learning_rate = lr * 0.1;
+        cfg.epochs = epochs;
+        cfg.verbose = true;
+        cfg.normalize_inputs = true;
+
+        if (is_columnar_file(csv_path)) return train_from_columns(PongColumns(csv_path), cfg, telemetry);
+        std::error_code ec;
+        const auto bytes = std::filesystem::file_size(csv_path, ec);
+        if (!ec && bytes > stream_above_bytes) {
+            SampleStream stream(std::make_unique<CsvSampleSource>(csv_path));
+            return train_from_stream(stream, cfg, telemetry);
+        }
+        if (ec) {
+            std::cerr << "No se pudo abrir el archivo: " << csv_path << std::endl;
+            return train_from_samples({}, cfg, telemetry);
+        }
+        const auto data = prepare_dataset_file<T>(csv_path, prepare);
+        if (cfg.verbose && (prepare.merge_duplicates || data.from_cache)) {
+            std::cout << data.source_rows << " filas";
+            if (prepare.merge_duplicates)
+                std::cout << " -> " << data.rows() << " estados distintos (" << data.conflicts
+                          << " con acciones en conflicto)";
+            std::cout << (data.from_cache ? ", preparadas desde la cache" : "") << "\n";
+        }
+        return train_from_prepared(data, cfg, telemetry);
+    }
+
     /// @brief Crea una red secuencial cargando pesos desde archivos.
+    /// El tamaño de la capa oculta se toma de la cabecera del primer archivo (3 x oculta) y
+    /// la del segundo debe coincidir (oculta x 3).
     static std::unique_ptr<utec::neural_network::ILayer<T>> create_sequential_with_weights(
         const std::string& weights1, const std::string& weights2) {
 
-        auto l1 = std::make_unique<utec::neural_network::Dense<T>>(3, 8, [](auto& t) { t.fill(0.01); });
+        size_t inputs = 0, hidden = 0;
+        std::ifstream header(weights1);
+        if (!(header >> inputs >> hidden) || inputs != 3 || hidden == 0)
+            throw std::runtime_error("Cabecera invalida en el archivo de pesos: " + weights1);
+        size_t hidden2 = 0, outputs = 0;
+        std::ifstream header2(weights2);
+        if (!(header2 >> hidden2 >> outputs) || hidden2 != hidden || outputs != 3)
+            throw std::runtime_error("Cabecera invalida en el archivo de pesos: " + weights2);
+
+        auto l1 = std::make_unique<utec::neural_network::Dense<T>>(3, hidden, [](auto& t) { t.fill(0.01); });
         auto act = std::make_unique<utec::neural_network::ReLU<T>>();
-        auto l2 = std::make_unique<utec::neural_network::Dense<T>>(8, 3, [](auto& t) { t.fill(0.01); });
+        auto l2 = std::make_unique<utec::neural_network::Dense<T>>(hidden, 3, [](auto& t) { t.fill(0.01); });
 
         l1->load_weights(weights1);
         l2->load_weights(weights2);
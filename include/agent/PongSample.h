@@ -0,0 +1,16 @@
+#pragma once
+#ifndef PONG_SAMPLE_H
+#define PONG_SAMPLE_H
+
+namespace utec::nn {
+
+/// @brief Representa un ejemplo de entrenamiento para Pong.
+struct PongSample {
+    float ball_x, ball_y, ball_vx, ball_vy, paddle_y;
+    int action;     ///< Acción tomada en ese estado (-1, 0, 1)
+    float reward;   ///< Recompensa obtenida por esa acción
+};
+
+} // namespace utec::nn
+
+#endif // PONG_SAMPLE_H
@@ -0,0 +1,281 @@
+#pragma once
+#ifndef PREPARED_DATASET_H
+#define PREPARED_DATASET_H
+
+/**
+ * @file PreparedDataset.h
+ * @brief Conjunto de entrenamiento ya convertido a tensores, con fusión de estados repetidos
+ *        y caché en disco.
+ *
+ * Las muestras (CSV, binario por columnas o grabación) se convierten una sola vez a dos
+ * tensores contiguos de n x 3: entradas (ball_x, ball_y, paddle_y) y objetivos one-hot
+ * (acción -1, 0, 1). Cada lote de entrenamiento es entonces un tramo de filas consecutivas.
+ *
+ * Con `merge_duplicates` (desactivado por defecto), las filas con la misma entrada se fusionan
+ * en una: su objetivo es la frecuencia de cada acción y su peso la cantidad de filas originales.
+ * Con la MSE, w filas iguales suman el mismo gradiente que una fila con peso w y objetivo
+ * promedio, pero el paso por lote cambia (hay menos filas por época), así que se pide a propósito.
+ *
+ * La caché guarda el resultado junto al origen (`<origen>.<clave>.prep`). La clave es un hash
+ * del contenido del origen combinado con las opciones y el tipo de los tensores; si el origen
+ * cambia la clave cambia, así que una caché vieja nunca se usa por error. Al escribir una caché
+ * se borran solo las anteriores del mismo origen con las mismas opciones y tipo; las de otras
+ * opciones siguen valiendo.
+ */
+
+#include "ColumnarDataset.h"
+#include "CsvLoader.h"
+#include "PongSample.h"
+#include "SessionRecorder.h"
+#include "../algebra/tensor.h"
+#include "../utils/hash.h"
+#include "../utils/mapped_file.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Opciones de preparación.
+struct PrepareOptions {
+    bool merge_duplicates = false;  ///< Fusionar filas con la misma entrada (objetivo = frecuencias)
+    bool use_cache = true;          ///< Leer y escribir `<origen>.<clave>.prep`
+};
+
+/// @brief Entradas, objetivos y pesos listos para entrenar.
+template <typename T>
+struct PreparedDataset {
+    utec::algebra::Tensor<T, 2> inputs{0, 3};    ///< n x 3: ball_x, ball_y, paddle_y
+    utec::algebra::Tensor<T, 2> targets{0, 3};   ///< n x 3: acción -1, 0, 1 (one-hot o frecuencias)
+    std::vector<T> weights;                      ///< Filas originales que representa cada fila
+    std::uint64_t source_rows = 0;               ///< Filas del origen
+    std::uint64_t conflicts = 0;                 ///< Entradas repetidas con acciones distintas
+    std::uint64_t source_hash = 0;               ///< Hash del contenido del origen (0 si vino de memoria)
+    bool from_cache = false;                     ///< Se leyó de la caché en vez de prepararse
+
+    std::size_t rows() const noexcept { return weights.size(); }
+};
+
+/// @brief Convierte muestras a tensores, fusionando repeticiones si se pide.
+/// Las acciones fuera de {-1, 0, 1} dejan el objetivo en cero (como el armado por lotes).
+template <typename T>
+PreparedDataset<T> prepare_dataset(std::span<const PongSample> samples, const PrepareOptions& opts = {}) {
+    PreparedDataset<T> out;
+    out.source_rows = samples.size();
+
+    auto label = [](int action) { return action >= -1 && action <= 1 ? action + 1 : -1; };
+
+    if (!opts.merge_duplicates) {
+        out.inputs = utec::algebra::Tensor<T, 2>(samples.size(), 3);
+        out.targets = utec::algebra::Tensor<T, 2>(samples.size(), 3);
+        out.targets.fill(0);
+        out.weights.assign(samples.size(), T(1));
+        for (std::size_t r = 0; r < samples.size(); ++r) {
+            const auto& s = samples[r];
+            out.inputs(r, 0) = s.ball_x;
+            out.inputs(r, 1) = s.ball_y;
+            out.inputs(r, 2) = s.paddle_y;
+            if (const int k = label(s.action); k >= 0) out.targets(r, k) = 1;
+        }
+        return out;
+    }
+
+    // Entradas únicas en orden de primera aparición, con la cuenta de cada acción
+    using Key = std::array<std::uint32_t, 3>;
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const noexcept {
+            return utils::mix64((std::uint64_t{k[0]} << 32 | k[1]) ^ utils::mix64(k[2]));
+        }
+    };
+    auto bits = [](float v) { return std::bit_cast<std::uint32_t>(v + 0.0f); };  // -0 y +0 son la misma entrada
+
+    std::unordered_map<Key, std::uint32_t, KeyHash> index;
+    index.reserve(samples.size());
+    std::vector<const PongSample*> first;
+    std::vector<std::array<std::uint32_t, 4>> counts;   // acción -1, 0, 1, otra
+    for (const auto& s : samples) {
+        const auto [it, inserted] =
+            index.try_emplace(Key{bits(s.ball_x), bits(s.ball_y), bits(s.paddle_y)}, static_cast<std::uint32_t>(first.size()));
+        if (inserted) {
+            first.push_back(&s);
+            counts.push_back({});
+        }
+        const int k = label(s.action);
+        ++counts[it->second][k >= 0 ? k : 3];
+    }
+
+    const std::size_t n = first.size();
+    out.inputs = utec::algebra::Tensor<T, 2>(n, 3);
+    out.targets = utec::algebra::Tensor<T, 2>(n, 3);
+    out.weights.resize(n);
+    for (std::size_t r = 0; r < n; ++r) {
+        const auto& c = counts[r];
+        const std::uint32_t total = c[0] + c[1] + c[2] + c[3];
+        out.inputs(r, 0) = first[r]->ball_x;
+        out.inputs(r, 1) = first[r]->ball_y;
+        out.inputs(r, 2) = first[r]->paddle_y;
+        for (int k = 0; k < 3; ++k) out.targets(r, k) = static_cast<T>(c[k]) / static_cast<T>(total);
+        out.weights[r] = static_cast<T>(total);
+        out.conflicts += (c[0] > 0) + (c[1] > 0) + (c[2] > 0) + (c[3] > 0) > 1;
+    }
+    return out;
+}
+
+namespace prepared_detail {
+
+/// @brief Cabecera del archivo de caché; la siguen entradas, objetivos y pesos (rows x 3, rows x 3, rows)
+struct Header {
+    char magic[8];                 ///< "PONGPRE1"
+    std::uint32_t version;
+    std::uint32_t element_size;    ///< sizeof(T)
+    std::uint64_t rows;
+    std::uint64_t source_rows;
+    std::uint64_t conflicts;
+    std::uint64_t source_hash;
+    std::uint32_t merged;
+    std::uint32_t reserved;
+    std::uint64_t reserved2;
+};
+static_assert(sizeof(Header) == 64);
+
+inline constexpr char MAGIC[8] = {'P', 'O', 'N', 'G', 'P', 'R', 'E', '1'};
+inline constexpr std::uint32_t VERSION = 1;
+
+/// @brief Clave de la caché: contenido del origen + todo lo que cambia el resultado
+template <typename T>
+std::uint64_t cache_key(std::uint64_t source_hash, const PrepareOptions& opts) {
+    return utils::mix64(source_hash ^ utils::mix64((std::uint64_t{VERSION} << 16) | (sizeof(T) << 1) | opts.merge_duplicates));
+}
+
+inline std::string cache_path(const std::string& source, std::uint64_t key) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return source + "." + hex + ".prep";
+}
+
+/// @brief Lee la caché si existe y coincide con la clave; si no, devuelve false
+template <typename T>
+bool read_cache(const std::string& path, std::uint64_t source_hash, const PrepareOptions& opts, PreparedDataset<T>& out) {
+    std::ifstream in(path, std::ios::binary);
+    Header h{};
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION || h.element_size != sizeof(T)
+        || h.source_hash != source_hash || h.merged != static_cast<std::uint32_t>(opts.merge_duplicates))
+        return false;
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) != sizeof(Header) + h.rows * 7 * sizeof(T)) return false;
+
+    out.inputs = utec::algebra::Tensor<T, 2>(h.rows, 3);
+    out.targets = utec::algebra::Tensor<T, 2>(h.rows, 3);
+    out.weights.resize(h.rows);
+    in.read(reinterpret_cast<char*>(out.inputs.data()), static_cast<std::streamsize>(h.rows * 3 * sizeof(T)));
+    in.read(reinterpret_cast<char*>(out.targets.data()), static_cast<std::streamsize>(h.rows * 3 * sizeof(T)));
+    in.read(reinterpret_cast<char*>(out.weights.data()), static_cast<std::streamsize>(h.rows * sizeof(T)));
+    if (!in) return false;
+    out.source_rows = h.source_rows;
+    out.conflicts = h.conflicts;
+    out.source_hash = source_hash;
+    out.from_cache = true;
+    return true;
+}
+
+/// @brief true si `path` es una caché con las mismas opciones y tipo (de cualquier contenido)
+template <typename T>
+bool same_options(const std::filesystem::path& path, const PrepareOptions& opts) {
+    std::ifstream in(path, std::ios::binary);
+    Header h{};
+    return in.read(reinterpret_cast<char*>(&h), sizeof(h)) && std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0
+           && h.version == VERSION && h.element_size == sizeof(T)
+           && h.merged == static_cast<std::uint32_t>(opts.merge_duplicates);
+}
+
+/// @brief Escribe la caché en un temporal y la renombra, así nunca queda un archivo a medias.
+/// Borra las cachés anteriores del mismo origen con las mismas opciones (origen viejo).
+template <typename T>
+void write_cache(const std::string& source, const std::string& path, const PreparedDataset<T>& data,
+                 const PrepareOptions& opts) {
+    Header h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.element_size = sizeof(T);
+    h.rows = data.rows();
+    h.source_rows = data.source_rows;
+    h.conflicts = data.conflicts;
+    h.source_hash = data.source_hash;
+    h.merged = opts.merge_duplicates;
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;   // sin permiso de escritura: se entrena igual, sin caché
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(data.inputs.data()), static_cast<std::streamsize>(h.rows * 3 * sizeof(T)));
+        out.write(reinterpret_cast<const char*>(data.targets.data()), static_cast<std::streamsize>(h.rows * 3 * sizeof(T)));
+        out.write(reinterpret_cast<const char*>(data.weights.data()), static_cast<std::streamsize>(h.rows * sizeof(T)));
+        if (!out) {
+            out.close();
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    const auto src = std::filesystem::path(source);
+    const std::string prefix = src.filename().string() + ".";
+    const auto dir = src.has_parent_path() ? src.parent_path() : std::filesystem::path(".");
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() == prefix.size() + 21 && name.starts_with(prefix) && name.ends_with(".prep")
+            && entry.path() != std::filesystem::path(path) && same_options<T>(entry.path(), opts))
+            std::filesystem::remove(entry.path(), ec);
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) std::remove(tmp.c_str());
+}
+
+} // namespace prepared_detail
+
+/// @brief Prepara el archivo `path` (CSV, binario por columnas o grabación), usando la caché
+/// si su clave coincide. Con caché válida no se parsea ni se prepara nada: solo se recorre el
+/// origen para calcular su hash y se copian los tensores del archivo de caché.
+/// @throws std::runtime_error Si el origen no se puede leer o tiene filas mal formadas
+template <typename T>
+PreparedDataset<T> prepare_dataset_file(const std::string& path, const PrepareOptions& opts = {}) {
+    std::uint64_t source_hash = 0;
+    std::vector<PongSample> samples;
+    {
+        const utils::MappedFile file(path);
+        source_hash = utils::hash_bytes(file.data(), file.size());
+        if (opts.use_cache) {
+            PreparedDataset<T> cached;
+            if (prepared_detail::read_cache(prepared_detail::cache_path(path, prepared_detail::cache_key<T>(source_hash, opts)),
+                                            source_hash, opts, cached))
+                return cached;
+        }
+        const auto magic = file.view().substr(0, 8);
+        if (magic == std::string_view(COLUMNAR_MAGIC, 8)) samples = PongColumns(path).samples();
+        else if (magic == std::string_view(RECORDING_MAGIC, 8)) samples = load_pong_recording(path);
+        else samples = load_pong_csv(file, {}, path).samples;
+    }
+
+    auto data = prepare_dataset<T>(samples, opts);
+    data.source_hash = source_hash;
+    if (opts.use_cache)
+        prepared_detail::write_cache(path, prepared_detail::cache_path(path, prepared_detail::cache_key<T>(source_hash, opts)),
+                                     data, opts);
+    return data;
+}
+
+} // namespace utec::nn
+
+#endif // PREPARED_DATASET_H
@@ -0,0 +1,185 @@
+#pragma once
+#ifndef PRIORITIZED_REPLAY_H
+#define PRIORITIZED_REPLAY_H
+
+/**
+ * @file PrioritizedReplay.h
+ * @brief Memoria de repetición priorizada (PER) sobre un sum-tree en arreglo.
+ *
+ * Cada transición i se muestrea con probabilidad P(i) = p_i^α / Σ p^α, donde p_i = |δ_i| + ε
+ * es su último error TD. Las prioridades viven en un sum-tree implícito: el nodo k tiene hijos
+ * 2k y 2k+1, las hojas ocupan [capacidad, 2·capacidad) y cada nodo interno guarda la suma de
+ * sus hijos. Actualizar una prioridad y muestrear cuestan O(log N); un lote de K muestras
+ * estratificadas (ordenadas) se resuelve en un único recorrido que reparte los objetivos entre
+ * ramas, así los niveles superiores se visitan una sola vez. Las sumas son double para que no
+ * se acumule error con millones de transiciones (10M ocupan ~160 MB de árbol).
+ */
+
+#include "ReplayBuffer.h"
+#include "../utils/random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Árbol de sumas de tamaño fijo con hojas contiguas.
+class SumTree {
+public:
+    /// @throws std::invalid_argument Si la capacidad es 0
+    explicit SumTree(std::size_t capacity) : capacity_(capacity), nodes_(2 * capacity, 0.0) {
+        if (capacity == 0) throw std::invalid_argument("SumTree: la capacidad debe ser mayor que 0");
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /// @brief Suma de todas las prioridades
+    double total() const noexcept { return nodes_[1]; }
+
+    /// @brief Prioridad de la hoja `i`
+    double get(std::size_t i) const { return nodes_[capacity_ + i]; }
+
+    /// @brief Fija la prioridad de la hoja `i` y recalcula sus ancestros (O(log N))
+    void set(std::size_t i, double priority) {
+        std::size_t k = capacity_ + i;
+        nodes_[k] = priority;
+        // Se recalcula cada suma desde sus hijos (no se acumulan deltas, así no deriva)
+        for (k /= 2; k >= 1; k /= 2) nodes_[k] = nodes_[2 * k] + nodes_[2 * k + 1];
+    }
+
+    /// @brief Hoja cuyo intervalo acumulado contiene `target` (0 <= target < total()).
+    std::size_t find(double target) const {
+        std::size_t k = 1;
+        while (k < capacity_) k = descend(k, target);
+        return k - capacity_;
+    }
+
+    /// @brief Resuelve K objetivos ordenados de menor a mayor en un único recorrido.
+    /// En cada nodo, los objetivos menores que la suma izquierda bajan a la izquierda y el
+    /// resto (restándoles esa suma) a la derecha; los nodos compartidos se visitan una vez.
+    /// @param targets Objetivos ordenados; se modifican (quedan relativos a su hoja)
+    /// @param leaves Destino: hoja elegida para cada objetivo
+    void find_sorted(std::vector<double>& targets, std::vector<std::size_t>& leaves) const {
+        leaves.resize(targets.size());
+        if (targets.empty()) return;
+        stack_.clear();
+        stack_.push_back({1, 0, targets.size()});
+        while (!stack_.empty()) {
+            const Range r = stack_.back();
+            stack_.pop_back();
+            if (r.node >= capacity_) {
+                std::fill(leaves.begin() + r.begin, leaves.begin() + r.end, r.node - capacity_);
+                continue;
+            }
+            const double left = nodes_[2 * r.node];
+            const bool right_empty = nodes_[2 * r.node + 1] <= 0.0;
+            std::size_t split = r.begin;
+            while (split < r.end && (targets[split] < left || right_empty)) ++split;
+            for (std::size_t j = split; j < r.end; ++j) targets[j] -= left;
+            if (split < r.end) stack_.push_back({2 * r.node + 1, split, r.end});
+            if (r.begin < split) stack_.push_back({2 * r.node, r.begin, split});
+        }
+    }
+
+private:
+    struct Range {
+        std::size_t node, begin, end;
+    };
+
+    std::size_t capacity_;
+    std::vector<double> nodes_;          ///< nodes_[1] es la raíz; nodes_[0] no se usa
+    mutable std::vector<Range> stack_;   ///< Pila reutilizada por find_sorted
+
+    /// @brief Un paso de bajada: elige el hijo que contiene `target` (y lo ajusta)
+    std::size_t descend(std::size_t k, double& target) const {
+        const double left = nodes_[2 * k];
+        // Si por redondeo el objetivo cae más allá de una rama derecha vacía, se queda a la izquierda
+        if (target < left || nodes_[2 * k + 1] <= 0.0) return 2 * k;
+        target -= left;
+        return 2 * k + 1;
+    }
+};
+
+/// @brief Memoria de repetición priorizada: almacenamiento de ReplayBuffer + SumTree.
+template <typename T>
+class PrioritizedReplay {
+public:
+    /// @param capacity Transiciones máximas
+    /// @param alpha Cuánto pesa la prioridad (0 = uniforme, 1 = proporcional al error)
+    /// @param epsilon Se suma a |δ| para que ninguna transición quede con probabilidad 0
+    explicit PrioritizedReplay(std::size_t capacity, double alpha = 0.6, double epsilon = 1e-3)
+        : storage_(capacity), tree_(capacity), alpha_(alpha), epsilon_(epsilon) {}
+
+    std::size_t capacity() const noexcept { return storage_.capacity(); }
+    std::size_t size() const noexcept { return storage_.size(); }
+    bool empty() const noexcept { return storage_.empty(); }
+
+    /// @brief Almacenamiento de las transiciones
+    const ReplayBuffer<T>& storage() const noexcept { return storage_; }
+
+    /// @brief Árbol de prioridades (p^α por transición)
+    const SumTree& tree() const noexcept { return tree_; }
+
+    /// @brief Inserta con la prioridad máxima vista, para que toda transición nueva se use pronto
+    std::size_t push(const State& s, int action, T reward, const State& next, bool done) {
+        const std::size_t i = storage_.push(s, action, reward, next, done);
+        tree_.set(i, std::pow(max_priority_, alpha_));
+        return i;
+    }
+
+    /// @brief Muestrea `n` transiciones por estratos: el total se divide en n tramos iguales y
+    /// se elige un punto uniforme en cada uno, lo que da objetivos ya ordenados.
+    /// Llena `batch.weights` con los pesos de importancia w_i = (N·P(i))^-β, normalizados por
+    /// el mayor del lote.
+    /// @throws std::logic_error Si la memoria está vacía
+    void sample(std::size_t n, utils::Xoshiro256& rng, ReplayBatch<T>& batch, double beta) {
+        if (empty()) throw std::logic_error("PrioritizedReplay::sample: memoria vacia");
+        batch.resize(n);
+        const double total = tree_.total();
+        const double segment = total / static_cast<double>(n);
+        targets_.resize(n);
+        for (std::size_t k = 0; k < n; ++k) {
+            const double u = static_cast<double>(rng() >> 11) * 0x1.0p-53;  // [0, 1)
+            targets_[k] = std::min((static_cast<double>(k) + u) * segment, std::nextafter(total, 0.0));
+        }
+        tree_.find_sorted(targets_, batch.indices);
+        storage_.gather(batch);
+
+        const double count = static_cast<double>(size());
+        double max_w = 0;
+        for (std::size_t k = 0; k < n; ++k) {
+            const double p = tree_.get(batch.indices[k]) / total;
+            const double w = std::pow(count * p, -beta);
+            batch.weights[k] = static_cast<T>(w);
+            max_w = std::max(max_w, w);
+        }
+        for (auto& w : batch.weights) w = static_cast<T>(w / max_w);
+    }
+
+    /// @brief Actualiza las prioridades con los errores TD del último lote
+    /// @throws std::invalid_argument Si los tamaños no coinciden
+    void update_priorities(const std::vector<std::size_t>& indices, const std::vector<T>& td_errors) {
+        if (indices.size() != td_errors.size())
+            throw std::invalid_argument("update_priorities: indices y errores deben tener el mismo tamaño");
+        for (std::size_t k = 0; k < indices.size(); ++k) {
+            const double p = std::abs(static_cast<double>(td_errors[k])) + epsilon_;
+            max_priority_ = std::max(max_priority_, p);
+            tree_.set(indices[k], std::pow(p, alpha_));
+        }
+    }
+
+private:
+    ReplayBuffer<T> storage_;
+    SumTree tree_;
+    double alpha_;
+    double epsilon_;
+    double max_priority_ = 1.0;
+    std::vector<double> targets_;   ///< Objetivos del muestreo, reutilizados
+};
+
+} // namespace utec::nn
+
+#endif // PRIORITIZED_REPLAY_H
@@ -0,0 +1,133 @@
+#pragma once
+#ifndef REPLAY_BUFFER_H
+#define REPLAY_BUFFER_H
+
+/**
+ * @file ReplayBuffer.h
+ * @brief Memoria de repetición (replay) de capacidad fija para DQN, en estructura de arreglos.
+ *
+ * Todas las transiciones viven en arreglos contiguos reservados en el constructor
+ * (estados, acciones, recompensas, siguientes estados y fin de episodio); insertar no asigna
+ * memoria y, una vez llena, cada inserción sobrescribe la transición más antigua (anillo).
+ * El muestreo escribe en un `ReplayBatch` reutilizable, que ya tiene el formato de entrada
+ * de la red (matriz lote x 3).
+ */
+
+#include "EnvGym.h"
+#include "../algebra/tensor.h"
+#include "../utils/random.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Lote de transiciones listo para la red; se reutiliza entre pasos.
+template <typename T>
+struct ReplayBatch {
+    utec::algebra::Tensor<T, 2> states;       ///< lote x 3 (ball_x, ball_y, paddle_y)
+    utec::algebra::Tensor<T, 2> next_states;  ///< lote x 3
+    std::vector<int> actions;                 ///< -1, 0 o 1
+    std::vector<T> rewards;
+    std::vector<std::uint8_t> dones;
+    std::vector<std::size_t> indices;         ///< Posición de cada transición en la memoria
+    std::vector<T> weights;                   ///< Peso de importancia (1 en muestreo uniforme)
+
+    /// @brief Ajusta el tamaño del lote; solo asigna memoria si cambia
+    void resize(std::size_t n) {
+        if (states.shape()[0] != n) {
+            states = utec::algebra::Tensor<T, 2>(n, 3);
+            next_states = utec::algebra::Tensor<T, 2>(n, 3);
+        }
+        actions.resize(n);
+        rewards.resize(n);
+        dones.resize(n);
+        indices.resize(n);
+        weights.resize(n);
+    }
+
+    std::size_t size() const noexcept { return actions.size(); }
+};
+
+/// @brief Memoria de repetición en anillo con arreglos separados por campo.
+template <typename T>
+class ReplayBuffer {
+public:
+    static constexpr std::size_t OBS = 3;  ///< Valores por estado
+
+    /// @brief Reserva espacio para `capacity` transiciones.
+    /// @throws std::invalid_argument Si la capacidad es 0
+    explicit ReplayBuffer(std::size_t capacity)
+        : capacity_(capacity), states_(capacity * OBS), next_states_(capacity * OBS),
+          actions_(capacity), rewards_(capacity), dones_(capacity) {
+        if (capacity == 0) throw std::invalid_argument("ReplayBuffer: la capacidad debe ser mayor que 0");
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Inserta una transición (sobrescribe la más antigua si está llena).
+    /// @return Posición donde quedó guardada
+    std::size_t push(const State& s, int action, T reward, const State& next, bool done) {
+        const std::size_t i = head_;
+        write_state(states_.data() + i * OBS, s);
+        write_state(next_states_.data() + i * OBS, next);
+        actions_[i] = static_cast<std::int8_t>(action);
+        rewards_[i] = reward;
+        dones_[i] = done;
+
+        head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+        if (size_ < capacity_) ++size_;
+        return i;
+    }
+
+    /// @brief Llena `batch` con `n` transiciones elegidas uniformemente (con reemplazo).
+    /// @throws std::logic_error Si la memoria está vacía
+    void sample(std::size_t n, utils::Xoshiro256& rng, ReplayBatch<T>& batch) const {
+        if (empty()) throw std::logic_error("ReplayBuffer::sample: memoria vacia");
+        batch.resize(n);
+        for (std::size_t k = 0; k < n; ++k) batch.indices[k] = rng.below(static_cast<std::uint32_t>(size_));
+        gather(batch);
+        std::fill(batch.weights.begin(), batch.weights.end(), T(1));
+    }
+
+    /// @brief Copia al lote las transiciones de `batch.indices`
+    void gather(ReplayBatch<T>& batch) const {
+        T* s = batch.states.data();
+        T* ns = batch.next_states.data();
+        for (std::size_t k = 0; k < batch.size(); ++k) {
+            const std::size_t i = batch.indices[k];
+            for (std::size_t j = 0; j < OBS; ++j) {
+                s[k * OBS + j] = states_[i * OBS + j];
+                ns[k * OBS + j] = next_states_[i * OBS + j];
+            }
+            batch.actions[k] = actions_[i];
+            batch.rewards[k] = rewards_[i];
+            batch.dones[k] = dones_[i];
+        }
+    }
+
+private:
+    std::size_t capacity_;
+    std::size_t head_ = 0;   ///< Próxima posición a escribir
+    std::size_t size_ = 0;
+    std::vector<T> states_;
+    std::vector<T> next_states_;
+    std::vector<std::int8_t> actions_;
+    std::vector<T> rewards_;
+    std::vector<std::uint8_t> dones_;
+
+    static void write_state(T* dst, const State& s) {
+        dst[0] = s.ball_x;
+        dst[1] = s.ball_y;
+        dst[2] = s.paddle_y;
+    }
+};
+
+} // namespace utec::nn
+
+#endif // REPLAY_BUFFER_H
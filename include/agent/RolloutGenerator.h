@@ -0,0 +1,221 @@
+#pragma once
+#ifndef ROLLOUT_GENERATOR_H
+#define ROLLOUT_GENERATOR_H
+
+/**
+ * @file RolloutGenerator.h
+ * @brief Conjuntos de datos grabados de partidas reales de EnvGym jugadas por un experto analítico.
+ *
+ * La grilla de GridGenerator etiqueta estados con una regla y cubre por igual estados que el
+ * juego casi nunca visita. Aquí los estados salen de trayectorias: InterceptExpert calcula dónde
+ * cruzará la bola la línea de la paleta (plegando los rebotes en las paredes) y mueve la paleta
+ * hacia ese punto; cada paso se graba como (estado previo, velocidad, acción, recompensa).
+ *
+ * El trabajo se divide en fragmentos de `shard_rows` filas. El fragmento k usa el k-ésimo flujo
+ * de `Xoshiro256(seed).fork()`, así que el archivo es el mismo con cualquier cantidad de hilos.
+ * Los fragmentos se generan en paralelo y se escriben en orden a medida que terminan.
+ */
+
+#include "ColumnarDataset.h"
+#include "CsvLoader.h"
+#include "EnvGym.h"
+#include "PongSample.h"
+#include "../utils/random.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Experto que anticipa el punto de intercepción de la bola.
+struct InterceptExpert {
+    float tolerance = 0.025f;   ///< Distancia al objetivo sin moverse (media velocidad de paleta)
+
+    /// @brief Altura a la que la bola cruzará x = 0. Si se aleja, cuenta el rebote en x = 1;
+    /// los rebotes en y = 0 e y = 1 se pliegan como reflexiones.
+    static float intercept_y(const State& s, float vx, float vy) {
+        if (vx == 0.0f) return s.ball_y;
+        const float dx = vx < 0.0f ? s.ball_x : (1.0f - s.ball_x) + 1.0f;
+        float y = std::fmod(s.ball_y + vy * (dx / std::abs(vx)), 2.0f);
+        if (y < 0.0f) y += 2.0f;
+        return y > 1.0f ? 2.0f - y : y;
+    }
+
+    /// @brief Acción hacia el punto de intercepción (-1, 0, 1)
+    int act(const State& s, float vx, float vy) const {
+        const float diff = intercept_y(s, vx, vy) - s.paddle_y;
+        if (diff > tolerance) return 1;
+        if (diff < -tolerance) return -1;
+        return 0;
+    }
+};
+
+/// @brief Parámetros de la generación por partidas.
+struct RolloutConfig {
+    std::uint64_t rows = 1'000'000;                 ///< Filas totales
+    std::uint64_t shard_rows = std::uint64_t{1} << 16;  ///< Filas por fragmento (unidad de trabajo y de semilla)
+    std::uint32_t max_episode_steps = 2000;         ///< Corte de episodios (el experto casi no falla)
+    float epsilon = 0.0f;                           ///< Probabilidad de jugar una acción al azar (se graba la jugada)
+    std::uint64_t seed = 1;
+    std::size_t threads = 0;                        ///< Hilos de generación (0 = todos los núcleos)
+    InterceptExpert expert;
+};
+
+/// @brief Filas y contadores de un fragmento (o de toda la generación).
+struct RolloutStats {
+    std::uint64_t rows = 0;
+    std::uint64_t episodes = 0;     ///< Episodios iniciados
+    std::uint64_t hits = 0;         ///< Golpes de la paleta
+    std::uint64_t misses = 0;       ///< Fallos (fin de episodio)
+    std::uint64_t bytes = 0;
+    double seconds = 0.0;
+    double rows_per_sec() const { return seconds > 0 ? static_cast<double>(rows) / seconds : 0.0; }
+    double hit_rate() const { return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+};
+
+/// @brief Genera y graba partidas del experto en fragmentos deterministas.
+class RolloutGenerator {
+public:
+    /// @throws std::invalid_argument Si shard_rows o max_episode_steps son 0
+    explicit RolloutGenerator(const RolloutConfig& cfg) : cfg_(cfg) {
+        if (cfg_.shard_rows == 0 || cfg_.max_episode_steps == 0)
+            throw std::invalid_argument("RolloutGenerator: shard_rows y max_episode_steps deben ser mayores que cero");
+        utils::Xoshiro256 root(cfg_.seed);
+        streams_.reserve(shards());
+        for (std::uint64_t k = 0; k < shards(); ++k) streams_.push_back(root.fork());
+    }
+
+    const RolloutConfig& config() const noexcept { return cfg_; }
+    std::uint64_t shards() const noexcept { return (cfg_.rows + cfg_.shard_rows - 1) / cfg_.shard_rows; }
+
+    /// @brief Filas del fragmento k (el último puede ser más corto)
+    std::uint64_t shard_size(std::uint64_t k) const {
+        return std::min(cfg_.shard_rows, cfg_.rows - k * cfg_.shard_rows);
+    }
+
+    /// @brief Juega el fragmento k y deja sus filas en `out`; solo depende de (seed, k, config)
+    RolloutStats generate_shard(std::uint64_t k, std::vector<PongSample>& out) const {
+        if (k >= shards()) throw std::out_of_range("RolloutGenerator: fragmento inexistente");
+        const std::uint64_t rows = shard_size(k);
+        utils::Xoshiro256 explore = streams_[k];
+        EnvGym env(explore.fork());
+
+        RolloutStats stats;
+        out.clear();
+        out.reserve(rows);
+        State s = env.reset();
+        stats.episodes = 1;
+        std::uint32_t t = 0;
+        while (out.size() < rows) {
+            const float vx = env.ball_vx();
+            const float vy = env.ball_vy();
+            int action = cfg_.expert.act(s, vx, vy);
+            if (cfg_.epsilon > 0.0f && explore.uniform01() < cfg_.epsilon)
+                action = static_cast<int>(explore.below(3)) - 1;
+
+            float reward = 0.0f;
+            bool done = false;
+            const State next = env.step(action, reward, done);
+            out.push_back({s.ball_x, s.ball_y, vx, vy, s.paddle_y, action, reward});
+            stats.hits += reward > 0.5f;
+            stats.misses += done;
+
+            if (done || ++t >= cfg_.max_episode_steps) {
+                s = env.reset();
+                t = 0;
+                ++stats.episodes;
+            } else {
+                s = next;
+            }
+        }
+        stats.rows = rows;
+        return stats;
+    }
+
+    /// @brief Todas las filas en memoria (para conjuntos pequeños y pruebas)
+    std::vector<PongSample> generate(RolloutStats* stats = nullptr) const {
+        std::vector<PongSample> all, shard;
+        all.reserve(cfg_.rows);
+        RolloutStats total;
+        for (std::uint64_t k = 0; k < shards(); ++k) {
+            add(total, generate_shard(k, shard));
+            all.insert(all.end(), shard.begin(), shard.end());
+        }
+        if (stats) *stats = total;
+        return all;
+    }
+
+    /// @brief Escribe todas las filas como CSV de 7 columnas
+    /// @throws std::runtime_error Si el archivo no se puede escribir
+    RolloutStats write_csv(const std::string& path) const {
+        const auto t0 = std::chrono::steady_clock::now();
+        RolloutStats total;
+        total.bytes = write_pong_csv(path, [&](auto&& write) {
+            run_shards([&](std::uint64_t, const Shard& shard) {
+                add(total, shard.stats);
+                std::string text;
+                text.reserve(shard.samples.size() * 40);
+                for (const auto& s : shard.samples) append_pong_csv(text, s);
+                write(text);
+            });
+        });
+        total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return total;
+    }
+
+    /// @brief Escribe todas las filas en el formato binario por columnas
+    RolloutStats write_columns(const std::string& path) const {
+        const auto t0 = std::chrono::steady_clock::now();
+        ColumnarWriter writer(path, cfg_.rows);
+        RolloutStats total;
+        run_shards([&](std::uint64_t k, const Shard& shard) {
+            add(total, shard.stats);
+            writer.write(k * cfg_.shard_rows, shard.samples);
+        });
+        writer.close();
+        total.bytes = std::filesystem::file_size(path);
+        total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return total;
+    }
+
+private:
+    struct Shard {
+        std::vector<PongSample> samples;
+        RolloutStats stats;
+    };
+
+    RolloutConfig cfg_;
+    std::vector<utils::Xoshiro256> streams_;   ///< Flujo de cada fragmento
+
+    static void add(RolloutStats& total, const RolloutStats& s) {
+        total.rows += s.rows;
+        total.episodes += s.episodes;
+        total.hits += s.hits;
+        total.misses += s.misses;
+    }
+
+    /// @brief Genera los fragmentos en paralelo y los entrega en orden a `consume`
+    template <typename Consume>
+    void run_shards(Consume consume) const {
+        utils::ThreadPool pool(cfg_.threads);
+        pool.ordered_for(
+            shards(),
+            [this](std::size_t k) {
+                Shard shard;
+                shard.stats = generate_shard(k, shard.samples);
+                return shard;
+            },
+            [&](std::size_t k, const Shard& shard) { consume(k, shard); });
+    }
+};
+
+} // namespace utec::nn
+
+#endif // ROLLOUT_GENERATOR_H
@@ -0,0 +1,311 @@
+#pragma once
+#ifndef SAMPLE_STREAM_H
+#define SAMPLE_STREAM_H
+
+/**
+ * @file SampleStream.h
+ * @brief Lectura por bloques de conjuntos de datos más grandes que la memoria.
+ *
+ * Una fuente (ISampleSource) entrega muestras de a bloques: un CSV leído de a tramos, un
+ * archivo por columnas o un generador. SampleStream mantiene dos bloques: mientras el
+ * entrenamiento consume uno, un hilo de fondo llena el otro. Las muestras pasan por un búfer
+ * de mezcla de tamaño fijo: cada lote toma posiciones al azar del búfer y las repone con
+ * las siguientes muestras que llegan, así que se mezclan filas de muchos bloques distintos.
+ *
+ * La memoria usada es (2 * chunk_rows + shuffle_rows) muestras sin importar el tamaño del
+ * conjunto de datos, que puede tener miles de millones de filas.
+ */
+
+#include "ColumnarDataset.h"
+#include "CsvLoader.h"
+#include "PongSample.h"
+#include "../algebra/tensor.h"
+#include "../utils/random.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Origen de muestras leído por bloques, en una o más pasadas.
+class ISampleSource {
+public:
+    virtual ~ISampleSource() = default;
+
+    /// @brief Llena hasta out.size() muestras.
+    /// @return Cantidad escrita; 0 indica el fin de la pasada
+    virtual std::size_t read(std::span<PongSample> out) = 0;
+
+    /// @brief Vuelve al inicio para otra pasada
+    virtual void rewind() = 0;
+};
+
+/// @brief CSV leído de a tramos de `block_bytes`, sin cargar el archivo entero.
+/// Acepta los mismos formatos que load_pong_csv (encabezado opcional, 5 o 7 columnas).
+class CsvSampleSource : public ISampleSource {
+public:
+    /// @throws std::runtime_error Si el archivo no se puede abrir
+    explicit CsvSampleSource(std::string path, std::size_t block_bytes = std::size_t{4} << 20,
+                             bool skip_invalid = false)
+        : path_(std::move(path)), block_(std::max<std::size_t>(block_bytes, 4096)), skip_invalid_(skip_invalid) {
+        rewind();
+    }
+
+    std::size_t read(std::span<PongSample> out) override {
+        std::size_t n = 0;
+        while (n < out.size()) {
+            const char* begin = block_.data() + pos_;
+            const char* end = block_.data() + len_;
+            const char* eol = csv_detail::find_byte(begin, end, '\n');
+            if (eol == end && !eof_) {
+                refill();
+                continue;
+            }
+            if (begin == end) break;  // fin del archivo
+
+            ++line_;
+            pos_ = static_cast<std::size_t>(eol - block_.data()) + (eol != end);
+            if (first_line_) {
+                first_line_ = false;
+                if (end - begin >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) begin += 3;
+                if (csv_detail::is_header(begin, eol)) continue;
+            }
+            const auto row = csv_detail::parse_row(begin, eol, out[n]);
+            if (row == csv_detail::Row::Sample) {
+                ++n;
+            } else if (row == csv_detail::Row::Invalid) {
+                if (!skip_invalid_)
+                    throw std::runtime_error("Fila mal formada en " + path_ + ", linea " + std::to_string(line_));
+                ++skipped_;
+            }
+        }
+        return n;
+    }
+
+    void rewind() override {
+        file_ = std::ifstream(path_, std::ios::binary);
+        if (!file_) throw std::runtime_error("No se pudo abrir el archivo: " + path_);
+        pos_ = len_ = 0;
+        line_ = 0;
+        eof_ = false;
+        first_line_ = true;
+    }
+
+    /// @brief Filas mal formadas saltadas desde la creación (solo con skip_invalid)
+    std::size_t skipped() const noexcept { return skipped_; }
+
+private:
+    std::string path_;
+    std::ifstream file_;
+    std::vector<char> block_;
+    std::size_t pos_ = 0, len_ = 0;   ///< Bytes pendientes: block_[pos_, len_)
+    std::size_t line_ = 0;
+    std::size_t skipped_ = 0;
+    bool eof_ = false;
+    bool first_line_ = true;
+    bool skip_invalid_;
+
+    /// @brief Mueve la línea incompleta al inicio del tramo y lee lo que sigue del archivo
+    void refill() {
+        if (pos_ == 0 && len_ == block_.size())
+            throw std::runtime_error("Linea mas larga que el tramo de lectura en " + path_);
+        std::memmove(block_.data(), block_.data() + pos_, len_ - pos_);
+        len_ -= pos_;
+        pos_ = 0;
+        file_.read(block_.data() + len_, static_cast<std::streamsize>(block_.size() - len_));
+        len_ += static_cast<std::size_t>(file_.gcount());
+        eof_ = file_.eof();
+    }
+};
+
+/// @brief Archivo por columnas proyectado en memoria; solo se tocan las páginas del bloque leído.
+class ColumnarSampleSource : public ISampleSource {
+public:
+    explicit ColumnarSampleSource(const std::string& path) : columns_(path) {}
+
+    std::size_t read(std::span<PongSample> out) override {
+        const std::size_t n = std::min(out.size(), columns_.rows() - next_);
+        for (std::size_t i = 0; i < n; ++i) out[i] = columns_.sample(next_ + i);
+        next_ += n;
+        return n;
+    }
+
+    void rewind() override { next_ = 0; }
+
+private:
+    PongColumns columns_;
+    std::size_t next_ = 0;
+};
+
+/// @brief Muestras generadas al vuelo: `make(i)` produce la fila i de cada pasada.
+class GeneratedSampleSource : public ISampleSource {
+public:
+    GeneratedSampleSource(std::uint64_t rows_per_pass, std::function<PongSample(std::uint64_t)> make)
+        : rows_(rows_per_pass), make_(std::move(make)) {}
+
+    std::size_t read(std::span<PongSample> out) override {
+        const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(out.size(), rows_ - next_));
+        for (std::size_t i = 0; i < n; ++i) out[i] = make_(next_ + i);
+        next_ += n;
+        return n;
+    }
+
+    void rewind() override { next_ = 0; }
+
+private:
+    std::uint64_t rows_;
+    std::function<PongSample(std::uint64_t)> make_;
+    std::uint64_t next_ = 0;
+};
+
+/// @brief Opciones de SampleStream.
+struct StreamOptions {
+    std::size_t chunk_rows = std::size_t{1} << 16;    ///< Filas por lectura de fondo
+    std::size_t shuffle_rows = std::size_t{1} << 18;  ///< Capacidad del búfer de mezcla; 0 = orden de la fuente
+    std::uint64_t seed = 1;                           ///< Semilla de la mezcla
+};
+
+/// @brief Flujo de muestras con lectura anticipada y mezcla en un búfer de tamaño fijo.
+class SampleStream {
+public:
+    /// @throws std::invalid_argument Si no hay fuente o chunk_rows es 0
+    explicit SampleStream(std::unique_ptr<ISampleSource> source, const StreamOptions& opts = {})
+        : source_(std::move(source)), opts_(opts), rng_(opts.seed) {
+        if (!source_) throw std::invalid_argument("SampleStream: fuente nula");
+        if (opts_.chunk_rows == 0) throw std::invalid_argument("SampleStream: chunk_rows debe ser mayor que cero");
+        front_.resize(opts_.chunk_rows);
+        back_.resize(opts_.chunk_rows);
+        shuffle_.reserve(opts_.shuffle_rows);
+        prefetch();
+    }
+
+    ~SampleStream() {
+        if (pending_.valid()) pending_.wait();
+    }
+
+    SampleStream(const SampleStream&) = delete;
+    SampleStream& operator=(const SampleStream&) = delete;
+
+    /// @brief Empieza otra pasada: rebobina la fuente (la mezcla sigue con el mismo generador,
+    /// así que cada pasada sale en otro orden)
+    void reset() {
+        if (pending_.valid()) pending_.wait();
+        pending_ = {};
+        source_->rewind();
+        shuffle_.clear();
+        front_pos_ = front_len_ = 0;
+        delivered_ = 0;
+        exhausted_ = false;
+        prefetch();
+    }
+
+    /// @brief Llena `out` con las próximas muestras de la pasada.
+    /// @return Cantidad escrita; menor que out.size() solo al final de la pasada (0 si terminó)
+    std::size_t next_batch(std::span<PongSample> out) {
+        std::size_t n = 0;
+        while (n < out.size() && next(out[n])) ++n;
+        delivered_ += n;
+        return n;
+    }
+
+    /// @brief Próximo lote como tensores de entrenamiento.
+    /// X recibe (ball_x, ball_y, paddle_y) e Y la acción en one-hot (-1, 0, 1), igual que
+    /// PongAgent; solo se reasignan si cambia la cantidad de filas.
+    /// @return Filas del lote; 0 si terminó la pasada
+    template <typename T>
+    std::size_t next_batch(Tensor<T, 2>& X, Tensor<T, 2>& Y, std::size_t max_rows) {
+        batch_.resize(max_rows);
+        const std::size_t rows = next_batch(std::span<PongSample>(batch_));
+        if (rows == 0) return 0;
+        if (X.shape() != std::array<std::size_t, 2>{rows, 3}) X = Tensor<T, 2>(rows, 3);
+        if (Y.shape() != std::array<std::size_t, 2>{rows, 3}) Y = Tensor<T, 2>(rows, 3);
+        for (std::size_t r = 0; r < rows; ++r) {
+            const PongSample& s = batch_[r];
+            T* x = X.data() + r * 3;
+            T* y = Y.data() + r * 3;
+            x[0] = s.ball_x;
+            x[1] = s.ball_y;
+            x[2] = s.paddle_y;
+            y[0] = s.action == -1 ? 1 : 0;
+            y[1] = s.action == 0 ? 1 : 0;
+            y[2] = s.action == 1 ? 1 : 0;
+        }
+        return rows;
+    }
+
+    /// @brief Muestras entregadas en la pasada actual
+    std::uint64_t delivered() const noexcept { return delivered_; }
+
+    /// @brief Memoria reservada por los búferes (constante durante el entrenamiento)
+    std::size_t memory_bytes() const noexcept {
+        return (front_.capacity() + back_.capacity() + shuffle_.capacity() + batch_.capacity()) * sizeof(PongSample);
+    }
+
+private:
+    std::unique_ptr<ISampleSource> source_;
+    StreamOptions opts_;
+    utils::Xoshiro256 rng_;
+    std::vector<PongSample> front_;     ///< Bloque que se está consumiendo
+    std::vector<PongSample> back_;      ///< Bloque que llena el hilo de fondo
+    std::vector<PongSample> shuffle_;   ///< Búfer de mezcla
+    std::vector<PongSample> batch_;     ///< Lote intermedio de next_batch(X, Y)
+    std::size_t front_pos_ = 0, front_len_ = 0;
+    std::uint64_t delivered_ = 0;
+    bool exhausted_ = false;
+    std::future<std::size_t> pending_;  ///< Lectura en curso sobre back_
+    utils::ThreadPool reader_{1};       ///< Último miembro: se une antes de liberar los búferes
+
+    void prefetch() {
+        pending_ = reader_.submit([this] { return source_->read(std::span<PongSample>(back_)); });
+    }
+
+    /// @brief Siguiente muestra en el orden de la fuente; false al final de la pasada
+    bool take(PongSample& out) {
+        if (front_pos_ == front_len_) {
+            if (exhausted_) return false;
+            front_len_ = pending_.get();  // propaga las excepciones de la fuente
+            front_pos_ = 0;
+            if (front_len_ == 0) {
+                exhausted_ = true;
+                return false;
+            }
+            std::swap(front_, back_);
+            prefetch();
+        }
+        out = front_[front_pos_++];
+        return true;
+    }
+
+    /// @brief Siguiente muestra mezclada; false al final de la pasada
+    bool next(PongSample& out) {
+        if (opts_.shuffle_rows == 0) return take(out);
+        PongSample incoming;
+        while (shuffle_.size() < opts_.shuffle_rows && take(incoming)) shuffle_.push_back(incoming);
+        if (shuffle_.empty()) return false;
+        const std::size_t i = rng_.below(static_cast<std::uint32_t>(shuffle_.size()));
+        out = shuffle_[i];
+        if (take(incoming)) {
+            shuffle_[i] = incoming;
+        } else {
+            shuffle_[i] = shuffle_.back();
+            shuffle_.pop_back();
+        }
+        return true;
+    }
+};
+
+} // namespace utec::nn
+
+#endif // SAMPLE_STREAM_H
@@ -0,0 +1,240 @@
+#pragma once
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+/**
+ * @file SessionRecorder.h
+ * @brief Grabación asíncrona de partidas en un formato binario de registros fijos.
+ *
+ * Disposición del archivo (little-endian):
+ *   - RecordingHeader (128 bytes): magia "PONGREC1", versión, tamaño de registro y el esquema
+ *     de los campos como texto, para rechazar archivos de otra versión en vez de leerlos mal.
+ *   - StepRecord (32 bytes) por paso, uno detrás de otro. Un archivo puede seguir creciendo en
+ *     varias sesiones; si el programa se corta, el último registro incompleto se ignora.
+ *
+ * SessionRecorder::record() solo copia el registro a una SpscQueue: nunca espera al disco ni
+ * toma un mutex, así que el bucle del juego no se detiene. Un hilo de fondo vacía la cola por
+ * lotes con fwrite. Si la cola se llena el registro se descarta y se cuenta en dropped().
+ */
+
+#include "EnvGym.h"
+#include "PongSample.h"
+#include "../utils/mapped_file.h"
+#include "../utils/spsc_queue.h"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace utec::nn {
+
+static_assert(std::endian::native == std::endian::little, "El formato de grabacion es little-endian");
+
+/// @brief Un paso grabado: estado antes de actuar, velocidad, acción y recompensa del paso.
+struct StepRecord {
+    float ball_x, ball_y, ball_vx, ball_vy, paddle_y;
+    std::int32_t action;
+    float reward;
+    std::uint32_t flags;        ///< STEP_DONE si el paso terminó el episodio
+
+    PongSample sample() const { return {ball_x, ball_y, ball_vx, ball_vy, paddle_y, action, reward}; }
+};
+
+/// @brief Cabecera del archivo.
+struct RecordingHeader {
+    char magic[8];               ///< "PONGREC1"
+    std::uint32_t version;       ///< Versión del formato (1)
+    std::uint32_t record_size;   ///< sizeof(StepRecord)
+    char schema[112];            ///< RECORDING_SCHEMA terminado en '\0'
+};
+
+static_assert(sizeof(StepRecord) == 32 && sizeof(RecordingHeader) == 128);
+
+inline constexpr char RECORDING_MAGIC[8] = {'P', 'O', 'N', 'G', 'R', 'E', 'C', '1'};
+inline constexpr std::uint32_t RECORDING_VERSION = 1;
+inline constexpr std::uint32_t STEP_DONE = 1;
+inline constexpr std::string_view RECORDING_SCHEMA =
+    "ball_x:f32,ball_y:f32,ball_vx:f32,ball_vy:f32,paddle_y:f32,action:i32,reward:f32,flags:u32";
+
+namespace recording_detail {
+
+inline RecordingHeader make_header() {
+    RecordingHeader header{};
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.record_size = sizeof(StepRecord);
+    std::memcpy(header.schema, RECORDING_SCHEMA.data(), RECORDING_SCHEMA.size());
+    return header;
+}
+
+/// @brief ¿Los bytes empiezan con una cabecera igual a la que escribe esta versión?
+inline bool valid_header(const char* data, std::size_t size) {
+    if (size < sizeof(RecordingHeader)) return false;
+    const RecordingHeader expected = make_header();
+    return std::memcmp(data, &expected, sizeof(RecordingHeader)) == 0;
+}
+
+} // namespace recording_detail
+
+/// @brief ¿El archivo empieza con la magia del formato de grabación?
+inline bool is_recording_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[8] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) == 0;
+}
+
+/// @brief Lee todos los pasos completos de una grabación.
+/// @throws std::runtime_error Si el archivo no existe o su cabecera no es de esta versión
+inline std::vector<StepRecord> read_step_records(const std::string& path) {
+    const utils::MappedFile file(path);
+    if (!recording_detail::valid_header(file.data(), file.size()))
+        throw std::runtime_error("Cabecera de grabacion invalida o de otra version: " + path);
+    const std::size_t count = (file.size() - sizeof(RecordingHeader)) / sizeof(StepRecord);
+    std::vector<StepRecord> records(count);
+    if (count) std::memcpy(records.data(), file.data() + sizeof(RecordingHeader), count * sizeof(StepRecord));
+    return records;
+}
+
+/// @brief Lee una grabación como muestras de entrenamiento.
+inline std::vector<PongSample> load_pong_recording(const std::string& path) {
+    const auto records = read_step_records(path);
+    std::vector<PongSample> samples;
+    samples.reserve(records.size());
+    for (const auto& r : records) samples.push_back(r.sample());
+    return samples;
+}
+
+/// @brief Graba pasos en segundo plano sin bloquear a quien llama a record().
+class SessionRecorder {
+public:
+    /// @brief Abre `path` para agregar pasos; si no existe o está vacío escribe la cabecera.
+    /// @param capacity Pasos que caben en la cola antes de descartar
+    /// @param flush_every Espera del hilo de fondo cuando la cola está vacía
+    /// @throws std::runtime_error Si el archivo no se puede abrir o es de otro formato
+    explicit SessionRecorder(const std::string& path, std::size_t capacity = std::size_t{1} << 14,
+                             std::chrono::milliseconds flush_every = std::chrono::milliseconds(20))
+        : path_(path), queue_(capacity), flush_every_(flush_every) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        const bool fresh = ec || size == 0;
+        if (!fresh) {
+            RecordingHeader header{};
+            std::ifstream in(path, std::ios::binary);
+            if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+                || !recording_detail::valid_header(reinterpret_cast<const char*>(&header), sizeof(header)))
+                throw std::runtime_error("El archivo no es una grabacion de esta version: " + path);
+            if ((size - sizeof(RecordingHeader)) % sizeof(StepRecord) != 0) {
+                // Un corte dejó medio registro al final: se recorta para que lo nuevo quede alineado
+                std::filesystem::resize_file(path, size - (size - sizeof(RecordingHeader)) % sizeof(StepRecord));
+            }
+        }
+
+        file_ = std::fopen(path.c_str(), "ab");
+        if (!file_) throw std::runtime_error("No se pudo abrir el archivo para grabar: " + path);
+        if (fresh) {
+            const RecordingHeader header = recording_detail::make_header();
+            if (std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+                std::fclose(file_);
+                throw std::runtime_error("Error al escribir el archivo: " + path);
+            }
+        }
+        writer_ = std::jthread([this](std::stop_token stop) { drain(stop); });
+    }
+
+    ~SessionRecorder() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /// @brief Encola un paso. Solo lo llama un hilo (el del juego); nunca espera.
+    /// @return false si la cola estaba llena y el paso se descartó
+    bool record(const StepRecord& step) noexcept {
+        if (queue_.try_push(step)) {
+            recorded_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /// @brief Encola el paso que va de `before` (con la velocidad previa) a su resultado
+    bool record(const State& before, float ball_vx, float ball_vy, int action, float reward, bool done) noexcept {
+        return record(StepRecord{before.ball_x, before.ball_y, ball_vx, ball_vy, before.paddle_y,
+                                 static_cast<std::int32_t>(action), reward, done ? STEP_DONE : 0u});
+    }
+
+    /// @brief Escribe lo pendiente y cierra el archivo
+    /// @throws std::runtime_error Si alguna escritura falló
+    void close() {
+        if (!file_) return;
+        writer_.request_stop();
+        if (writer_.joinable()) writer_.join();
+        const bool closed = std::fclose(file_) == 0;
+        file_ = nullptr;
+        if (failed_.load() || !closed) throw std::runtime_error("Error al escribir el archivo: " + path_);
+    }
+
+    std::uint64_t recorded() const noexcept { return recorded_.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t written() const noexcept { return written_.load(std::memory_order_relaxed); }
+    const std::string& path() const noexcept { return path_; }
+
+    /// @brief Registros que el hilo de fondo escribe con un solo fwrite
+    static constexpr std::size_t BATCH_RECORDS = 1024;
+
+private:
+    std::string path_;
+    utils::SpscQueue<StepRecord> queue_;
+    std::chrono::milliseconds flush_every_;
+    std::FILE* file_ = nullptr;
+    std::atomic<std::uint64_t> recorded_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<bool> failed_{false};
+    std::jthread writer_;   ///< Último miembro: se detiene antes de destruir la cola
+
+    /// @brief Hilo de fondo: vacía la cola por lotes hasta que se pide detenerse y no queda nada
+    void drain(std::stop_token stop) {
+        std::vector<StepRecord> batch;
+        batch.reserve(BATCH_RECORDS);
+        bool dirty = false;
+        while (true) {
+            // Leer la señal antes de vaciar: lo encolado antes de close() siempre se escribe
+            const bool stopping = stop.stop_requested();
+            queue_.consume([&](const StepRecord& r) { batch.push_back(r); }, BATCH_RECORDS);
+            if (!batch.empty()) {
+                if (!failed_.load(std::memory_order_relaxed)
+                    && std::fwrite(batch.data(), sizeof(StepRecord), batch.size(), file_) != batch.size())
+                    failed_.store(true);
+                written_.fetch_add(batch.size(), std::memory_order_relaxed);
+                batch.clear();
+                dirty = true;
+                continue;
+            }
+            if (stopping) break;
+            // Sin pasos nuevos: lo escrito llega al sistema antes de dormir
+            if (dirty && std::fflush(file_) != 0) failed_.store(true);
+            dirty = false;
+            std::this_thread::sleep_for(flush_every_);
+        }
+    }
+};
+
+} // namespace utec::nn
+
+#endif // SESSION_RECORDER_H
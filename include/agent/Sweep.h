@@ -0,0 +1,218 @@
+#pragma once
+#ifndef SWEEP_H
+#define SWEEP_H
+
+/**
+ * @file Sweep.h
+ * @brief Búsqueda de hiperparámetros para PongAgent (grilla o aleatoria) en paralelo.
+ *
+ * Cada configuración se entrena en un hilo del pool sobre la misma copia de solo lectura del
+ * dataset, se evalúa periódicamente en EnvGym para medir el tiempo hasta alcanzar la tasa de
+ * golpes objetivo y al final se ordenan los resultados. Cada configuración tiene su semilla y
+ * su flujo de EnvGym, y el orden usa solo valores reproducibles (no tiempos medidos), así que
+ * el ranking es el mismo con cualquier cantidad de hilos.
+ */
+
+#include "PongAgent.h"
+#include "Evaluator.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace utec::nn {
+
+/// @brief Valores candidatos de cada hiperparámetro.
+template <typename T>
+struct SweepSpace {
+    std::vector<size_t> hidden_sizes{8};
+    std::vector<T> learning_rates{static_cast<T>(0.0001)};
+    std::vector<OptimizerKind> optimizers{OptimizerKind::SGD};
+    std::vector<size_t> batch_sizes{1};
+    std::vector<int> epochs{100};
+    std::vector<bool> normalize{false};   ///< Con y/o sin estandarizar las entradas
+
+    /// @brief Producto cartesiano de todos los valores
+    std::vector<TrainConfig<T>> grid() const {
+        std::vector<TrainConfig<T>> configs;
+        for (size_t h : hidden_sizes)
+            for (T lr : learning_rates)
+                for (OptimizerKind opt : optimizers)
+                    for (size_t b : batch_sizes)
+                        for (int e : epochs)
+                            for (bool n : normalize) {
+                                TrainConfig<T> cfg;
+                                cfg.hidden_size = h;
+                                cfg.learning_rate = lr;
+                                cfg.optimizer = opt;
+                                cfg.batch_size = b;
+                                cfg.epochs = e;
+                                cfg.normalize_inputs = n;
+                                configs.push_back(cfg);
+                            }
+        return configs;
+    }
+
+    /// @brief Muestreo aleatorio: la tasa de aprendizaje es log-uniforme entre el mínimo y el
+    /// máximo dados; el resto se elige uniformemente entre los valores listados.
+    std::vector<TrainConfig<T>> random(size_t count, unsigned seed) const {
+        std::mt19937 gen(seed);
+        auto pick = [&gen](const auto& values) {
+            std::uniform_int_distribution<size_t> d(0, values.size() - 1);
+            return values[d(gen)];
+        };
+        const auto [lo, hi] = std::minmax_element(learning_rates.begin(), learning_rates.end());
+        std::uniform_real_distribution<double> log_lr(std::log(static_cast<double>(*lo)),
+                                                      std::log(static_cast<double>(*hi)));
+
+        std::vector<TrainConfig<T>> configs;
+        for (size_t i = 0; i < count; ++i) {
+            TrainConfig<T> cfg;
+            cfg.hidden_size = pick(hidden_sizes);
+            cfg.learning_rate = static_cast<T>(std::exp(log_lr(gen)));
+            cfg.optimizer = pick(optimizers);
+            cfg.batch_size = pick(batch_sizes);
+            cfg.epochs = pick(epochs);
+            cfg.normalize_inputs = pick(normalize);
+            configs.push_back(cfg);
+        }
+        return configs;
+    }
+};
+
+/// @brief Opciones de ejecución del barrido.
+struct SweepOptions {
+    size_t threads = 0;             ///< Hilos del pool (0 = todos los núcleos)
+    size_t eval_steps = 5000;       ///< Pasos de EnvGym por evaluación
+    int eval_every = 10;            ///< Épocas entre evaluaciones intermedias
+    double target_hit_rate = 0.8;   ///< Calidad objetivo para el tiempo hasta calidad
+    unsigned seed = 1;              ///< Semilla base; la configuración i usa seed + i para sus pesos
+                                    ///< y el i-ésimo salto de Xoshiro256(seed) para su EnvGym
+};
+
+/// @brief Resultado de una configuración.
+template <typename T>
+struct SweepResult {
+    TrainConfig<T> config;
+    T final_loss = 0;
+    EvalResult eval;                ///< Evaluación del modelo final
+    double train_seconds = 0;       ///< Tiempo de entrenamiento (sin contar evaluaciones)
+    double time_to_quality = -1;    ///< Segundos de entrenamiento hasta el objetivo (-1: no lo alcanzó)
+    int epoch_to_quality = -1;      ///< Época en que se alcanzó el objetivo
+};
+
+/// @brief Nombre corto de un optimizador
+inline const char* optimizer_name(OptimizerKind kind) {
+    return kind == OptimizerKind::Adam ? "adam" : "sgd";
+}
+
+/// @brief Entrena y evalúa todas las configuraciones en paralelo.
+/// @param data Dataset compartido (solo lectura) por todos los hilos
+/// @return Resultados ordenados: mayor tasa de golpes, luego primera época en alcanzar el objetivo,
+///         menor pérdida y orden de `configs`. Los segundos medidos se informan pero no ordenan,
+///         porque dependen de la carga de la máquina.
+template <typename T>
+std::vector<SweepResult<T>> run_sweep(const std::vector<PongSample>& data,
+                                      std::vector<TrainConfig<T>> configs,
+                                      const SweepOptions& opts) {
+    using Clock = std::chrono::steady_clock;
+    utils::ThreadPool pool(opts.threads);
+    utils::Xoshiro256 env_streams(opts.seed);  ///< Un flujo independiente por configuración
+    std::vector<std::future<SweepResult<T>>> pending;
+
+    for (size_t i = 0; i < configs.size(); ++i) {
+        configs[i].seed = opts.seed + static_cast<unsigned>(i);
+        configs[i].verbose = false;
+        pending.push_back(pool.submit([&data, &opts, cfg = configs[i], rng = env_streams.fork()] {
+            SweepResult<T> result;
+            result.config = cfg;
+            EnvGym env(rng);
+
+            Clock::duration eval_time{};
+            const auto start = Clock::now();
+            auto on_epoch = [&](int epoch, T loss, utec::neural_network::ILayer<T>& model) {
+                result.final_loss = loss;
+                if (opts.eval_every <= 0 || result.epoch_to_quality >= 0 || (epoch + 1) % opts.eval_every != 0)
+                    return true;
+
+                const auto eval_start = Clock::now();
+                auto policy = [&model](const State& s) { return PongAgent<T>::greedy_action(model, s); };
+                EvalResult r = evaluate_policy(policy, env, opts.eval_steps);
+                const auto now = Clock::now();
+                eval_time += now - eval_start;
+                if (r.hit_rate() >= opts.target_hit_rate) {
+                    result.epoch_to_quality = epoch;
+                    result.time_to_quality = std::chrono::duration<double>(now - start - eval_time).count();
+                }
+                return true;
+            };
+
+            auto model = PongAgent<T>::train_from_samples(data, cfg, nullptr, on_epoch);
+            result.train_seconds = std::chrono::duration<double>(Clock::now() - start - eval_time).count();
+
+            auto policy = [&model](const State& s) { return PongAgent<T>::greedy_action(*model, s); };
+            result.eval = evaluate_policy(policy, env, opts.eval_steps);
+            return result;
+        }));
+    }
+
+    std::vector<SweepResult<T>> results;
+    for (auto& f : pending) results.push_back(f.get());
+
+    std::stable_sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+        if (a.eval.hit_rate() != b.eval.hit_rate()) return a.eval.hit_rate() > b.eval.hit_rate();
+        const int ea = a.epoch_to_quality < 0 ? std::numeric_limits<int>::max() : a.epoch_to_quality;
+        const int eb = b.epoch_to_quality < 0 ? std::numeric_limits<int>::max() : b.epoch_to_quality;
+        if (ea != eb) return ea < eb;
+        return a.final_loss < b.final_loss;
+    });
+    return results;
+}
+
+/// @brief Escribe los resultados como CSV (una fila por configuración, ya ordenadas).
+template <typename T>
+void write_sweep_csv(std::ostream& os, const std::vector<SweepResult<T>>& results) {
+    os << "rank,hidden,learning_rate,optimizer,batch,epochs,normalize,final_loss,hit_rate,hits,misses,"
+          "train_seconds,time_to_quality,epoch_to_quality\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << i + 1 << ',' << r.config.hidden_size << ',' << r.config.learning_rate << ','
+           << optimizer_name(r.config.optimizer) << ',' << r.config.batch_size << ','
+           << r.config.epochs << ',' << r.config.normalize_inputs << ',' << r.final_loss << ',' << r.eval.hit_rate() << ','
+           << r.eval.hits << ',' << r.eval.misses << ',' << r.train_seconds << ','
+           << r.time_to_quality << ',' << r.epoch_to_quality << '\n';
+    }
+}
+
+/// @brief Imprime una tabla legible con el ranking.
+template <typename T>
+void print_sweep_table(std::ostream& os, const std::vector<SweepResult<T>>& results) {
+    os << std::left << std::setw(5) << "#" << std::setw(8) << "Oculta" << std::setw(12) << "LR"
+       << std::setw(6) << "Opt" << std::setw(7) << "Lote" << std::setw(8) << "Epocas" << std::setw(6) << "Norm"
+       << std::setw(11) << "Perdida" << std::setw(9) << "Golpes" << std::setw(11) << "Entreno(s)"
+       << "Calidad(s)\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << std::left << std::setw(5) << i + 1 << std::setw(8) << r.config.hidden_size
+           << std::setw(12) << r.config.learning_rate << std::setw(6) << optimizer_name(r.config.optimizer)
+           << std::setw(7) << r.config.batch_size << std::setw(8) << r.config.epochs
+           << std::setw(6) << (r.config.normalize_inputs ? "si" : "no")
+           << std::setw(11) << std::setprecision(4) << r.final_loss
+           << std::setw(9) << std::setprecision(3) << r.eval.hit_rate()
+           << std::setw(11) << std::setprecision(3) << r.train_seconds;
+        if (r.time_to_quality < 0) os << "-";
+        else os << std::setprecision(3) << r.time_to_quality << " (ep " << r.epoch_to_quality << ")";
+        os << '\n';
+    }
+}
+
+} // namespace utec::nn
+
+#endif // SWEEP_H
@@ -0,0 +1,226 @@
+#pragma once
+#ifndef VEC_ENV_GYM_H
+#define VEC_ENV_GYM_H
+
+/**
+ * @file VecEnvGym.h
+ * @brief N entornos Pong en estructura de arreglos (SoA) que avanzan a la vez.
+ *
+ * Reproduce exactamente la física de `EnvGym::step`, pero guarda cada componente en su propio
+ * arreglo contiguo (ball_x[], ball_y[], vx[], vy[], paddle_y[]). El paso usa SSE2 (4 entornos
+ * por instrucción) y no tiene saltos: cada rama de EnvGym se convierte en una comparación que
+ * produce una máscara y una selección con and/andnot/or. Sin SSE2 se usa el paso escalar.
+ * Los episodios terminados se reinician en una segunda pasada, que solo se ejecuta si hubo alguno.
+ */
+
+#include "EnvGym.h"
+#include "../utils/random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace utec::nn {
+
+/// @brief Conjunto de entornos Pong independientes con reinicio automático.
+class VecEnvGym {
+public:
+    static constexpr float PADDLE_SPEED = 0.05f;   ///< Igual que EnvGym
+    static constexpr float PADDLE_HEIGHT = 0.2f;   ///< Igual que EnvGym
+
+    /// @brief Crea `count` entornos y los reinicia.
+    /// @param seed Semilla de las velocidades iniciales
+    explicit VecEnvGym(std::size_t count, std::uint64_t seed = 1)
+        : VecEnvGym(count, utils::Xoshiro256(seed)) {}
+
+    /// @brief Crea `count` entornos con un flujo ya preparado (por ejemplo, `rng.fork()` por hilo).
+    VecEnvGym(std::size_t count, utils::Xoshiro256 rng)
+        : ball_x_(count), ball_y_(count), vx_(count), vy_(count), paddle_y_(count),
+          rewards_(count), dones_(count), rng_(rng) {
+        reset();
+    }
+
+    /// @brief Cantidad de entornos
+    std::size_t size() const noexcept { return ball_x_.size(); }
+
+    /// @brief Reinicia todos los entornos
+    void reset() {
+        for (std::size_t i = 0; i < size(); ++i) reset(i);
+    }
+
+    /// @brief Reinicia el entorno `i`: bola y paleta al centro, velocidad aleatoria como EnvGym
+    void reset(std::size_t i) {
+        ball_x_[i] = ball_y_[i] = paddle_y_[i] = 0.5f;
+        vx_[i] = (0.04f + 0.06f * (rng_.below(100) / 100.0f)) * (rng_.below(2) ? 1 : -1);
+        vy_[i] = (0.02f + 0.04f * (rng_.below(100) / 100.0f)) * (rng_.below(2) ? 1 : -1);
+    }
+
+    /// @brief Fija el estado y la velocidad del entorno `i`
+    void set_env(std::size_t i, const State& state, float ball_vx, float ball_vy) {
+        ball_x_[i] = state.ball_x;
+        ball_y_[i] = state.ball_y;
+        paddle_y_[i] = state.paddle_y;
+        vx_[i] = ball_vx;
+        vy_[i] = ball_vy;
+    }
+
+    /// @brief Avanza todos los entornos un paso.
+    /// Después, rewards() y dones() tienen el resultado de cada uno; los entornos con done
+    /// ya fueron reiniciados, así que su estado es el inicial del siguiente episodio.
+    /// @param actions Acción de cada entorno (-1, 0 o 1)
+    /// @throws std::invalid_argument Si hay una acción por entorno distinta de size()
+    void step(std::span<const int> actions) {
+        const std::size_t n = size();
+        if (actions.size() != n)
+            throw std::invalid_argument("VecEnvGym::step: se espera una accion por entorno");
+
+        const bool finished = step_kernel(actions.data(), ball_x_.data(), ball_y_.data(),
+                                          vx_.data(), vy_.data(), paddle_y_.data(),
+                                          rewards_.data(), dones_.data(), n);
+        if (!finished) return;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (dones_[i]) reset(i);
+        }
+    }
+
+    /// @brief Copia el estado de cada entorno (formato de PongAgent::act_batch)
+    /// @throws std::invalid_argument Si `out` no tiene size() elementos
+    void observe(std::span<State> out) const {
+        if (out.size() != size())
+            throw std::invalid_argument("VecEnvGym::observe: se espera un estado por entorno");
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = {ball_x_[i], ball_y_[i], paddle_y_[i]};
+    }
+
+    /// @brief Estado del entorno `i`
+    State state(std::size_t i) const { return {ball_x_[i], ball_y_[i], paddle_y_[i]}; }
+
+    std::span<const float> ball_x() const noexcept { return ball_x_; }
+    std::span<const float> ball_y() const noexcept { return ball_y_; }
+    std::span<const float> ball_vx() const noexcept { return vx_; }
+    std::span<const float> ball_vy() const noexcept { return vy_; }
+    std::span<const float> paddle_y() const noexcept { return paddle_y_; }
+
+    /// @brief Recompensa de cada entorno en el último paso
+    std::span<const float> rewards() const noexcept { return rewards_; }
+
+    /// @brief 1 si el entorno terminó un episodio en el último paso (y fue reiniciado)
+    std::span<const std::uint8_t> dones() const noexcept { return dones_; }
+
+private:
+    std::vector<float> ball_x_, ball_y_, vx_, vy_, paddle_y_;
+    std::vector<float> rewards_;
+    std::vector<std::uint8_t> dones_;
+    utils::Xoshiro256 rng_;
+
+    /// @brief Paso sin saltos de `n` entornos; devuelve true si alguno terminó.
+    /// Con SSE2 procesa 4 entornos por iteración; el resto (o todo, sin SSE2) va por step_one.
+    static bool step_kernel(const int* __restrict act, float* __restrict bx, float* __restrict by,
+                                   float* __restrict vx, float* __restrict vy, float* __restrict py,
+                                   float* __restrict rw, std::uint8_t* __restrict dn, std::size_t n) {
+        bool finished = false;
+        std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 half = _mm_set1_ps(PADDLE_HEIGHT / 2);
+        const __m128 upper = _mm_set1_ps(1.0f - PADDLE_HEIGHT / 2);
+        const __m128 speed = _mm_set1_ps(PADDLE_SPEED);
+        // select(m, a, b): a donde la máscara está activa, b en otro caso
+        auto select = [](__m128 m, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); };
+
+        for (; i + 4 <= n; i += 4) {
+            const __m128 a = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(act + i)));
+            __m128 r = _mm_and_ps(_mm_cmpneq_ps(a, zero), _mm_set1_ps(-0.01f));
+            const __m128 p = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(a, speed)), half), upper);
+
+            __m128 dx = _mm_loadu_ps(vx + i);
+            __m128 dy = _mm_loadu_ps(vy + i);
+            __m128 x = _mm_add_ps(_mm_loadu_ps(bx + i), dx);
+            __m128 y = _mm_add_ps(_mm_loadu_ps(by + i), dy);
+
+            // Rebotes: fijar la posición en el borde e invertir el signo de la velocidad
+            const __m128 top = _mm_cmple_ps(y, zero);
+            y = _mm_andnot_ps(top, y);
+            dy = _mm_xor_ps(dy, _mm_and_ps(top, sign));
+            const __m128 bottom = _mm_cmpge_ps(y, one);
+            y = select(bottom, one, y);
+            dy = _mm_xor_ps(dy, _mm_and_ps(bottom, sign));
+            const __m128 right = _mm_cmpge_ps(x, one);
+            x = select(right, one, x);
+            dx = _mm_xor_ps(dx, _mm_and_ps(right, sign));
+
+            // Paleta: golpe (con bono cerca del centro) o fallo
+            const __m128 left = _mm_cmple_ps(x, zero);
+            const __m128 inside = _mm_and_ps(_mm_cmpge_ps(y, _mm_sub_ps(p, half)),
+                                             _mm_cmple_ps(y, _mm_add_ps(p, half)));
+            const __m128 hit = _mm_and_ps(left, inside);
+            const __m128 miss = _mm_andnot_ps(inside, left);
+            const __m128 centered = _mm_cmplt_ps(_mm_andnot_ps(sign, _mm_sub_ps(y, p)), _mm_set1_ps(0.05f));
+            x = _mm_andnot_ps(hit, x);
+            dx = select(hit, _mm_andnot_ps(sign, dx), dx);
+            r = _mm_add_ps(r, _mm_and_ps(hit, one));
+            r = _mm_add_ps(r, _mm_and_ps(_mm_and_ps(hit, centered), one));
+            r = _mm_sub_ps(r, _mm_and_ps(miss, _mm_set1_ps(5.0f)));
+
+            _mm_storeu_ps(bx + i, x);
+            _mm_storeu_ps(by + i, y);
+            _mm_storeu_ps(vx + i, dx);
+            _mm_storeu_ps(vy + i, dy);
+            _mm_storeu_ps(py + i, p);
+            _mm_storeu_ps(rw + i, r);
+
+            const int bits = _mm_movemask_ps(miss);
+            for (int k = 0; k < 4; ++k) dn[i + k] = static_cast<std::uint8_t>((bits >> k) & 1);
+            finished |= bits != 0;
+        }
+#endif
+        for (; i < n; ++i) {
+            dn[i] = step_one(act[i], bx[i], by[i], vx[i], vy[i], py[i], rw[i]);
+            finished |= dn[i] != 0;
+        }
+        return finished;
+    }
+
+    /// @brief Un paso escalar, con la misma física y el mismo orden de operaciones que EnvGym::step.
+    /// @return true si el episodio terminó
+    static bool step_one(int action, float& bx, float& by, float& vx, float& vy, float& py, float& reward) {
+        constexpr float half = PADDLE_HEIGHT / 2;
+        float r = action != 0 ? -0.01f : 0.0f;
+        py = std::clamp(py + action * PADDLE_SPEED, half, 1.0f - half);
+        bx += vx;
+        by += vy;
+
+        if (by <= 0.0f) { by = 0.0f; vy = -vy; }
+        if (by >= 1.0f) { by = 1.0f; vy = -vy; }
+        if (bx >= 1.0f) { bx = 1.0f; vx = -vx; }
+
+        bool done = false;
+        if (bx <= 0.0f) {
+            if (by >= py - half && by <= py + half) {
+                bx = 0.0f;
+                vx = std::abs(vx);
+                r += 1.0f;
+                if (std::abs(by - py) < 0.05f) r += 1.0f;
+            } else {
+                done = true;
+                r -= 5.0f;
+            }
+        }
+        reward = r;
+        return done;
+    }
+};
+
+} // namespace utec::nn
+
+#endif // VEC_ENV_GYM_H
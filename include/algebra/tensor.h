@@ -101,6 +101,10 @@ public:
     T& operator[](std::size_t index) { return data_[index]; }
     const T& operator[](std::size_t index) const { return data_[index]; }
 
+    /// @brief Puntero al bloque contiguo de datos (orden fila-mayor)
+    T* data() noexcept { return data_.data(); }
+    const T* data() const noexcept { return data_.data(); }
+
     /// @brief Devuelve la forma del tensor
     const std::array<std::size_t, Rank>& shape() const noexcept { return shape_; }
 
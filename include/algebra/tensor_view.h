@@ -0,0 +1,108 @@
+#ifndef TENSOR_VIEW_H
+#define TENSOR_VIEW_H
+
+/**
+ * @file tensor_view.h
+ * @brief Vista sin copia sobre datos ajenos con la interfaz de acceso de Tensor.
+ *
+ * Una TensorView no reserva ni libera memoria: apunta a un bloque contiguo (orden fila-mayor)
+ * que pertenece a otro objeto, por ejemplo un Tensor o un archivo proyectado en memoria.
+ * Quien la crea garantiza que ese bloque vive más que la vista.
+ */
+
+#include "tensor.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utec::algebra {
+
+/// @brief Vista de rango fijo `Rank` sobre elementos de tipo `T` (usar `const U` para solo lectura).
+template <typename T, std::size_t Rank>
+class TensorView {
+private:
+    T* data_ = nullptr;                      ///< Primer elemento (no es dueña)
+    std::array<std::size_t, Rank> shape_{};  ///< Dimensiones de la vista
+
+    std::size_t compute_linear_index(const std::array<std::size_t, Rank>& indices) const {
+        std::size_t index = 0;
+        std::size_t stride = 1;
+        for (int i = Rank - 1; i >= 0; --i) {
+            if (indices[i] >= shape_[i])
+                throw std::out_of_range("Index out of range");
+            index += indices[i] * stride;
+            stride *= shape_[i];
+        }
+        return index;
+    }
+
+public:
+    using value_type = std::remove_const_t<T>;
+
+    /// @brief Vista vacía
+    TensorView() = default;
+
+    /// @brief Vista sobre `data` con la forma indicada
+    TensorView(T* data, const std::array<std::size_t, Rank>& shape) : data_(data), shape_(shape) {}
+
+    /// @brief Vista sobre todo un Tensor
+    TensorView(Tensor<value_type, Rank>& tensor) requires(!std::is_const_v<T>)
+        : data_(tensor.data()), shape_(tensor.shape()) {}
+
+    /// @brief Vista de solo lectura sobre todo un Tensor
+    TensorView(const Tensor<value_type, Rank>& tensor) requires std::is_const_v<T>
+        : data_(tensor.data()), shape_(tensor.shape()) {}
+
+    /// @brief Una vista mutable también sirve como vista de solo lectura
+    TensorView(const TensorView<value_type, Rank>& other) requires std::is_const_v<T>
+        : data_(other.data()), shape_(other.shape()) {}
+
+    /// @brief Acceso por índice con verificación de rango (como en Tensor)
+    template <typename... Idxs>
+    T& operator()(Idxs... idxs) const {
+        static_assert(sizeof...(Idxs) == Rank, "Incorrect number of indices");
+        return data_[compute_linear_index({static_cast<std::size_t>(idxs)...})];
+    }
+
+    /// @brief Acceso unidimensional sin verificación
+    T& operator[](std::size_t index) const { return data_[index]; }
+
+    T* data() const noexcept { return data_; }
+    const std::array<std::size_t, Rank>& shape() const noexcept { return shape_; }
+
+    /// @brief Número total de elementos
+    std::size_t size() const noexcept {
+        return std::accumulate(shape_.begin(), shape_.end(), std::size_t{1}, std::multiplies<>());
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+    T* begin() const noexcept { return data_; }
+    T* end() const noexcept { return data_ + size(); }
+
+    /// @brief Subconjunto [start, end) de la primera dimensión, sin copiar
+    TensorView slice(std::size_t start, std::size_t end) const {
+        if (end > shape_[0]) end = shape_[0];
+        if (start > end) start = end;
+        auto shape = shape_;
+        shape[0] = end - start;
+        return {data_ + start * (size() / (shape_[0] ? shape_[0] : 1)), shape};
+    }
+
+    /// @brief Copia los elementos a un Tensor propio
+    Tensor<value_type, Rank> to_tensor() const {
+        Tensor<value_type, Rank> result(shape_);
+        std::copy(begin(), end(), result.data());
+        return result;
+    }
+};
+
+} // namespace utec::algebra
+
+using utec::algebra::TensorView;
+
+#endif // TENSOR_VIEW_H
@@ -17,7 +17,7 @@ public:
     /// @param input Tensor de entrada
     /// @return Tensor activado
     Tensor<T, 2> forward(const Tensor<T, 2>& input) override {
-        mask_ = input;
+        if (this->requires_input_grad_) mask_ = input;
         Tensor<T, 2> output(input.shape()[0], input.shape()[1]);
         for (size_t i = 0; i < input.shape()[0]; ++i) {
             for (size_t j = 0; j < input.shape()[1]; ++j) {
@@ -31,6 +31,7 @@ public:
     /// @param grad Gradiente de salida
     /// @return Gradiente de entrada
     Tensor<T, 2> backward(const Tensor<T, 2>& grad) override {
+        if (!this->requires_input_grad_) return {};
         Tensor<T, 2> output(grad.shape()[0], grad.shape()[1]);
         for (size_t i = 0; i < grad.shape()[0]; ++i) {
             for (size_t j = 0; j < grad.shape()[1]; ++j) {
@@ -70,6 +71,7 @@ public:
     /// @param grad Gradiente de salida
     /// @return Gradiente de entrada
     Tensor<T, 2> backward(const Tensor<T, 2>& grad) override {
+        if (!this->requires_input_grad_) return {};
         Tensor<T, 2> result(grad.shape()[0], grad.shape()[1]);
         for (size_t i = 0; i < grad.shape()[0]; ++i) {
             for (size_t j = 0; j < grad.shape()[1]; ++j) {
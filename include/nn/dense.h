@@ -17,7 +17,7 @@ template <typename T>
 class Dense final : public ILayer<T> {
 private:
     Tensor<T, 2> W_, dW_;   ///< Pesos y gradientes de los pesos
-    Tensor<T, 1> b_, db_;   ///< Bias y gradientes del bias
+    Tensor<T, 2> b_, db_;   ///< Bias (1 x out_f) y sus gradientes
     Tensor<T, 2> last_x_;   ///< Entrada del forward, usada para el backward
 
 public:
@@ -35,15 +35,11 @@ public:
         dW_ = Tensor<T, 2>(in_f, out_f);
         init_w_fun(W_);
 
-        b_ = Tensor<T, 1>(out_f);
-        db_ = Tensor<T, 1>(out_f);
-
-        // Adaptar bias 1D a 2D para usar misma función de inicialización
-        Tensor<T, 2> b_view(1, out_f);
-        init_b_fun(b_view);
-        for (size_t j = 0; j < out_f; ++j) {
-            b_(j) = b_view(0, j);
-        }
+        // El bias se guarda como fila 1 x out_f: misma función de inicialización
+        // y el optimizador lo actualiza directamente, sin copias intermedias
+        b_ = Tensor<T, 2>(1, out_f);
+        db_ = Tensor<T, 2>(1, out_f);
+        init_b_fun(b_);
     }
 
     /// @brief Constructor único cuando se pasa una sola función de inicialización.
@@ -54,17 +50,12 @@ public:
     Dense(size_t in_f, size_t out_f, Init&& init_fun)
         : Dense(in_f, out_f,
                 [&](auto& tensor) { init_fun(tensor); },
-                [&](auto& tensor) {
-                    Tensor<T, 2> temp(1, tensor.size());
-                    init_fun(temp);
-                    for (size_t j = 0; j < tensor.size(); ++j) {
-                        tensor[j] = temp(0, j);
-                    }
-                }) {}
+                [&](auto& tensor) { init_fun(tensor); }) {}
 
     /// @brief Propagación hacia adelante (y = xW + b)
     Tensor<T, 2> forward(const Tensor<T, 2>& x) override {
-        last_x_ = x;
+        // La entrada solo hace falta para dW: una capa congelada no la guarda
+        if (!this->frozen_) last_x_ = x;
         Tensor<T, 2> output(x.shape()[0], W_.shape()[1]);
         for (size_t i = 0; i < x.shape()[0]; ++i) {
             for (size_t j = 0; j < W_.shape()[1]; ++j) {
@@ -72,32 +63,38 @@ public:
                 for (size_t k = 0; k < W_.shape()[0]; ++k) {
                     sum += x(i, k) * W_(k, j);
                 }
-                output(i, j) = sum + b_(j);
+                output(i, j) = sum + b_[j];
             }
         }
         return output;
     }
 
     /// @brief Retropropagación de gradientes (cálculo de dW y db)
+    /// Omite dW/db si la capa está congelada y dX si nadie necesita el gradiente de la entrada;
+    /// en ese último caso devuelve un tensor vacío.
     Tensor<T, 2> backward(const Tensor<T, 2>& dZ) override {
-        dW_.fill(0);
-        for (size_t i = 0; i < last_x_.shape()[0]; ++i) {
-            for (size_t k = 0; k < last_x_.shape()[1]; ++k) {
-                for (size_t j = 0; j < dZ.shape()[1]; ++j) {
-                    dW_(k, j) += last_x_(i, k) * dZ(i, j);
+        if (!this->frozen_) {
+            dW_.fill(0);
+            for (size_t i = 0; i < last_x_.shape()[0]; ++i) {
+                for (size_t k = 0; k < last_x_.shape()[1]; ++k) {
+                    for (size_t j = 0; j < dZ.shape()[1]; ++j) {
+                        dW_(k, j) += last_x_(i, k) * dZ(i, j);
+                    }
                 }
             }
-        }
 
-        db_.fill(0);
-        for (size_t i = 0; i < dZ.shape()[0]; ++i) {
-            for (size_t j = 0; j < dZ.shape()[1]; ++j) {
-                db_(j) += dZ(i, j);
+            db_.fill(0);
+            for (size_t i = 0; i < dZ.shape()[0]; ++i) {
+                for (size_t j = 0; j < dZ.shape()[1]; ++j) {
+                    db_[j] += dZ(i, j);
+                }
             }
         }
 
+        if (!this->requires_input_grad_) return {};
+
         // Calcular gradiente respecto a la entrada (dX)
-        algebra::Tensor<T, 2> dX(last_x_.shape()[0], last_x_.shape()[1]);
+        algebra::Tensor<T, 2> dX(dZ.shape()[0], W_.shape()[0]);
         for (size_t i = 0; i < dX.shape()[0]; ++i) {
             for (size_t k = 0; k < dX.shape()[1]; ++k) {
                 T sum = 0;
@@ -110,26 +107,16 @@ public:
         return dX;
     }
 
-    /// @brief Aplica el optimizador a los pesos y bias
+    /// @brief Aplica el optimizador a los pesos y bias (nada si la capa está congelada)
     void update_params(IOptimizer<T>& optimizer) override {
+        if (this->frozen_) return;
         optimizer.update(W_, dW_);
-
-        // Convertir bias a 2D para poder aplicar el optimizador
-        algebra::Tensor<T, 2> b2d(1, b_.shape()[0]);
-        algebra::Tensor<T, 2> db2d(1, db_.shape()[0]);
-        for (size_t j = 0; j < b_.shape()[0]; ++j) {
-            b2d(0, j) = b_(j);
-            db2d(0, j) = db_(j);
-        }
-
-        optimizer.update(b2d, db2d);
-
-        // Restaurar bias en forma original
-        for (size_t j = 0; j < b_.shape()[0]; ++j) {
-            b_(j) = b2d(0, j);
-        }
+        optimizer.update(b_, db_);
     }
 
+    /// @brief Una capa densa se entrena salvo que esté congelada
+    bool trainable() const override { return !this->frozen_; }
+
     /// @brief Guarda los pesos y bias a un archivo de texto.
     void save_weights(const std::string& filename) const {
         std::ofstream file(filename);
@@ -146,7 +133,7 @@ public:
 
         // Guardar bias b_
         for (size_t j = 0; j < b_.size(); ++j)
-            file << b_(j) << ' ';
+            file << b_[j] << ' ';
         file << '\n';
 
         file.close();
@@ -173,7 +160,7 @@ public:
 
         // Leer bias b_
         for (size_t j = 0; j < b_.size(); ++j) {
-            if (!(file >> b_(j))) {
+            if (!(file >> b_[j])) {
                 throw std::runtime_error("Error leyendo bias b en " + filename);
             }
         }
@@ -183,6 +170,19 @@ public:
     const Tensor<T, 2>& weights() const {
         return W_;
     }
+    Tensor<T, 2>& weights() { return W_; }
+
+    /// @brief Devuelve una referencia al bias (1 x out_f)
+    const Tensor<T, 2>& bias() const { return b_; }
+    Tensor<T, 2>& bias() { return b_; }
+
+    /// @brief Gradientes acumulados en el último backward
+    Tensor<T, 2>& weights_grad() { return dW_; }
+    Tensor<T, 2>& bias_grad() { return db_; }
+
+    /// @brief Cantidad de entradas y salidas de la capa
+    size_t in_features() const noexcept { return W_.shape()[0]; }
+    size_t out_features() const noexcept { return W_.shape()[1]; }
 };
 
 } // namespace utec::neural_network
@@ -0,0 +1,521 @@
+#ifndef NN_EXECUTION_PLAN_H
+#define NN_EXECUTION_PLAN_H
+
+/**
+ * @file execution_plan.h
+ * @brief Plan de ejecución compilado para `NeuralNetwork`.
+ *
+ * `NeuralNetwork::compile(batch_size)` recorre las capas una sola vez y produce un plan:
+ * - fusiona Dense+ReLU y Dense+Sigmoid en un único paso,
+ * - asigna todas las activaciones y gradientes dentro de una sola arena de memoria,
+ *   reutilizando regiones cuyos tiempos de vida no se solapan,
+ * - elige un kernel de multiplicación según la forma de cada capa densa.
+ *
+ * Luego forward, backward y train solo reproducen el plan: sin despacho virtual por capa
+ * y sin asignar memoria.
+ */
+
+#include "interfaces.h"
+#include "dense.h"
+#include "activation.h"
+#include "telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace utec::neural_network {
+
+/// @brief Tipo de paso dentro de un plan compilado.
+enum class StepKind {
+    Dense,         ///< Capa densa sola
+    DenseReLU,     ///< Dense seguida de ReLU (fusionadas)
+    DenseSigmoid,  ///< Dense seguida de Sigmoid (fusionadas)
+    ReLU,          ///< ReLU sin Dense previa
+    Sigmoid        ///< Sigmoid sin Dense previa
+};
+
+/// @brief Kernel usado para la multiplicación xW de una capa densa.
+enum class DenseKernel {
+    DotIJK,       ///< Producto punto por salida; conviene con pocas salidas
+    BroadcastIKJ  ///< Difunde x(i,k) sobre la fila k de W; vectoriza sobre las salidas
+};
+
+namespace kernels {
+
+/// @brief Epílogo identidad (Dense sin activación).
+struct Identity {
+    template <typename T> T operator()(T z) const { return z; }
+};
+
+/// @brief Epílogo ReLU: max(0, z).
+struct ReluOp {
+    template <typename T> T operator()(T z) const { return z > 0 ? z : 0; }
+};
+
+/// @brief Epílogo Sigmoid: 1 / (1 + e^(-z)), igual que la capa `Sigmoid`.
+struct SigmoidOp {
+    template <typename T> T operator()(T z) const { return 1.0 / (1.0 + std::exp(-z)); }
+};
+
+/// @brief y = act(xW + b), recorriendo i-j-k (una suma por salida).
+template <typename T, typename Act>
+void dense_forward_ijk(const T* x, const T* W, const T* b, T* y,
+                       std::size_t rows, std::size_t in_f, std::size_t out_f, Act act) {
+    for (std::size_t i = 0; i < rows; ++i) {
+        const T* xi = x + i * in_f;
+        T* yi = y + i * out_f;
+        for (std::size_t j = 0; j < out_f; ++j) {
+            T sum = 0;
+            for (std::size_t k = 0; k < in_f; ++k) {
+                sum += xi[k] * W[k * out_f + j];
+            }
+            yi[j] = act(sum + b[j]);
+        }
+    }
+}
+
+/// @brief y = act(xW + b), recorriendo i-k-j (filas de W contiguas en el bucle interno).
+template <typename T, typename Act>
+void dense_forward_ikj(const T* x, const T* W, const T* b, T* y,
+                       std::size_t rows, std::size_t in_f, std::size_t out_f, Act act) {
+    for (std::size_t i = 0; i < rows; ++i) {
+        const T* xi = x + i * in_f;
+        T* yi = y + i * out_f;
+        std::copy(b, b + out_f, yi);
+        for (std::size_t k = 0; k < in_f; ++k) {
+            const T xik = xi[k];
+            const T* wk = W + k * out_f;
+            for (std::size_t j = 0; j < out_f; ++j) {
+                yi[j] += xik * wk[j];
+            }
+        }
+        for (std::size_t j = 0; j < out_f; ++j) {
+            yi[j] = act(yi[j]);
+        }
+    }
+}
+
+/// @brief Gradientes de los parámetros: dW = xᵀ dZ, db = Σ dZ.
+template <typename T>
+void dense_param_grads(const T* x, const T* dZ, T* dW, T* db,
+                       std::size_t rows, std::size_t in_f, std::size_t out_f) {
+    std::fill(dW, dW + in_f * out_f, T(0));
+    std::fill(db, db + out_f, T(0));
+    for (std::size_t i = 0; i < rows; ++i) {
+        const T* xi = x + i * in_f;
+        const T* dzi = dZ + i * out_f;
+        for (std::size_t k = 0; k < in_f; ++k) {
+            const T xik = xi[k];
+            T* dwk = dW + k * out_f;
+            for (std::size_t j = 0; j < out_f; ++j) {
+                dwk[j] += xik * dzi[j];
+            }
+        }
+        for (std::size_t j = 0; j < out_f; ++j) {
+            db[j] += dzi[j];
+        }
+    }
+}
+
+/// @brief Gradientes de una capa densa: si `dW` no es nulo, dW = xᵀ dZ y db = Σ dZ;
+/// si `dX` no es nulo, dX = dZ Wᵀ.
+template <typename T>
+void dense_backward(const T* x, const T* W, const T* dZ, T* dW, T* db, T* dX,
+                    std::size_t rows, std::size_t in_f, std::size_t out_f) {
+    if (dW) dense_param_grads(x, dZ, dW, db, rows, in_f, out_f);
+    if (!dX) return;
+    for (std::size_t i = 0; i < rows; ++i) {
+        const T* dzi = dZ + i * out_f;
+        T* dxi = dX + i * in_f;
+        for (std::size_t k = 0; k < in_f; ++k) {
+            const T* wk = W + k * out_f;
+            T sum = 0;
+            for (std::size_t j = 0; j < out_f; ++j) {
+                sum += dzi[j] * wk[j];
+            }
+            dxi[k] = sum;
+        }
+    }
+}
+
+} // namespace kernels
+
+/// @brief Plan de ejecución compilado a partir de las capas de una red.
+///
+/// Las activaciones A_0 (entrada) ... A_s (salida) y los gradientes G_1 ... G_s viven en
+/// una sola arena. Cada buffer tiene un intervalo de vida sobre la línea de tiempo
+/// forward (pasos 0..s-1) seguida de backward (pasos s..2s-1); el planificador coloca
+/// primero los buffers más grandes en el menor desplazamiento que no choque con otro buffer
+/// vivo al mismo tiempo. La inferencia (`predict`) usa una segunda disposición donde cada
+/// activación muere apenas la consume el paso siguiente.
+template <typename T>
+class ExecutionPlan {
+public:
+    /// @brief Paso del plan: una capa, o dos si fueron fusionadas.
+    struct Step {
+        StepKind kind;
+        DenseKernel kernel = DenseKernel::DotIJK;
+        Dense<T>* dense = nullptr;   ///< Capa densa del paso (nula en activaciones sueltas)
+        std::size_t in_f = 0;        ///< Ancho de la entrada
+        std::size_t out_f = 0;       ///< Ancho de la salida
+        std::size_t first_layer = 0; ///< Índice de la primera capa original cubierta
+        std::size_t layer_count = 1; ///< Capas originales cubiertas (2 si hay fusión)
+    };
+
+    /// @brief Compila las capas para lotes de hasta `batch_size` filas.
+    /// @throws std::invalid_argument Si hay capas no soportadas o anchos incompatibles
+    ExecutionPlan(const std::vector<std::unique_ptr<ILayer<T>>>& layers, std::size_t batch_size)
+        : batch_size_(batch_size) {
+        if (batch_size_ == 0)
+            throw std::invalid_argument("compile: batch_size debe ser mayor que cero");
+        build_steps(layers);
+        plan_memory();
+    }
+
+    std::size_t batch_size() const noexcept { return batch_size_; }
+    std::size_t input_features() const noexcept { return widths_.front(); }
+    std::size_t output_features() const noexcept { return widths_.back(); }
+    const std::vector<Step>& steps() const noexcept { return steps_; }
+
+    /// @brief Activa (o desactiva con nullptr) la medición de tiempos por paso
+    void set_telemetry(TrainingTelemetry* telemetry) noexcept { telemetry_ = telemetry; }
+
+    /// @brief Nombre de cada paso, en el orden usado por la telemetría
+    std::vector<std::string> step_names() const {
+        std::vector<std::string> names;
+        for (const auto& st : steps_)
+            names.push_back(std::string(step_name(st.kind)) + "(" + std::to_string(st.in_f) + "->"
+                            + std::to_string(st.out_f) + ")");
+        return names;
+    }
+
+    /// @brief Elementos reservados en la arena (ya con reutilización por tiempo de vida)
+    std::size_t arena_size() const noexcept { return arena_.size(); }
+
+    /// @brief Elementos que ocuparían los mismos buffers sin reutilización
+    std::size_t unplanned_size() const noexcept { return unplanned_size_; }
+
+    /// @brief Forward de entrenamiento: conserva lo necesario para el backward.
+    /// @param x Entrada de `rows` x input_features() elementos contiguos
+    /// @return Puntero a la salida (rows x output_features()), válido hasta el próximo forward
+    const T* forward(const T* x, std::size_t rows) {
+        check_rows(rows);
+        T* a0 = arena_.data() + act_train_[0];
+        std::copy(x, x + rows * widths_[0], a0);
+        for (std::size_t k = 0; k < steps_.size(); ++k) {
+            ScopedPhase phase(telemetry_, k, Phase::Forward);
+            run_forward(steps_[k], arena_.data() + act_train_[k],
+                        arena_.data() + act_train_[k + 1], rows);
+        }
+        rows_ = rows;
+        return arena_.data() + act_train_.back();
+    }
+
+    /// @brief Forward de inferencia: usa la disposición compacta, no sirve para backward.
+    const T* predict(const T* x, std::size_t rows) {
+        check_rows(rows);
+        T* a0 = arena_.data() + act_infer_[0];
+        std::copy(x, x + rows * widths_[0], a0);
+        for (std::size_t k = 0; k < steps_.size(); ++k) {
+            run_forward(steps_[k], arena_.data() + act_infer_[k],
+                        arena_.data() + act_infer_[k + 1], rows);
+        }
+        rows_ = 0;
+        return arena_.data() + act_infer_.back();
+    }
+
+    /// @brief Buffer donde se escribe dL/dY antes de llamar a backward()
+    T* output_grad() noexcept { return arena_.data() + grad_[steps_.size()]; }
+
+    /// @brief Retropropaga el gradiente que ya está en output_grad().
+    /// Omite dW/db de las capas congeladas y se detiene en la capa entrenable más baja.
+    void backward() {
+        if (rows_ == 0)
+            throw std::logic_error("backward: no hay un forward de entrenamiento previo");
+        // Por debajo del paso entrenable más bajo no hace falta propagar nada
+        std::size_t lowest = steps_.size();
+        for (std::size_t k = 0; k < steps_.size(); ++k) {
+            if (steps_[k].dense && steps_[k].dense->trainable()) { lowest = k; break; }
+        }
+        for (std::size_t k = steps_.size(); k-- > lowest;) {
+            ScopedPhase phase(telemetry_, k, Phase::Backward);
+            T* dx = k > lowest ? arena_.data() + grad_[k] : nullptr;
+            run_backward(steps_[k], arena_.data() + act_train_[k],
+                         arena_.data() + act_train_[k + 1],
+                         arena_.data() + grad_[k + 1], dx, rows_);
+        }
+    }
+
+    /// @brief Copia `grad` en output_grad() y retropropaga.
+    void backward(const T* grad) {
+        std::copy(grad, grad + rows_ * widths_.back(), output_grad());
+        backward();
+    }
+
+    /// @brief Aplica el optimizador a las capas densas no congeladas del plan.
+    void update_params(IOptimizer<T>& optimizer) {
+        for (std::size_t k = 0; k < steps_.size(); ++k) {
+            if (!steps_[k].dense || !steps_[k].dense->trainable()) continue;
+            ScopedPhase phase(telemetry_, k, Phase::Update);
+            steps_[k].dense->update_params(optimizer);
+        }
+    }
+
+    /// @brief Resumen legible: pasos, kernels y tamaño de la arena.
+    std::string describe() const {
+        std::ostringstream os;
+        os << "Plan compilado (batch " << batch_size_ << ")\n";
+        for (std::size_t k = 0; k < steps_.size(); ++k) {
+            const auto& st = steps_[k];
+            os << "  [" << k << "] " << step_name(st.kind) << ' '
+               << st.in_f << "->" << st.out_f;
+            if (st.dense)
+                os << " kernel=" << (st.kernel == DenseKernel::BroadcastIKJ ? "ikj" : "ijk");
+            os << '\n';
+        }
+        os << "  Arena: " << arena_.size() << " elementos (sin reutilizar: "
+           << unplanned_size_ << ")";
+        return os.str();
+    }
+
+    /// @brief Nombre corto de un tipo de paso
+    static const char* step_name(StepKind kind) {
+        switch (kind) {
+            case StepKind::Dense: return "Dense";
+            case StepKind::DenseReLU: return "Dense+ReLU";
+            case StepKind::DenseSigmoid: return "Dense+Sigmoid";
+            case StepKind::ReLU: return "ReLU";
+            case StepKind::Sigmoid: return "Sigmoid";
+        }
+        return "?";
+    }
+
+private:
+    /// @brief Buffer lógico con su intervalo de vida [first, last] y desplazamiento asignado
+    struct Buffer {
+        std::size_t size;
+        std::size_t first;
+        std::size_t last;
+        std::size_t offset = 0;
+    };
+
+    static constexpr std::size_t kAlign = 16; ///< Alineación de cada buffer (en elementos)
+
+    std::size_t batch_size_;
+    std::size_t rows_ = 0;               ///< Filas del último forward de entrenamiento
+    std::vector<Step> steps_;
+    std::vector<std::size_t> widths_;    ///< Ancho de A_0 ... A_s
+    std::vector<std::size_t> act_train_; ///< Desplazamiento de A_k en entrenamiento
+    std::vector<std::size_t> act_infer_; ///< Desplazamiento de A_k en inferencia
+    std::vector<std::size_t> grad_;      ///< Desplazamiento de G_k (G_0 no se usa)
+    std::vector<T> arena_;
+    std::size_t unplanned_size_ = 0;
+    TrainingTelemetry* telemetry_ = nullptr;
+
+    void check_rows(std::size_t rows) const {
+        if (rows == 0 || rows > batch_size_)
+            throw std::invalid_argument("ExecutionPlan: lote fuera del tamaño compilado");
+    }
+
+    static bool uses_input(StepKind kind) {
+        return kind == StepKind::Dense || kind == StepKind::DenseReLU || kind == StepKind::DenseSigmoid;
+    }
+
+    static bool uses_output(StepKind kind) { return kind != StepKind::Dense; }
+
+    /// @brief Kernel según la forma: ikj vectoriza sobre las salidas y compensa con capas anchas
+    static DenseKernel select_kernel(std::size_t in_f, std::size_t out_f) {
+        return (out_f >= 8 && in_f >= 2) ? DenseKernel::BroadcastIKJ : DenseKernel::DotIJK;
+    }
+
+    void build_steps(const std::vector<std::unique_ptr<ILayer<T>>>& layers) {
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            ILayer<T>* layer = layers[i].get();
+            Step step{};
+            step.first_layer = i;
+
+            if (auto* dense = dynamic_cast<Dense<T>*>(layer)) {
+                step.dense = dense;
+                step.in_f = dense->in_features();
+                step.out_f = dense->out_features();
+                step.kernel = select_kernel(step.in_f, step.out_f);
+                step.kind = StepKind::Dense;
+
+                ILayer<T>* next = i + 1 < layers.size() ? layers[i + 1].get() : nullptr;
+                if (dynamic_cast<ReLU<T>*>(next)) {
+                    step.kind = StepKind::DenseReLU;
+                } else if (dynamic_cast<Sigmoid<T>*>(next)) {
+                    step.kind = StepKind::DenseSigmoid;
+                }
+                if (step.kind != StepKind::Dense) {
+                    step.layer_count = 2;
+                    ++i;
+                }
+            } else if (dynamic_cast<ReLU<T>*>(layer)) {
+                step.kind = StepKind::ReLU;
+            } else if (dynamic_cast<Sigmoid<T>*>(layer)) {
+                step.kind = StepKind::Sigmoid;
+            } else {
+                throw std::invalid_argument("compile: capa no soportada en la posición " + std::to_string(i));
+            }
+            steps_.push_back(step);
+        }
+        if (steps_.empty())
+            throw std::invalid_argument("compile: la red no tiene capas");
+
+        // Las activaciones sueltas heredan el ancho de la capa densa más cercana
+        auto first_dense = std::find_if(steps_.begin(), steps_.end(),
+                                        [](const Step& s) { return s.dense != nullptr; });
+        if (first_dense == steps_.end())
+            throw std::invalid_argument("compile: se necesita al menos una capa Dense para inferir anchos");
+
+        std::size_t width = first_dense->in_f;
+        widths_.push_back(width);
+        for (auto& step : steps_) {
+            if (step.dense) {
+                if (step.in_f != width)
+                    throw std::invalid_argument("compile: anchos incompatibles entre capas consecutivas");
+            } else {
+                step.in_f = step.out_f = width;
+            }
+            width = step.out_f;
+            widths_.push_back(width);
+        }
+    }
+
+    static std::size_t aligned(std::size_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+    /// @brief Asignación voraz por tamaño: cada buffer toma el menor desplazamiento libre
+    /// entre los buffers ya ubicados cuyo intervalo de vida se solapa con el suyo.
+    static std::size_t assign_offsets(std::vector<Buffer>& buffers) {
+        std::vector<std::size_t> order(buffers.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return buffers[a].size > buffers[b].size; });
+
+        std::vector<std::size_t> placed;
+        std::size_t total = 0;
+        for (std::size_t idx : order) {
+            Buffer& buf = buffers[idx];
+            std::vector<const Buffer*> live;
+            for (std::size_t p : placed) {
+                const Buffer& other = buffers[p];
+                if (other.first <= buf.last && buf.first <= other.last) live.push_back(&other);
+            }
+            std::sort(live.begin(), live.end(),
+                      [](const Buffer* a, const Buffer* b) { return a->offset < b->offset; });
+
+            std::size_t offset = 0;
+            for (const Buffer* other : live) {
+                if (offset + buf.size <= other->offset) break;
+                offset = std::max(offset, other->offset + other->size);
+            }
+            buf.offset = offset;
+            total = std::max(total, offset + buf.size);
+            placed.push_back(idx);
+        }
+        return total;
+    }
+
+    void plan_memory() {
+        const std::size_t s = steps_.size();
+        auto bwd = [s](std::size_t k) { return 2 * s - 1 - k; };
+
+        // Disposición de entrenamiento: A_0..A_s y luego G_1..G_s
+        std::vector<Buffer> train;
+        for (std::size_t k = 0; k <= s; ++k) {
+            Buffer buf{aligned(batch_size_ * widths_[k]), k == 0 ? 0 : k - 1, 0};
+            std::size_t last = buf.first;
+            if (k < s) last = std::max(last, k);                            // lo consume el forward k
+            if (k < s && uses_input(steps_[k].kind)) last = std::max(last, bwd(k));
+            if (k > 0 && uses_output(steps_[k - 1].kind)) last = std::max(last, bwd(k - 1));
+            if (k == s) last = std::max(last, s);                           // la lee la pérdida
+            buf.last = last;
+            train.push_back(buf);
+        }
+        for (std::size_t k = 1; k <= s; ++k) {
+            std::size_t first = k == s ? s : bwd(k);
+            train.push_back({aligned(batch_size_ * widths_[k]), first, bwd(k - 1)});
+        }
+
+        // Disposición de inferencia: cada activación vive solo entre su productor y su consumidor
+        std::vector<Buffer> infer;
+        for (std::size_t k = 0; k <= s; ++k) {
+            std::size_t first = k == 0 ? 0 : k - 1;
+            infer.push_back({aligned(batch_size_ * widths_[k]), first, std::min(k, s)});
+        }
+
+        unplanned_size_ = 0;
+        for (const auto& b : train) unplanned_size_ += b.size;
+
+        const std::size_t train_size = assign_offsets(train);
+        const std::size_t infer_size = assign_offsets(infer);
+        arena_.assign(std::max(train_size, infer_size), T(0));
+
+        act_train_.clear();
+        act_infer_.clear();
+        grad_.assign(s + 1, 0);
+        for (std::size_t k = 0; k <= s; ++k) {
+            act_train_.push_back(train[k].offset);
+            act_infer_.push_back(infer[k].offset);
+        }
+        for (std::size_t k = 1; k <= s; ++k) grad_[k] = train[s + k].offset;
+    }
+
+    template <typename Act>
+    static void dense_forward(const Step& st, const T* x, T* y, std::size_t rows, Act act) {
+        const T* W = st.dense->weights().data();
+        const T* b = st.dense->bias().data();
+        if (st.kernel == DenseKernel::BroadcastIKJ)
+            kernels::dense_forward_ikj(x, W, b, y, rows, st.in_f, st.out_f, act);
+        else
+            kernels::dense_forward_ijk(x, W, b, y, rows, st.in_f, st.out_f, act);
+    }
+
+    static void run_forward(const Step& st, const T* x, T* y, std::size_t rows) {
+        const std::size_t n = rows * st.out_f;
+        switch (st.kind) {
+            case StepKind::Dense: dense_forward(st, x, y, rows, kernels::Identity{}); break;
+            case StepKind::DenseReLU: dense_forward(st, x, y, rows, kernels::ReluOp{}); break;
+            case StepKind::DenseSigmoid: dense_forward(st, x, y, rows, kernels::SigmoidOp{}); break;
+            case StepKind::ReLU:
+                for (std::size_t i = 0; i < n; ++i) y[i] = kernels::ReluOp{}(x[i]);
+                break;
+            case StepKind::Sigmoid:
+                for (std::size_t i = 0; i < n; ++i) y[i] = kernels::SigmoidOp{}(x[i]);
+                break;
+        }
+    }
+
+    /// @brief Backward de un paso. `g` (dL/dy) se modifica en su lugar al aplicar la
+    /// derivada de la activación; `dx` puede ser nulo si nadie necesita dL/dx.
+    static void run_backward(const Step& st, const T* x, const T* y, T* g, T* dx, std::size_t rows) {
+        const std::size_t n = rows * st.out_f;
+        if (st.kind == StepKind::DenseReLU || st.kind == StepKind::ReLU) {
+            for (std::size_t i = 0; i < n; ++i) g[i] = y[i] > 0 ? g[i] : 0;
+        } else if (st.kind == StepKind::DenseSigmoid || st.kind == StepKind::Sigmoid) {
+            for (std::size_t i = 0; i < n; ++i) g[i] = g[i] * y[i] * (1 - y[i]);
+        }
+
+        if (st.dense) {
+            const bool params = st.dense->trainable();
+            kernels::dense_backward(x, st.dense->weights().data(), g,
+                                    params ? st.dense->weights_grad().data() : nullptr,
+                                    params ? st.dense->bias_grad().data() : nullptr,
+                                    dx, rows, st.in_f, st.out_f);
+        } else if (dx) {
+            std::copy(g, g + n, dx);
+        }
+    }
+};
+
+} // namespace utec::neural_network
+
+#endif // NN_EXECUTION_PLAN_H
@@ -31,6 +31,23 @@ public:
     /// @brief Actualiza los parámetros de la capa usando un optimizador
     /// @param optimizer Optimizer que aplica la actualización
     virtual void update_params(IOptimizer<T>& optimizer) = 0;
+
+    /// @brief Congela o descongela los parámetros: una capa congelada no calcula dW/db
+    /// ni se actualiza, pero puede seguir propagando el gradiente hacia atrás.
+    virtual void set_frozen(bool frozen) { frozen_ = frozen; }
+    bool frozen() const noexcept { return frozen_; }
+
+    /// @brief Indica si alguien usará el gradiente respecto a la entrada (dX).
+    /// Si es false, backward puede omitir ese cálculo y devolver un tensor vacío.
+    virtual void set_requires_input_grad(bool required) { requires_input_grad_ = required; }
+    bool requires_input_grad() const noexcept { return requires_input_grad_; }
+
+    /// @brief true si la capa tiene parámetros que se entrenan (existen y no están congelados)
+    virtual bool trainable() const { return false; }
+
+protected:
+    bool frozen_ = false;               ///< Parámetros congelados
+    bool requires_input_grad_ = true;   ///< Se necesita dX en el backward
 };
 
 
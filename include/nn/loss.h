@@ -46,6 +46,22 @@ public:
         }
         return grad;
     }
+
+    /// @brief Pérdida y gradiente en una sola pasada, sin asignar memoria.
+    /// Usada por el plan compilado de `NeuralNetwork`; mismas fórmulas que loss() y loss_gradient().
+    /// @param y_pred Predicciones (n elementos contiguos)
+    /// @param y_true Valores verdaderos (n elementos contiguos)
+    /// @param grad Destino del gradiente (n elementos)
+    /// @return Error cuadrático medio
+    static T loss_and_gradient(const T* y_pred, const T* y_true, T* grad, std::size_t n) {
+        T total_loss = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            T diff = y_pred[i] - y_true[i];
+            total_loss += diff * diff;
+            grad[i] = 2 * diff / n;
+        }
+        return total_loss / n;
+    }
 };
 
 
@@ -94,6 +110,20 @@ public:
         }
         return grad;
     }
+
+    /// @brief Pérdida y gradiente en una sola pasada, sin asignar memoria.
+    /// Ver MSELoss::loss_and_gradient.
+    static T loss_and_gradient(const T* y_pred, const T* y_true, T* grad, std::size_t n) {
+        const T eps = static_cast<T>(1e-12);
+        T total_loss = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            T y_p = std::max(eps, std::min(1 - eps, y_pred[i]));
+            T y_t = y_true[i];
+            total_loss += - (y_t * std::log(y_p) + (1 - y_t) * std::log(1 - y_p));
+            grad[i] = (y_p - y_t) / (y_p * (1 - y_p) * n);
+        }
+        return total_loss / n;
+    }
 };
 
 } // namespace utec::neural_network
@@ -3,13 +3,24 @@
 
 #include "interfaces.h"
 #include "loss.h"
+#include <concepts>
 #include <memory>
 #include <vector>
 #include <iostream>
 #include "optimizer.h"
+#include "execution_plan.h"
+#include "telemetry.h"
 
 namespace utec::neural_network {
 
+/// @brief Flujo de lotes para NeuralNetwork::train: `reset()` empieza una pasada y
+/// `next_batch(X, Y, n)` deja hasta n filas en X e Y y devuelve cuántas (0 al terminar).
+template <typename S, typename T>
+concept BatchStream = requires(S& stream, Tensor<T, 2>& X, Tensor<T, 2>& Y, size_t rows) {
+    stream.reset();
+    { stream.next_batch(X, Y, rows) } -> std::convertible_to<size_t>;
+};
+
 /// @brief Clase principal para construir, entrenar y usar una red neuronal.
 /// Permite añadir capas, ejecutar el paso forward, backpropagation y entrenamiento completo.
 template <typename T>
@@ -17,48 +28,199 @@ class NeuralNetwork {
 private:
     std::vector<std::unique_ptr<ILayer<T>>> layers_;  ///< Capas de la red
     bool verbose_ = false;                            ///< Imprimir progreso de entrenamiento
+    std::unique_ptr<ExecutionPlan<T>> plan_;          ///< Plan compilado (nulo si no se compiló)
+    bool planned_forward_ = false;                    ///< El último forward usó el plan
+    TrainingTelemetry* telemetry_ = nullptr;          ///< Telemetría opcional (no es dueña)
+    size_t lowest_trainable_ = 0;                     ///< Capa entrenable más baja del último forward
+
+    /// @brief Nombre legible de una capa para la telemetría
+    static std::string layer_name(const ILayer<T>* layer) {
+        if (auto* d = dynamic_cast<const Dense<T>*>(layer))
+            return "Dense(" + std::to_string(d->in_features()) + "->" + std::to_string(d->out_features()) + ")";
+        if (dynamic_cast<const ReLU<T>*>(layer)) return "ReLU";
+        if (dynamic_cast<const Sigmoid<T>*>(layer)) return "Sigmoid";
+        return "Layer";
+    }
+
+    /// @brief Marca qué capas necesitan dX: solo las que tienen alguna capa entrenable debajo.
+    /// @return Índice de la capa entrenable más baja (layers_.size() si no hay ninguna)
+    size_t update_grad_requirements() {
+        size_t lowest = layers_.size();
+        for (size_t i = 0; i < layers_.size(); ++i) {
+            layers_[i]->set_requires_input_grad(lowest < i);
+            if (lowest == layers_.size() && layers_[i]->trainable()) lowest = i;
+        }
+        return lowest;
+    }
+
+    /// @brief Indica si un lote de entrada puede ejecutarse con el plan compilado
+    bool fits_plan(const Tensor<T, 2>& x) const {
+        return plan_ && x.shape()[0] > 0 && x.shape()[0] <= plan_->batch_size()
+               && x.shape()[1] == plan_->input_features();
+    }
+
+    /// @brief Copia la salida del plan en `out`; solo reserva memoria si cambia la forma
+    void copy_plan_output(const T* y, size_t rows, Tensor<T, 2>& out) const {
+        if (out.shape()[0] != rows || out.shape()[1] != plan_->output_features())
+            out = Tensor<T, 2>(rows, plan_->output_features());
+        std::copy(y, y + out.size(), out.data());
+    }
+
+    /// @brief Paso de entrenamiento con el plan: forward, pérdida, backward y actualización
+    /// sobre las filas [start, end) de X e Y, sin asignar memoria.
+    template <template <typename> class LossType>
+    T planned_step(const Tensor<T,2>& X, const Tensor<T,2>& Y,
+                   size_t start, size_t end, IOptimizer<T>& optimizer) {
+        const size_t rows = end - start;
+        const size_t n = rows * plan_->output_features();
+        const T* y_pred = plan_->forward(X.data() + start * X.shape()[1], rows);
+        const T* y_true = Y.data() + start * Y.shape()[1];
+        T* grad = plan_->output_grad();
+
+        T loss;
+        if constexpr (requires { LossType<T>::loss_and_gradient(y_pred, y_true, grad, n); }) {
+            loss = LossType<T>::loss_and_gradient(y_pred, y_true, grad, n);
+        } else {
+            // Pérdidas sin versión fusionada: se construyen los tensores (asigna memoria)
+            Tensor<T, 2> pred(rows, plan_->output_features());
+            std::copy(y_pred, y_pred + n, pred.data());
+            LossType<T> loss_func(pred, Y.slice(start, end));
+            loss = loss_func.loss();
+            auto g = loss_func.loss_gradient();
+            std::copy(g.data(), g.data() + n, grad);
+        }
+
+        plan_->backward();
+        plan_->update_params(optimizer);
+        return loss;
+    }
+
+    /// @brief Conecta la telemetría al plan (si se usa) y abre la corrida de entrenamiento
+    void begin_telemetry_run(bool use_plan) {
+        if (plan_) plan_->set_telemetry(use_plan ? telemetry_ : nullptr);
+        if (!telemetry_) return;
+        std::vector<std::string> names;
+        if (use_plan) {
+            names = plan_->step_names();
+        } else {
+            for (const auto& layer : layers_) names.push_back(layer_name(layer.get()));
+        }
+        telemetry_->begin_run("NeuralNetwork::train", std::move(names));
+    }
 
 public:
     /// @brief Añade una nueva capa a la red
     /// @param layer Puntero a la capa a añadir
+    /// @note Invalida el plan compilado, si existía
     void add_layer(std::unique_ptr<ILayer<T>> layer) {
         layers_.push_back(std::move(layer));
+        plan_.reset();
+        planned_forward_ = false;
+    }
+
+    /// @brief Compila la red para lotes de hasta `batch_size` filas.
+    /// Fusiona Dense+ReLU y Dense+Sigmoid, planifica una arena única para activaciones y
+    /// gradientes y elige un kernel por capa. Después, forward, backward, predict y train
+    /// reutilizan el plan mientras el lote no supere `batch_size`.
+    /// @throws std::invalid_argument Si alguna capa no es Dense, ReLU o Sigmoid
+    void compile(size_t batch_size) {
+        plan_ = std::make_unique<ExecutionPlan<T>>(layers_, batch_size);
+        planned_forward_ = false;
+    }
+
+    /// @brief Congela (o descongela) los parámetros de la capa `index`.
+    /// Una capa congelada no calcula dW/db ni se actualiza; el backward se detiene en la
+    /// capa entrenable más baja, así que congelar las primeras capas también evita sus dX.
+    /// @throws std::out_of_range Si el índice no existe
+    void freeze_layer(size_t index, bool frozen = true) {
+        layers_.at(index)->set_frozen(frozen);
+        update_grad_requirements();
     }
 
+    /// @brief Capa en la posición `index`
+    /// @throws std::out_of_range Si el índice no existe
+    ILayer<T>& layer(size_t index) { return *layers_.at(index); }
+
+    /// @brief Cantidad de capas
+    size_t size() const noexcept { return layers_.size(); }
+
+    /// @brief Activa la telemetría de entrenamiento (nullptr la desactiva).
+    /// La red no toma posesión del objeto; con nullptr no se mide nada.
+    void set_telemetry(TrainingTelemetry* telemetry) noexcept { telemetry_ = telemetry; }
+
+    /// @brief Plan compilado actual (nulo si la red no fue compilada)
+    const ExecutionPlan<T>* plan() const noexcept { return plan_.get(); }
+
     /// @brief Activa o desactiva la salida en consola durante el entrenamiento
     /// @param verbose Si es true, se imprime la pérdida cada 100 épocas
     void set_verbose(bool verbose) { verbose_ = verbose; }
 
     /// @brief Propagación hacia adelante de la red completa
+    /// Con un plan compilado el resultado se copia desde la arena a un Tensor nuevo en cada
+    /// llamada; para no reservar memoria por paso, usar forward(x, out).
     /// @param x Entrada inicial a la red
     /// @return Salida final después de pasar por todas las capas
     Tensor<T, 2> forward(const Tensor<T, 2>& x) {
+        if (fits_plan(x)) {
+            Tensor<T, 2> result;
+            forward(x, result);
+            return result;
+        }
+
+        planned_forward_ = false;
+        // Se recalcula en cada paso por si alguna capa se congeló directamente con layer(i)
+        lowest_trainable_ = update_grad_requirements();
         Tensor<T, 2> output = x;
-        for (auto& layer : layers_) {
-            output = layer->forward(output);
+        for (size_t i = 0; i < layers_.size(); ++i) {
+            ScopedPhase phase(telemetry_, i, Phase::Forward);
+            output = layers_[i]->forward(output);
         }
         return output;
     }
 
+    /// @brief Forward que escribe la salida en `out`.
+    /// Con un plan compilado `out` se reutiliza si ya tiene la forma del resultado, así que
+    /// repetir la llamada con el mismo tamaño de lote no reserva memoria; sin plan equivale a
+    /// `out = forward(x)`.
+    /// @param x Entrada inicial a la red
+    /// @param out Salida (rows x salidas de la última capa)
+    void forward(const Tensor<T, 2>& x, Tensor<T, 2>& out) {
+        if (!fits_plan(x)) {
+            out = forward(x);
+            return;
+        }
+        copy_plan_output(plan_->forward(x.data(), x.shape()[0]), x.shape()[0], out);
+        planned_forward_ = true;
+    }
+
     /// @brief Propagación hacia atrás de los gradientes
     /// @param grad Gradiente desde la función de pérdida
     void backward(const Tensor<T, 2>& grad) {
+        if (planned_forward_) {
+            plan_->backward(grad.data());
+            return;
+        }
+
         Tensor<T, 2> current_grad = grad;
-        for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
-            current_grad = (*it)->backward(current_grad);
+        for (size_t i = layers_.size(); i-- > lowest_trainable_;) {
+            ScopedPhase phase(telemetry_, i, Phase::Backward);
+            current_grad = layers_[i]->backward(current_grad);
         }
     }
 
     /// @brief Actualiza los parámetros de todas las capas usando un optimizador
     /// @param optimizer Optimizador que aplica la actualización
     void update_params(IOptimizer<T>& optimizer) {
-        for (auto& layer : layers_) {
-            layer->update_params(optimizer);
+        for (size_t i = 0; i < layers_.size(); ++i) {
+            if (!layers_[i]->trainable()) continue;
+            ScopedPhase phase(telemetry_, i, Phase::Update);
+            layers_[i]->update_params(optimizer);
         }
     }
 
     /// @brief Entrena la red usando un dataset dado, función de pérdida y optimizador
     /// Usa mini-batch training y retropropagación. Muestra la pérdida si verbose está activo.
+    /// Si la red fue compilada con un lote >= batch_size, cada paso reproduce el plan.
     /// @tparam LossType Tipo de función de pérdida (por ejemplo, MSELoss)
     /// @tparam OptimizerType Tipo de optimizador (por ejemplo, SGD o Adam)
     /// @param X Datos de entrada
@@ -73,13 +235,27 @@ public:
 
         OptimizerType<T> optimizer(learning_rate);
         const size_t num_batches = (X.shape()[0] + batch_size - 1) / batch_size;
+        const bool use_plan = plan_ && batch_size <= plan_->batch_size()
+                              && X.shape()[1] == plan_->input_features()
+                              && Y.shape()[1] == plan_->output_features();
+        planned_forward_ = false;
+
+        begin_telemetry_run(use_plan);
 
         for (size_t epoch = 0; epoch < epochs; ++epoch) {
             T total_loss = 0;
+            if (telemetry_) telemetry_->begin_epoch(epoch);
 
             for (size_t batch = 0; batch < num_batches; ++batch) {
                 const size_t start = batch * batch_size;
                 const size_t end = std::min(start + batch_size, X.shape()[0]);
+                if (telemetry_) telemetry_->begin_step();
+
+                if (use_plan) {
+                    total_loss += planned_step<LossType>(X, Y, start, end, optimizer);
+                    if (telemetry_) telemetry_->end_step(end - start);
+                    continue;
+                }
 
                 auto X_batch = X.slice(start, end);
                 auto Y_batch = Y.slice(start, end);
@@ -93,21 +269,93 @@ public:
                 auto grad = loss_func.loss_gradient();
                 backward(grad);
                 update_params(optimizer);
+                if (telemetry_) telemetry_->end_step(end - start);
             }
 
+            if (telemetry_) telemetry_->end_epoch(total_loss / num_batches);
+
             // Imprime la pérdida si verbose está activo y es una época múltiplo de 100
             if (verbose_ && epoch % 100 == 0) {
                 std::cout << "Epoch " << epoch << ", Loss: "
                           << total_loss / num_batches << std::endl;
             }
         }
+
+        if (telemetry_) telemetry_->end_run();
+    }
+
+    /// @brief Entrena leyendo los lotes de un flujo, sin tener el dataset completo en memoria.
+    /// Cada época llama `stream.reset()` y consume lotes hasta que `next_batch` devuelve 0
+    /// (por ejemplo, un SampleStream sobre un CSV más grande que la RAM).
+    /// @param stream Flujo de lotes (ver BatchStream)
+    /// @param epochs Número de épocas
+    /// @param batch_size Filas máximas por lote
+    /// @param learning_rate Tasa de aprendizaje
+    template <template <typename> class LossType,
+              template <typename> class OptimizerType = SGD, typename Stream>
+        requires BatchStream<Stream, T>
+    void train(Stream& stream, const size_t epochs, const size_t batch_size, T learning_rate) {
+        OptimizerType<T> optimizer(learning_rate);
+        const bool use_plan = plan_ && batch_size <= plan_->batch_size();
+        planned_forward_ = false;
+        begin_telemetry_run(use_plan);
+
+        Tensor<T, 2> X, Y;
+        for (size_t epoch = 0; epoch < epochs; ++epoch) {
+            T total_loss = 0;
+            size_t num_batches = 0;
+            if (telemetry_) telemetry_->begin_epoch(epoch);
+            stream.reset();
+
+            while (true) {
+                if (telemetry_) telemetry_->begin_step();
+                const size_t rows = stream.next_batch(X, Y, batch_size);
+                if (rows == 0) break;
+                ++num_batches;
+
+                if (use_plan && X.shape()[1] == plan_->input_features()
+                    && Y.shape()[1] == plan_->output_features()) {
+                    total_loss += planned_step<LossType>(X, Y, 0, rows, optimizer);
+                } else {
+                    auto Y_pred = forward(X);
+                    LossType<T> loss_func(Y_pred, Y);
+                    total_loss += loss_func.loss();
+                    backward(loss_func.loss_gradient());
+                    update_params(optimizer);
+                }
+                if (telemetry_) telemetry_->end_step(rows);
+            }
+
+            const T epoch_loss = num_batches ? total_loss / num_batches : T(0);
+            if (telemetry_) telemetry_->end_epoch(epoch_loss);
+            if (verbose_ && epoch % 100 == 0) {
+                std::cout << "Epoch " << epoch << ", Loss: " << epoch_loss << std::endl;
+            }
+        }
+
+        if (telemetry_) telemetry_->end_run();
     }
 
     /// @brief Realiza predicción (forward pass) sin modificar parámetros
+    /// Como forward(x), devuelve un Tensor nuevo en cada llamada; predict(X, out) no reserva.
     /// @param X Entrada a la red
     /// @return Salida producida por la red
     Tensor<T,2> predict(const Tensor<T,2>& X) {
-        return forward(X);
+        Tensor<T, 2> result;
+        predict(X, result);
+        return result;
+    }
+
+    /// @brief Predicción que escribe en `out`, reutilizándolo si ya tiene la forma del resultado
+    /// @param X Entrada a la red
+    /// @param out Salida producida por la red
+    void predict(const Tensor<T,2>& X, Tensor<T,2>& out) {
+        if (!fits_plan(X)) {
+            out = forward(X);
+            return;
+        }
+        copy_plan_output(plan_->predict(X.data(), X.shape()[0]), X.shape()[0], out);
+        planned_forward_ = false;
     }
 };
 
@@ -3,6 +3,7 @@
 
 #include "interfaces.h"
 #include <cmath>
+#include <unordered_map>
 
 namespace utec::neural_network {
 
@@ -36,50 +37,58 @@ public:
 /// @brief Optimizador Adam (Adaptive Moment Estimation).
 /// Combina ventajas de AdaGrad y RMSProp. Utiliza promedios móviles de primer y segundo orden
 /// para adaptar la tasa de aprendizaje por parámetro.
+/// Los momentos se guardan por tensor de parámetros (identificado por su dirección), de modo
+/// que un mismo optimizador puede actualizar pesos y bias de varias capas.
 template <typename T>
 class Adam final : public IOptimizer<T> {
 private:
+    /// @brief Estado de Adam para un tensor de parámetros
+    struct Moments {
+        std::size_t t = 0;  ///< Contador de iteraciones
+        Tensor<T,2> m;      ///< Promedio móvil de primer orden (momentum)
+        Tensor<T,2> v;      ///< Promedio móvil de segundo orden (varianza)
+    };
+
     T learning_rate_; ///< Tasa de aprendizaje
     T beta1_;         ///< Coeficiente para el promedio móvil de primer orden (momento)
     T beta2_;         ///< Coeficiente para el promedio móvil de segundo orden (aceleración)
     T epsilon_;       ///< Pequeño valor para evitar división por cero
-    std::size_t t_;   ///< Contador de iteraciones
-    Tensor<T,2> m_;   ///< Promedio móvil de primer orden (momentum)
-    Tensor<T,2> v_;   ///< Promedio móvil de segundo orden (varianza)
+    std::unordered_map<const T*, Moments> state_; ///< Momentos por tensor de parámetros
 
 public:
     /// @brief Constructor con hiperparámetros configurables
     Adam(T learning_rate = 0.001, T beta1 = 0.9, T beta2 = 0.999, T epsilon = 1e-8)
         : learning_rate_(learning_rate), beta1_(beta1), beta2_(beta2),
-          epsilon_(epsilon), t_(0) {}
+          epsilon_(epsilon) {}
 
     /// @brief Aplica una actualización de parámetros con el algoritmo Adam
     /// @param params Parámetros actuales del modelo
     /// @param grads Gradientes calculados
     void update(Tensor<T, 2>& params, const Tensor<T, 2>& grads) override {
-        if (t_ == 0) {
-            m_ = Tensor<T,2>(params.shape()[0], params.shape()[1]);
-            v_ = Tensor<T,2>(params.shape()[0], params.shape()[1]);
-            m_.fill(0);
-            v_.fill(0);
+        Moments& st = state_[params.data()];
+        if (st.t == 0) {
+            st.m = Tensor<T,2>(params.shape()[0], params.shape()[1]);
+            st.v = Tensor<T,2>(params.shape()[0], params.shape()[1]);
+            st.m.fill(0);
+            st.v.fill(0);
         }
-        t_++;
+        st.t++;
 
-        for (size_t i = 0; i < params.shape()[0]; ++i) {
-            for (size_t j = 0; j < params.shape()[1]; ++j) {
-                T g = grads(i, j);
+        const T bias1 = 1 - std::pow(beta1_, st.t);
+        const T bias2 = 1 - std::pow(beta2_, st.t);
+        for (size_t i = 0; i < params.size(); ++i) {
+            T g = grads[i];
 
-                // Cálculo de momentos
-                m_(i, j) = beta1_ * m_(i, j) + (1 - beta1_) * g;
-                v_(i, j) = beta2_ * v_(i, j) + (1 - beta2_) * g * g;
+            // Cálculo de momentos
+            st.m[i] = beta1_ * st.m[i] + (1 - beta1_) * g;
+            st.v[i] = beta2_ * st.v[i] + (1 - beta2_) * g * g;
 
-                // Corrección de sesgo
-                T m_hat = m_(i, j) / (1 - std::pow(beta1_, t_));
-                T v_hat = v_(i, j) / (1 - std::pow(beta2_, t_));
+            // Corrección de sesgo
+            T m_hat = st.m[i] / bias1;
+            T v_hat = st.v[i] / bias2;
 
-                // Actualización de parámetros
-                params(i, j) -= learning_rate_ * m_hat / (std::sqrt(v_hat) + epsilon_);
-            }
+            // Actualización de parámetros
+            params[i] -= learning_rate_ * m_hat / (std::sqrt(v_hat) + epsilon_);
         }
     }
 
@@ -0,0 +1,179 @@
+#ifndef NN_TELEMETRY_H
+#define NN_TELEMETRY_H
+
+/**
+ * @file telemetry.h
+ * @brief Telemetría opcional de entrenamiento: tiempos por capa, throughput, asignaciones y pérdida.
+ *
+ * Quien entrena (`NeuralNetwork::train`, `PongAgent::train_from_csv`) recibe un puntero a
+ * `TrainingTelemetry`; si es nulo no se toma ningún tiempo. Con telemetría activa se acumulan,
+ * por época, los tiempos de forward/backward/update de cada capa, las muestras por segundo,
+ * los bytes y asignaciones por paso y la pérdida, y se escribe un registro por época en
+ * JSON lines o CSV.
+ *
+ * El conteo de bytes requiere enlazar `src/utec/nn/TelemetryAllocHooks.cpp` (opción de CMake
+ * `PONG_TELEMETRY_ALLOC_HOOKS`), que reemplaza `operator new`/`delete`. Sin ese archivo las
+ * columnas de asignación se reportan como -1.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace utec::neural_network {
+
+namespace telemetry_counters {
+/// @brief Bytes pedidos a operator new por este hilo (solo con los hooks enlazados)
+inline thread_local std::size_t allocated_bytes = 0;
+/// @brief Llamadas a operator new de este hilo (solo con los hooks enlazados)
+inline thread_local std::size_t allocation_count = 0;
+/// @brief Se vuelve true cuando TelemetryAllocHooks.cpp está enlazado
+inline bool hooks_linked = false;
+} // namespace telemetry_counters
+
+/// @brief Fase de un paso de entrenamiento.
+enum class Phase { Forward = 0, Backward = 1, Update = 2 };
+
+/// @brief Formato de salida de la telemetría.
+enum class TelemetryFormat { JsonLines, Csv };
+
+/// @brief Acumula y exporta métricas de entrenamiento por época.
+class TrainingTelemetry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Abre (en modo append) el archivo de salida.
+    /// @throws std::runtime_error Si el archivo no puede abrirse
+    explicit TrainingTelemetry(const std::string& path,
+                               TelemetryFormat format = TelemetryFormat::JsonLines)
+        : format_(format), out_(path, std::ios::app) {
+        if (!out_.is_open())
+            throw std::runtime_error("No se pudo abrir el archivo de telemetria: " + path);
+        out_ << std::setprecision(9);
+        if (format_ == TelemetryFormat::Csv && out_.tellp() == 0) {
+            out_ << "run,source,epoch,layer,name,forward_ms,backward_ms,update_ms,"
+                    "loss,steps,samples,seconds,samples_per_sec,bytes_per_step,allocs_per_step\n";
+        }
+    }
+
+    /// @brief Inicia una corrida de entrenamiento.
+    /// @param source Quién entrena (por ejemplo "NeuralNetwork::train")
+    /// @param layer_names Nombre de cada capa o paso instrumentado, en orden
+    void begin_run(const std::string& source, std::vector<std::string> layer_names) {
+        ++run_;
+        source_ = source;
+        names_ = std::move(layer_names);
+        times_.assign(names_.size() * 3, Clock::duration::zero());
+    }
+
+    /// @brief Inicia una época y reinicia los acumuladores.
+    void begin_epoch(std::size_t epoch) {
+        epoch_ = epoch;
+        steps_ = samples_ = bytes_ = allocs_ = 0;
+        std::fill(times_.begin(), times_.end(), Clock::duration::zero());
+        epoch_start_ = Clock::now();
+    }
+
+    /// @brief Marca el inicio de un paso (lote) para medir asignaciones.
+    void begin_step() {
+        step_bytes_ = telemetry_counters::allocated_bytes;
+        step_allocs_ = telemetry_counters::allocation_count;
+    }
+
+    /// @brief Cierra un paso que procesó `samples` muestras.
+    void end_step(std::size_t samples) {
+        ++steps_;
+        samples_ += samples;
+        bytes_ += telemetry_counters::allocated_bytes - step_bytes_;
+        allocs_ += telemetry_counters::allocation_count - step_allocs_;
+    }
+
+    /// @brief Suma tiempo a una capa en una fase.
+    void add_time(std::size_t layer, Phase phase, Clock::duration elapsed) {
+        if (layer < names_.size())
+            times_[layer * 3 + static_cast<std::size_t>(phase)] += elapsed;
+    }
+
+    /// @brief Cierra la época y escribe su registro.
+    /// @param loss Pérdida promedio de la época
+    void end_epoch(double loss) {
+        const double seconds = std::chrono::duration<double>(Clock::now() - epoch_start_).count();
+        const double sps = seconds > 0 ? samples_ / seconds : 0.0;
+        const bool counted = telemetry_counters::hooks_linked && steps_ > 0;
+        const double bytes = counted ? static_cast<double>(bytes_) / steps_ : -1.0;
+        const double allocs = counted ? static_cast<double>(allocs_) / steps_ : -1.0;
+
+        if (format_ == TelemetryFormat::JsonLines) {
+            out_ << "{\"run\":" << run_ << ",\"source\":\"" << source_ << "\",\"epoch\":" << epoch_
+                 << ",\"loss\":" << loss << ",\"steps\":" << steps_ << ",\"samples\":" << samples_
+                 << ",\"seconds\":" << seconds << ",\"samples_per_sec\":" << sps
+                 << ",\"bytes_per_step\":" << bytes << ",\"allocs_per_step\":" << allocs
+                 << ",\"layers\":[";
+            for (std::size_t i = 0; i < names_.size(); ++i) {
+                if (i) out_ << ',';
+                out_ << "{\"name\":\"" << names_[i] << "\",\"forward_ms\":" << ms(i, Phase::Forward)
+                     << ",\"backward_ms\":" << ms(i, Phase::Backward)
+                     << ",\"update_ms\":" << ms(i, Phase::Update) << '}';
+            }
+            out_ << "]}\n";
+        } else {
+            for (std::size_t i = 0; i < names_.size(); ++i) {
+                out_ << run_ << ',' << source_ << ',' << epoch_ << ',' << i << ',' << names_[i] << ','
+                     << ms(i, Phase::Forward) << ',' << ms(i, Phase::Backward) << ','
+                     << ms(i, Phase::Update) << ',' << loss << ',' << steps_ << ',' << samples_ << ','
+                     << seconds << ',' << sps << ',' << bytes << ',' << allocs << '\n';
+            }
+        }
+    }
+
+    /// @brief Vacía el archivo al terminar una corrida.
+    void end_run() { out_.flush(); }
+
+private:
+    TelemetryFormat format_;
+    std::ofstream out_;
+    std::size_t run_ = 0;
+    std::string source_;
+    std::vector<std::string> names_;
+    std::vector<Clock::duration> times_;  ///< [capa * 3 + fase]
+    std::size_t epoch_ = 0;
+    std::size_t steps_ = 0, samples_ = 0, bytes_ = 0, allocs_ = 0;
+    std::size_t step_bytes_ = 0, step_allocs_ = 0;
+    Clock::time_point epoch_start_;
+
+    double ms(std::size_t layer, Phase phase) const {
+        return std::chrono::duration<double, std::milli>(
+            times_[layer * 3 + static_cast<std::size_t>(phase)]).count();
+    }
+};
+
+/// @brief Mide una sección y la suma a la telemetría; no hace nada si el puntero es nulo.
+class ScopedPhase {
+public:
+    ScopedPhase(TrainingTelemetry* telemetry, std::size_t layer, Phase phase)
+        : telemetry_(telemetry), layer_(layer), phase_(phase) {
+        if (telemetry_) start_ = TrainingTelemetry::Clock::now();
+    }
+
+    ~ScopedPhase() {
+        if (telemetry_) telemetry_->add_time(layer_, phase_, TrainingTelemetry::Clock::now() - start_);
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    TrainingTelemetry* telemetry_;
+    std::size_t layer_;
+    Phase phase_;
+    TrainingTelemetry::Clock::time_point start_;
+};
+
+} // namespace utec::neural_network
+
+#endif // NN_TELEMETRY_H
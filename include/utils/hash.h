@@ -0,0 +1,57 @@
+#ifndef UTILS_HASH_H
+#define UTILS_HASH_H
+
+/**
+ * @file hash.h
+ * @brief Hash de 64 bits no criptográfico para bloques de bytes.
+ *
+ * Sirve para identificar contenidos (p. ej. la clave de una caché derivada de un archivo), no
+ * para seguridad. Recorre los datos de a 32 bytes en cuatro acumuladores independientes, así
+ * que el procesador los avanza en paralelo y un archivo proyectado en memoria se procesa a
+ * varios GB/s; el resultado final pasa por el mezclador de MurmurHash3.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace utec::utils {
+
+/// @brief Mezclador final de MurmurHash3: cada bit de entrada afecta a todos los de salida
+inline std::uint64_t mix64(std::uint64_t x) noexcept {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/// @brief Hash de `size` bytes a partir de `data`
+inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept {
+    constexpr std::uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    auto rotl = [](std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    auto round = [&](std::uint64_t acc, std::uint64_t word) { return rotl(acc + word * P2, 31) * P1; };
+    auto load = [](const unsigned char* p) {
+        std::uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        return w;
+    };
+
+    const auto* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+    std::uint64_t v[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+    for (; end - p >= 32; p += 32)
+        for (int i = 0; i < 4; ++i) v[i] = round(v[i], load(p + 8 * i));
+
+    std::uint64_t h = rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18);
+    h += static_cast<std::uint64_t>(size) * P1;
+    for (; end - p >= 8; p += 8) h = rotl(h ^ round(0, load(p)), 27) * P1 + P2;
+    for (; p < end; ++p) h = rotl(h ^ (*p * P1), 11) * P2;
+    return mix64(h);
+}
+
+} // namespace utec::utils
+
+#endif // UTILS_HASH_H
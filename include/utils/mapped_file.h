@@ -0,0 +1,130 @@
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+/**
+ * @file mapped_file.h
+ * @brief Archivo de solo lectura proyectado en memoria (mmap / MapViewOfFile).
+ *
+ * El contenido se lee directamente desde la caché de páginas del sistema operativo, sin copiarlo
+ * a un búfer propio: quien parsea recorre `data()` como un arreglo de bytes. Se avisa al sistema
+ * que la lectura será secuencial para que adelante la lectura del disco.
+ */
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utec::utils {
+
+/// @brief Proyección de solo lectura de un archivo completo; se libera en el destructor.
+class MappedFile {
+public:
+    /// @brief Proyecta `path` en memoria. Un archivo vacío queda con size() == 0.
+    /// @throws std::runtime_error Si el archivo no se puede abrir o proyectar
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("No se pudo abrir el archivo: " + path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            release();
+            throw std::runtime_error("No se pudo leer el tamaño de: " + path);
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ == 0) return;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            release();
+            throw std::runtime_error("No se pudo proyectar en memoria: " + path);
+        }
+        data_ = static_cast<const char*>(view);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("No se pudo abrir el archivo: " + path);
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("No se pudo leer el tamaño de: " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return;
+        }
+        void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // la proyección sigue válida sin el descriptor
+        if (view == MAP_FAILED) {
+            size_ = 0;
+            throw std::runtime_error("No se pudo proyectar en memoria: " + path);
+        }
+        ::madvise(view, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(view);
+#endif
+    }
+
+    ~MappedFile() { release(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { steal(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    const char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    std::string_view view() const noexcept { return {data_, size_}; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+    void release() noexcept {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void steal(MappedFile& other) noexcept {
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        file_ = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+};
+
+} // namespace utec::utils
+
+#endif // UTILS_MAPPED_FILE_H
@@ -0,0 +1,129 @@
+#ifndef UTILS_RANDOM_H
+#define UTILS_RANDOM_H
+
+/**
+ * @file random.h
+ * @brief Generador pseudoaleatorio rápido por objeto (xoshiro256**), con saltos para flujos paralelos.
+ *
+ * Reemplaza al `rand()` global: cada entorno, agente o inicializador tiene su propio estado, así
+ * que no hay estado compartido entre hilos y cada flujo es reproducible a partir de su semilla.
+ * `jump()` avanza 2^128 pasos, de modo que `fork()` entrega flujos que no se solapan en la práctica
+ * (uno por hilo o por entorno). Cumple los requisitos de UniformRandomBitGenerator, así que
+ * también sirve con las distribuciones de <random>.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace utec::utils {
+
+/// @brief Paso de SplitMix64: mezcla `x` y lo avanza. Se usa para sembrar el estado.
+inline std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/// @brief Semilla distinta en cada llamada (contador global mezclado).
+/// La usan los constructores por defecto: objetos distintos reciben flujos distintos y el
+/// programa es reproducible mientras se construyan en el mismo orden.
+inline std::uint64_t next_stream_seed() {
+    static std::atomic<std::uint64_t> counter{0x853c49e6748fea9bULL};
+    std::uint64_t x = counter.fetch_add(0x9e3779b97f4a7c15ULL, std::memory_order_relaxed);
+    return splitmix64(x);
+}
+
+/// @brief xoshiro256** de Blackman y Vigna: 256 bits de estado, período 2^256 - 1.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    /// @brief Siembra el estado expandiendo `seed` con SplitMix64
+    explicit Xoshiro256(std::uint64_t seed = 1) { this->seed(seed); }
+
+    /// @brief Generador con exactamente este estado (sin pasar por SplitMix64), por ejemplo para
+    /// comparar con los vectores de referencia. El estado no puede ser todo cero.
+    static Xoshiro256 from_state(std::uint64_t s0, std::uint64_t s1, std::uint64_t s2, std::uint64_t s3) {
+        Xoshiro256 rng;
+        rng.s_[0] = s0;
+        rng.s_[1] = s1;
+        rng.s_[2] = s2;
+        rng.s_[3] = s3;
+        return rng;
+    }
+
+    /// @brief Reinicia el generador con una nueva semilla
+    void seed(std::uint64_t seed) {
+        for (auto& word : s_) word = splitmix64(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /// @brief Siguientes 64 bits
+    result_type operator()() {
+        const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    /// @brief Entero uniforme en [0, bound), con bound < 2^32.
+    /// Usa multiplicación en lugar de módulo (Lemire); el sesgo es menor que bound / 2^32.
+    std::uint32_t below(std::uint32_t bound) {
+        return static_cast<std::uint32_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+    /// @brief Real uniforme en [0, 1) con 24 bits de mantisa
+    float uniform01() { return static_cast<float>((*this)() >> 40) * 0x1.0p-24f; }
+
+    /// @brief Real uniforme en [lo, hi)
+    float uniform(float lo, float hi) { return lo + (hi - lo) * uniform01(); }
+
+    /// @brief Avanza 2^128 pasos: equivale a 2^128 llamadas a operator().
+    void jump() { apply({0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL}); }
+
+    /// @brief Avanza 2^192 pasos (para repartir flujos entre procesos o máquinas)
+    void long_jump() { apply({0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL}); }
+
+    /// @brief Devuelve una copia del flujo actual y salta este generador 2^128 pasos.
+    /// Llamadas sucesivas entregan flujos independientes (p. ej. uno por hilo).
+    Xoshiro256 fork() {
+        Xoshiro256 stream = *this;
+        jump();
+        return stream;
+    }
+
+    friend bool operator==(const Xoshiro256& a, const Xoshiro256& b) {
+        return a.s_[0] == b.s_[0] && a.s_[1] == b.s_[1] && a.s_[2] == b.s_[2] && a.s_[3] == b.s_[3];
+    }
+
+private:
+    std::uint64_t s_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    void apply(const std::uint64_t (&poly)[4]) {
+        std::uint64_t s[4] = {0, 0, 0, 0};
+        for (std::uint64_t word : poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (std::uint64_t{1} << b)) {
+                    for (int k = 0; k < 4; ++k) s[k] ^= s_[k];
+                }
+                (*this)();
+            }
+        }
+        for (int k = 0; k < 4; ++k) s_[k] = s[k];
+    }
+};
+
+} // namespace utec::utils
+
+#endif // UTILS_RANDOM_H
@@ -0,0 +1,104 @@
+#ifndef UTILS_SPSC_QUEUE_H
+#define UTILS_SPSC_QUEUE_H
+
+/**
+ * @file spsc_queue.h
+ * @brief Cola acotada sin bloqueos para un productor y un consumidor (SPSC).
+ *
+ * Anillo de capacidad potencia de dos con dos índices atómicos: solo el productor escribe
+ * `tail_` y solo el consumidor escribe `head_`, así que basta con acquire/release y no hay
+ * mutex ni CAS. Cada índice vive en su propia línea de caché, y cada lado guarda una copia
+ * del índice del otro para no leer el atómico compartido en cada operación (solo lo relee
+ * cuando la copia indica cola llena o vacía).
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace utec::utils {
+
+/// @brief Cola FIFO acotada para exactamente un hilo productor y un hilo consumidor.
+/// @tparam T Tipo de los elementos (se copian o mueven dentro del anillo)
+template <typename T>
+class SpscQueue {
+public:
+    /// @brief Reserva el anillo; la capacidad se redondea a la siguiente potencia de dos.
+    /// @throws std::invalid_argument Si la capacidad es 0
+    explicit SpscQueue(std::size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("SpscQueue: la capacidad debe ser mayor que 0");
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const noexcept { return slots_.size(); }
+
+    /// @brief Elementos en la cola (aproximado si el otro hilo está operando)
+    std::size_t size_approx() const noexcept {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Encola si hay espacio. Solo lo llama el productor.
+    /// @return false si la cola está llena
+    template <typename U>
+    bool try_push(U&& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == slots_.size()) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == slots_.size()) return false;
+        }
+        slots_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Desencola si hay elementos. Solo lo llama el consumidor.
+    /// @return false si la cola está vacía
+    bool try_pop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return false;
+        }
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Consume hasta `max` elementos llamando a fn(elemento) y libera su espacio de una vez.
+    /// Solo lo llama el consumidor.
+    /// @return Cantidad de elementos consumidos
+    template <typename F>
+    std::size_t consume(F&& fn, std::size_t max = static_cast<std::size_t>(-1)) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        std::size_t count = tail_cache_ - head;
+        if (count > max) count = max;
+        for (std::size_t k = 0; k < count; ++k) fn(slots_[(head + k) & mask_]);
+        if (count) head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::vector<T> slots_;
+    std::size_t mask_ = 0;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};  ///< Próximo a leer (lo escribe el consumidor)
+    std::size_t tail_cache_ = 0;                            ///< Última cola vista por el consumidor
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};  ///< Próximo a escribir (lo escribe el productor)
+    std::size_t head_cache_ = 0;                            ///< Última cabeza vista por el productor
+};
+
+} // namespace utec::utils
+
+#endif // UTILS_SPSC_QUEUE_H
@@ -0,0 +1,138 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+/**
+ * @file thread_pool.h
+ * @brief Pool de hilos de tamaño fijo con cola de tareas.
+ *
+ * Las tareas se encolan con `submit()` y devuelven un `std::future` con su resultado.
+ * `parallel_for()` reparte un rango de índices en bloques contiguos entre los hilos, y
+ * `ordered_for()` produce resultados en paralelo y los consume en orden en el hilo que llama.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utec::utils {
+
+/// @brief Pool de hilos de trabajo que consumen una cola FIFO de tareas.
+class ThreadPool {
+public:
+    /// @brief Crea el pool.
+    /// @param threads Cantidad de hilos; 0 usa std::thread::hardware_concurrency()
+    explicit ThreadPool(std::size_t threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    /// @brief Termina las tareas pendientes y une los hilos.
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Cantidad de hilos del pool
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    /// @brief Encola una tarea.
+    /// @return Futuro con el resultado (o la excepción) de la tarea
+    template <typename F>
+    auto submit(F&& fn) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([task] { (*task)(); });
+        }
+        cv_.notify_one();
+        return future;
+    }
+
+    /// @brief Ejecuta fn(begin, end) sobre bloques contiguos de [0, count) y espera a todos.
+    /// Propaga la primera excepción lanzada por un bloque.
+    template <typename F>
+    void parallel_for(std::size_t count, F&& fn) {
+        if (count == 0) return;
+        const std::size_t chunks = std::min(count, size());
+        const std::size_t per_chunk = (count + chunks - 1) / chunks;
+        std::vector<std::future<void>> pending;
+        pending.reserve(chunks);
+        for (std::size_t begin = 0; begin < count; begin += per_chunk) {
+            const std::size_t end = std::min(count, begin + per_chunk);
+            pending.push_back(submit([&fn, begin, end] { fn(begin, end); }));
+        }
+        for (auto& f : pending) f.get();
+    }
+
+    /// @brief Ejecuta produce(i) para cada i en [0, count) en el pool y entrega los resultados
+    /// en orden a consume(i, resultado) en el hilo que llama, mientras los siguientes se siguen
+    /// produciendo. Hay a lo sumo `max_in_flight` tareas pendientes (0 = dos por hilo), así que la
+    /// memoria no depende de `count`. Propaga la primera excepción, tras esperar las pendientes.
+    template <typename Produce, typename Consume>
+    void ordered_for(std::size_t count, Produce&& produce, Consume&& consume, std::size_t max_in_flight = 0) {
+        using R = std::invoke_result_t<Produce&, std::size_t>;
+        if (max_in_flight == 0) max_in_flight = 2 * size();
+        std::deque<std::future<R>> in_flight;
+        std::size_t launched = 0;
+        try {
+            for (std::size_t i = 0; i < count; ++i) {
+                while (launched < count && in_flight.size() < max_in_flight) {
+                    in_flight.push_back(submit([&produce, k = launched] { return produce(k); }));
+                    ++launched;
+                }
+                R result = in_flight.front().get();
+                in_flight.pop_front();
+                consume(i, std::move(result));
+            }
+        } catch (...) {
+            for (auto& f : in_flight) f.wait();  // las tareas usan `produce`
+            throw;
+        }
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+};
+
+} // namespace utec::utils
+
+#endif // UTILS_THREAD_POOL_H
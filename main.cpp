@@ -4,9 +4,17 @@
 #include <vector>
 #include <limits>
 #include <fstream>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
 
 #include "include/agent/PongAgent.h"
 #include "include/agent/EnvGym.h"
+#include "include/agent/DQNTrainer.h"
+#include "include/agent/ActorLearner.h"
+#include "include/agent/Evaluator.h"
+#include "include/agent/SessionRecorder.h"
+#include "include/agent/PolicyReloader.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -16,6 +24,13 @@
 
 using namespace utec::nn;
 
+/// @brief Archivo donde jugar_manual graba las partidas (ver SessionRecorder.h)
+const std::string GRABACION_MANUAL = "Data/pong_train_manual.rec";
+
+/// @brief Archivos de pesos de la opción 5/6; simular los vigila y recarga al cambiar
+const std::string PESOS_DENSE1 = "Data/pong_model_dense1.weights";
+const std::string PESOS_DENSE2 = "Data/pong_model_dense2.weights";
+
 void limpiar_pantalla() {
 #ifdef _WIN32
     system("cls");
@@ -37,6 +52,24 @@ void esperar_enter() {
     std::cin.get();
 }
 
+/// @brief Telemetría de entrenamiento opcional: se activa con la variable de entorno
+/// PONG_TELEMETRY=<archivo>. Si el archivo termina en .csv se escribe CSV, si no JSON lines.
+std::unique_ptr<utec::neural_network::TrainingTelemetry> abrir_telemetria() {
+    const char* ruta = std::getenv("PONG_TELEMETRY");
+    if (!ruta || !*ruta) return nullptr;
+
+    std::string archivo = ruta;
+    auto formato = archivo.size() >= 4 && archivo.compare(archivo.size() - 4, 4, ".csv") == 0
+                       ? utec::neural_network::TelemetryFormat::Csv
+                       : utec::neural_network::TelemetryFormat::JsonLines;
+    try {
+        return std::make_unique<utec::neural_network::TrainingTelemetry>(archivo, formato);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return nullptr;
+    }
+}
+
 void mostrar_menu() {
     std::cout <<
         "+==============================================+\n"
@@ -48,17 +81,51 @@ void mostrar_menu() {
         "| 4. Entrenar y cargar modelo con datos manual|\n"
         "| 5. Guardar modelo entrenado                 |\n"
         "| 6. Cargar modelo desde archivo              |\n"
-        "| 7. Salir                                    |\n"
+        "| 7. Entrenar por refuerzo (DQN) en EnvGym    |\n"
+        "| 8. Evaluar modelo sin pantalla (rapido)     |\n"
+        "| 9. Salir                                    |\n"
         "+==============================================+\n"
         "Seleccione una opcion: ";
 }
 
+/// @brief Evalúa el modelo en un millón de pasos repartidos entre todos los núcleos, sin dibujar.
+void evaluar_rapido(PongAgent<float>& agente) {
+    auto* modelo = dynamic_cast<PongAgent<float>::Sequential*>(agente.get_model());
+    if (!modelo) {
+        std::cout << "La evaluacion rapida necesita un modelo Dense -> ReLU -> Dense.\n";
+        return;
+    }
+    const PolicySnapshot<float> politica(*modelo, 1);
+    ParallelEvalOptions opciones;
+    const EvalResult r = evaluate_parallel(politica, opciones);
+    std::cout << "Pasos: " << r.steps << " | golpes: " << r.hits << " | fallos: " << r.misses << "\n"
+              << "Tasa de golpes: " << r.hit_rate() << "\n"
+              << "Fallos cada 1000 pasos: " << r.misses_per_1000() << "\n"
+              << "Duracion media de episodio: " << r.mean_episode_length() << " pasos\n"
+              << "Velocidad: " << static_cast<long>(r.steps_per_sec()) << " pasos/s (" << r.seconds << " s)\n";
+}
+
+/// @brief Simula con el agente dibujando cada paso. Si el modelo es Dense -> ReLU -> Dense, los
+/// archivos de pesos se vigilan mientras corre: al guardarlos (opción 5 en otra sesión, o un
+/// entrenamiento externo) el modelo nuevo se usa desde el paso siguiente sin pausar la simulación,
+/// y al terminar reemplaza al del agente, así que las demás opciones siguen con el recargado.
 void simular(PongAgent<float>& agente) {
     EnvGym env;
     auto estado = env.reset();
     float recompensa = 0, recompensa_total = 0;
     bool terminado = false;
 
+    PublishedPolicy<float> publicada;
+    std::shared_ptr<const PolicySnapshot<float>> politica;
+    std::unique_ptr<PolicyHotReloader<float>> recarga;
+    if (auto* modelo = dynamic_cast<PongAgent<float>::Sequential*>(agente.get_model())) {
+        publicada.publish(std::make_shared<const PolicySnapshot<float>>(*modelo, 1));
+        recarga = std::make_unique<PolicyHotReloader<float>>(publicada, PESOS_DENSE1, PESOS_DENSE2);
+        publicada.refresh(politica);
+    }
+    utec::utils::Xoshiro256 rng(std::random_device{}());
+    std::string aviso;
+
     const int pasos_totales = 500;
     const int delay_ms = 20;
 
@@ -69,7 +136,14 @@ void simular(PongAgent<float>& agente) {
             terminado = false;
         }
 
-        int accion = agente.act(estado);
+        int accion;
+        if (politica) {
+            if (publicada.refresh(politica))
+                aviso = "Modelo recargado (version " + std::to_string(politica->version()) + ")";
+            accion = rng.uniform01() < 0.1 ? static_cast<int>(rng.below(3)) - 1 : politica->act(estado);
+        } else {
+            accion = agente.act(estado);
+        }
         estado = env.step(accion, recompensa, terminado);
         recompensa_total += recompensa;
 
@@ -117,6 +191,7 @@ void simular(PongAgent<float>& agente) {
                   << " | Ball Y: " << estado.ball_y
                   << " | Paddle Y: " << estado.paddle_y << "\n";
         std::cout << "Recompensa total: " << recompensa_total << "\n";
+        if (!aviso.empty()) std::cout << aviso << "\n";
 
         pausa(delay_ms);
     }
@@ -126,8 +201,12 @@ void simular(PongAgent<float>& agente) {
         "Pasos totales: " << pasos_totales << "\n"
         "Recompensa acumulada: " << recompensa_total << "\n"
         "Estado final: Bola (" << estado.ball_x << ", " << estado.ball_y
-        << ") | Paleta: " << estado.paddle_y << "\n"
-        "Presione ENTER para volver al menu...";
+        << ") | Paleta: " << estado.paddle_y << "\n";
+    if (politica && politica->version() > 1) {
+        agente.set_model(politica->to_model());
+        std::cout << "El agente sigue con el modelo recargado (version " << politica->version() << ").\n";
+    }
+    std::cout << "Presione ENTER para volver al menu...";
     esperar_enter();
 }
 
@@ -136,10 +215,12 @@ void jugar_manual() {
     auto estado = env.reset();
     bool terminado = false;
     float recompensa = 0;
-    std::ofstream archivo("Data/pong_train_manual.csv", std::ios::app);
-
-    if (!archivo) {
-        std::cerr << "No se pudo abrir Data/pong_train_manual.csv para escribir\n";
+    // Los pasos se graban en segundo plano: el bucle del juego nunca espera al disco
+    std::unique_ptr<SessionRecorder> grabacion;
+    try {
+        grabacion = std::make_unique<SessionRecorder>(GRABACION_MANUAL);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
         return;
     }
 
@@ -199,13 +280,10 @@ void jugar_manual() {
             continue;
         }
 
+        const float vx = env.ball_vx(), vy = env.ball_vy();
+        const State previo = estado;
         estado = env.step(accion, recompensa, terminado);
-
-        archivo << estado.ball_x << ","
-                << estado.ball_y << ","
-                << estado.paddle_y << ","
-                << accion << ","
-                << recompensa << "\n";
+        grabacion->record(previo, vx, vy, accion, recompensa, terminado);
 
         if (terminado) {
             std::cout << "\n🎮 ¡Perdiste la bola! Reiniciando...\n";
@@ -216,8 +294,14 @@ void jugar_manual() {
         pausa(50); // 🔷 para dar tiempo a redibujar
     }
 
-    archivo.close();
-    std::cout << "\nDatos manuales guardados en Data/pong_train_manual.csv\n";
+    try {
+        grabacion->close();
+        std::cout << "\n" << grabacion->written() << " pasos guardados en " << GRABACION_MANUAL;
+        if (grabacion->dropped()) std::cout << " (" << grabacion->dropped() << " descartados)";
+        std::cout << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+    }
     pausa();
 }
 
@@ -245,7 +329,9 @@ int main() {
         switch (opcion) {
             case 1: {
                 std::cout << "Entrenando el modelo desde CSV IA...\n";
-                auto modelo = PongAgent<float>::train_from_csv("Data/pong_train.csv", 2000, 0.001f);
+                auto telemetria = abrir_telemetria();
+                auto modelo = PongAgent<float>::train_from_csv("Data/pong_train.csv", 2000, 0.001f,
+                                                               telemetria.get());
                 agente = std::make_unique<PongAgent<float>>(std::move(modelo));
                 modelo_cargado = true;
                 std::cout << "Entrenamiento completado y modelo cargado.\n";
@@ -267,7 +353,11 @@ int main() {
             }
             case 4: {
                 std::cout << "Entrenando el modelo con datos manuales...\n";
-                auto modelo = PongAgent<float>::train_from_csv("Data/pong_train_manual.csv", 2000, 0.001f);
+                auto telemetria = abrir_telemetria();
+                // Grabaciones nuevas; si aún no hay, el CSV manual de versiones anteriores
+                const std::string datos = std::filesystem::exists(GRABACION_MANUAL) ? GRABACION_MANUAL
+                                                                                    : "Data/pong_train_manual.csv";
+                auto modelo = PongAgent<float>::train_from_csv(datos, 2000, 0.001f, telemetria.get());
                 agente = std::make_unique<PongAgent<float>>(std::move(modelo));
                 modelo_cargado = true;
                 std::cout << "Entrenamiento con datos manuales completado.\n";
@@ -278,11 +368,11 @@ int main() {
                 if (!modelo_cargado || !agente) {
                     std::cout << "Primero debe entrenar o cargar un modelo antes de guardar.\n";
                 } else {
-                    auto* dense1 = agente->get_dense1();
-                    auto* dense2 = agente->get_dense2();
-                    if (dense1 && dense2) {
-                        dense1->save_weights("Data/pong_model_dense1.weights");
-                        dense2->save_weights("Data/pong_model_dense2.weights");
+                    auto* modelo = dynamic_cast<PongAgent<float>::Sequential*>(agente->get_model());
+                    if (modelo) {
+                        // Temporal + renombrado: una simulación que vigila los archivos nunca
+                        // ve uno a medio escribir
+                        save_policy_weights<float>(*modelo, PESOS_DENSE1, PESOS_DENSE2);
                         std::cout << "Modelo guardado.\n";
                     } else {
                         std::cout << "No se pudo acceder a las capas Dense para guardar.\n";
@@ -293,10 +383,7 @@ int main() {
             }
             case 6: {
                 std::cout << "Cargando modelo desde archivos de pesos...\n";
-                auto modelo = PongAgent<float>::create_sequential_with_weights(
-                    "Data/pong_model_dense1.weights",
-                    "Data/pong_model_dense2.weights"
-                );
+                auto modelo = PongAgent<float>::create_sequential_with_weights(PESOS_DENSE1, PESOS_DENSE2);
                 agente = std::make_unique<PongAgent<float>>(std::move(modelo));
                 modelo_cargado = true;
                 std::cout << "Modelo cargado desde archivos de pesos.\n";
@@ -304,6 +391,54 @@ int main() {
                 break;
             }
             case 7: {
+                char paralelo = 'n';
+                std::cout << "Recolectar con actores en paralelo? (s/n): ";
+                std::cin >> paralelo;
+                std::uint32_t repetir = 1;
+                std::cout << "Pasos por accion (1 = decidir en cada paso): ";
+                if (!(std::cin >> repetir) || repetir == 0) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    repetir = 1;
+                }
+                std::cout << "Entrenando con DQN contra EnvGym...\n";
+                auto reporte = [](const DQNStats& s) {
+                    std::cout << "Pasos " << s.steps << " | epsilon " << s.epsilon
+                              << " | perdida " << s.mean_loss << " | golpes " << s.hits
+                              << " | fallos " << s.misses << " | " << static_cast<long>(s.steps_per_sec)
+                              << " pasos/s\n";
+                };
+                std::unique_ptr<utec::neural_network::ILayer<float>> modelo;
+                if (paralelo == 's' || paralelo == 'S') {
+                    ActorLearnerConfig<float> config;
+                    config.dqn.action_repeat = repetir;
+                    ActorLearner<float> entrenador(config);
+                    std::cout << "Actores: " << entrenador.num_actors() << "\n";
+                    modelo = entrenador.train(reporte);
+                } else {
+                    DQNConfig<float> config;
+                    config.action_repeat = repetir;
+                    DQNTrainer<float> entrenador(config);
+                    modelo = entrenador.train(reporte);
+                }
+                agente = std::make_unique<PongAgent<float>>(std::move(modelo));
+                modelo_cargado = true;
+                std::cout << "Entrenamiento DQN completado y modelo cargado.\n";
+                pausa();
+                break;
+            }
+            case 8: {
+                if (!modelo_cargado) {
+                    std::cout << "Primero debe entrenar o cargar un modelo.\n";
+                    pausa();
+                    continue;
+                }
+                evaluar_rapido(*agente);
+                std::cout << "Presione ENTER para volver al menu...";
+                esperar_enter();
+                break;
+            }
+            case 9: {
                 salir = true;
                 break;
             }
@@ -1,57 +1,124 @@
 /// @file DataGenerator.cpp
 /// @brief Genera datos sintéticos de entrenamiento para el agente de Pong.
 ///
-/// Este programa escribe un archivo CSV llamado `pong_train.csv` en el directorio `Data/`.
-/// Cada fila representa una muestra del entorno de juego con sus respectivas características,
-/// acción ideal y recompensa asociada.
+/// Modo grid (por defecto): recorre una grilla de posiciones de bola, velocidades y posiciones
+/// de paleta (ver GridGenerator.h) y escribe, por cada punto, la acción ideal (recompensa 1) y
+/// una acción incorrecta (recompensa -1, para entrenar el castigo).
+/// Modo rollout: graba partidas de EnvGym jugadas por un experto que anticipa el punto de
+/// intercepción (ver RolloutGenerator.h), con exploración opcional.
+/// La generación se reparte entre hilos y la salida puede ser CSV o el formato binario por
+/// columnas (si la salida termina en .bin).
 ///
-/// Se generan combinaciones de posiciones de bola, velocidades y posiciones de paleta,
-/// con acciones correctas (acción ideal según posición) y acciones incorrectas (para entrenar el castigo).
+/// Uso:
+///   DataGenerator [--mode grid|rollout] [--out Data/pong_train.csv] [--threads 0] [--format csv|bin]
+///     grid   : [--bx 11] [--by 11] [--py 11] [--vx -0.02,0.02] [--vy -0.01,0.01]
+///              [--dead-zone 0.05] [--wrong 1]
+///     rollout: [--rows 1000000] [--shard-rows 65536] [--max-steps 2000] [--epsilon 0] [--seed 1]
 
+#include "../../include/agent/GridGenerator.h"
+#include "../../include/agent/RolloutGenerator.h"
+
+#include <iomanip>
 #include <iostream>
-#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace utec::nn;
+
+namespace {
+
+/// @brief "a,b,c" -> {a, b, c}
+std::vector<float> parse_list(const std::string& text) {
+    std::vector<float> values;
+    std::stringstream ss(text);
+    for (std::string item; std::getline(ss, item, ',');) values.push_back(std::stof(item));
+    return values;
+}
+
+bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+template <typename Stats>
+void report(const std::string& out, const Stats& stats) {
+    std::cout << std::fixed << std::setprecision(2) << "Datos generados en " << out << ": " << stats.rows
+              << " filas, " << stats.bytes / 1048576.0 << " MiB en " << stats.seconds << " s ("
+              << std::setprecision(1) << stats.rows_per_sec() * 60.0 / 1e6 << "M filas/min)\n";
+}
+
+} // namespace
 
-int main() {
-    std::ofstream file("Data/pong_train.csv");
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> args = {
+        {"--out", "Data/pong_train.csv"}, {"--bx", "11"}, {"--by", "11"}, {"--py", "11"},
+        {"--vx", "-0.02,0.02"}, {"--vy", "-0.01,0.01"}, {"--dead-zone", "0.05"}, {"--wrong", "1"},
+        {"--threads", "0"}, {"--format", ""}, {"--mode", "grid"}, {"--rows", "1000000"},
+        {"--shard-rows", "65536"}, {"--max-steps", "2000"}, {"--epsilon", "0"}, {"--seed", "1"}};
 
-    // Verifica que el archivo pueda ser creado
-    if (!file.is_open()) {
-        std::cerr << "Error al abrir el archivo." << std::endl;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (!args.count(arg) || i + 1 >= argc) {
+            std::cerr << "Opcion desconocida o sin valor: " << arg << "\n";
+            return 1;
+        }
+        args[arg] = argv[++i];
+    }
+
+    GridSpec spec;
+    RolloutConfig rollout;
+    std::size_t threads = 0;
+    try {
+        spec.ball_x_steps = std::stoul(args["--bx"]);
+        spec.ball_y_steps = std::stoul(args["--by"]);
+        spec.paddle_steps = std::stoul(args["--py"]);
+        spec.ball_vx = parse_list(args["--vx"]);
+        spec.ball_vy = parse_list(args["--vy"]);
+        spec.dead_zone = std::stof(args["--dead-zone"]);
+        spec.wrong_actions = args["--wrong"] != "0";
+        threads = std::stoul(args["--threads"]);
+        rollout.rows = std::stoull(args["--rows"]);
+        rollout.shard_rows = std::stoull(args["--shard-rows"]);
+        rollout.max_episode_steps = static_cast<std::uint32_t>(std::stoul(args["--max-steps"]));
+        rollout.epsilon = std::stof(args["--epsilon"]);
+        rollout.seed = std::stoull(args["--seed"]);
+        rollout.threads = threads;
+    } catch (const std::exception& e) {
+        std::cerr << "Argumento invalido: " << e.what() << "\n";
         return 1;
     }
 
-    // Escribe encabezado CSV
-    file << "ball_x,ball_y,ball_vx,ball_vy,paddle_y,action,reward\n";
-
-    // Genera combinaciones sintéticas
-    for (float bx = 0.0f; bx <= 1.0f; bx += 0.1f) {           // Posición X de la bola
-        for (float by = 0.0f; by <= 1.0f; by += 0.1f) {       // Posición Y de la bola
-            for (float vx : {-0.02f, 0.02f}) {                // Velocidad X de la bola
-                for (float vy : {-0.01f, 0.01f}) {            // Velocidad Y de la bola
-                    for (float py = 0.0f; py <= 1.0f; py += 0.1f) { // Posición Y de la paleta
-
-                        // Acción ideal según diferencia de posición
-                        int action = 0;
-                        if (by > py + 0.05f) action = 1;       // Subir paleta
-                        else if (by < py - 0.05f) action = -1; // Bajar paleta
-                        else action = 0;                       // No moverse
-
-                        int reward = 1;  // Acción correcta → recompensa positiva
-
-                        // Escribir muestra correcta
-                        file << bx << "," << by << "," << vx << "," << vy << "," << py << "," << action << "," << reward << "\n";
-
-                        // Escribir acción incorrecta (castigo)
-                        int wrong_action = (action == 1) ? -1 : (action == -1 ? 1 : 1);
-                        int wrong_reward = -1;
-                        file << bx << "," << by << "," << vx << "," << vy << "," << py << "," << wrong_action << "," << wrong_reward << "\n";
-                    }
-                }
-            }
-        }
+    const std::string& out = args["--out"];
+    const std::string format = args["--format"].empty() ? (ends_with(out, ".bin") ? "bin" : "csv") : args["--format"];
+    if (format != "csv" && format != "bin") {
+        std::cerr << "Formato desconocido: " << format << " (csv o bin)\n";
+        return 1;
+    }
+    const std::string& mode = args["--mode"];
+    if (mode != "grid" && mode != "rollout") {
+        std::cerr << "Modo desconocido: " << mode << " (grid o rollout)\n";
+        return 1;
     }
 
-    file.close();
-    std::cout << "Datos generados en Data/pong_train.csv\n";
+    try {
+        if (mode == "rollout") {
+            const RolloutGenerator gen(rollout);
+            std::cout << "Partidas del experto: " << rollout.rows << " filas en " << gen.shards()
+                      << " fragmentos, epsilon " << rollout.epsilon << ", semilla " << rollout.seed << "\n";
+            const auto stats = format == "bin" ? gen.write_columns(out) : gen.write_csv(out);
+            report(out, stats);
+            std::cout << stats.episodes << " episodios, " << stats.hits << " golpes, " << stats.misses
+                      << " fallos\n";
+            return 0;
+        }
+        const GridGenerator grid(spec);
+        std::cout << "Grilla " << spec.ball_x_steps << " x " << spec.ball_y_steps << " x " << spec.ball_vx.size()
+                  << " x " << spec.ball_vy.size() << " x " << spec.paddle_steps << " = " << grid.points()
+                  << " puntos, " << grid.rows() << " filas\n";
+        report(out, format == "bin" ? grid.write_columns(out, threads) : grid.write_csv(out, threads));
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
     return 0;
 }
@@ -0,0 +1,89 @@
+/// @file DatasetConverter.cpp
+/// @brief Convierte conjuntos de datos de Pong entre CSV y el formato binario por columnas.
+///
+/// La dirección se decide por el contenido de la entrada: si empieza con la magia "PONGCOL1"
+/// se escribe un CSV (con encabezado y floats en su representación más corta que se lee igual),
+/// si empieza con "PONGREC1" (grabación de una partida manual) se escribe el binario, y si no se
+/// carga como CSV con load_pong_csv y se escribe el binario.
+///
+/// Uso:
+///   pong_convert <entrada> <salida>
+///   pong_convert Data/pong_train.csv Data/pong_train.bin
+///   pong_convert Data/pong_train_manual.rec Data/pong_train_manual.bin
+
+#include "../../include/agent/ColumnarDataset.h"
+#include "../../include/agent/CsvLoader.h"
+#include "../../include/agent/SessionRecorder.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace utec::nn;
+
+namespace {
+
+double elapsed(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/// @brief Escribe las columnas como CSV de 7 columnas
+void write_csv(const std::string& path, const PongColumns& columns) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("No se pudo crear el archivo: " + path);
+    out << PONG_CSV_HEADER;
+
+    std::string buffer;
+    for (std::size_t r = 0; r < columns.rows(); ++r) {
+        append_pong_csv(buffer, columns.sample(r));
+        if (buffer.size() > (1 << 20)) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!out) throw std::runtime_error("Error al escribir el archivo: " + path);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Uso: " << argv[0] << " <entrada.csv|entrada.bin|entrada.rec> <salida>\n";
+        return 1;
+    }
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    try {
+        const auto t0 = std::chrono::steady_clock::now();
+        std::size_t rows = 0;
+        if (is_columnar_file(input)) {
+            const PongColumns columns(input);
+            rows = columns.rows();
+            write_csv(output, columns);
+            std::cout << "Binario -> CSV: ";
+        } else if (is_recording_file(input)) {
+            const auto samples = load_pong_recording(input);
+            rows = samples.size();
+            save_pong_columns(output, samples);
+            std::cout << "Grabacion -> binario: ";
+        } else {
+            const auto csv = load_pong_csv(input);
+            rows = csv.samples.size();
+            save_pong_columns(output, csv.samples);
+            std::cout << "CSV -> binario: ";
+        }
+        const auto in_bytes = std::filesystem::file_size(input);
+        const auto out_bytes = std::filesystem::file_size(output);
+        std::cout << rows << " filas, " << in_bytes << " -> " << out_bytes << " bytes en " << std::fixed
+                  << std::setprecision(3) << elapsed(t0) << " s\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/// @file EvaluateModels.cpp
+/// @brief Evaluación rápida, sin pantalla, de uno o varios modelos guardados.
+///
+/// Carga cada modelo desde su par de archivos de pesos, lo juega en paralelo en muchos
+/// entornos (sin dibujar ni esperar) y muestra una tabla para compararlos. Todos los modelos
+/// se evalúan con la misma semilla, así que ven exactamente los mismos saques. Con
+/// `--repeat 1,2,4,8` cada modelo se evalúa una vez por cada valor de k (pasos que se mantiene
+/// cada acción) y las filas quedan una al lado de la otra. Con `--cache N` se agrega, por cada
+/// fila, otra servida desde una PolicyCache de N³ celdas y su coincidencia con la red exacta.
+/// Con `--watch S` se evalúa solo el primer modelo, en rondas, durante S segundos, mientras sus
+/// archivos se vigilan: si se guardan pesos nuevos (p. ej. desde un entrenamiento que sigue
+/// corriendo) la ronda siguiente ya los usa, sin reiniciar la evaluación.
+///
+/// Uso:
+///   pong_eval [--steps 1000000] [--episodes 0] [--threads 0] [--envs 64] [--seed 1] [--repeat 1]
+///             [--cache 0] [--watch 0]
+///             capa1.weights,capa2.weights [otra1.weights,otra2.weights ...]
+///
+/// Sin modelos, evalúa Data/pong_model_dense1.weights,Data/pong_model_dense2.weights.
+
+#include "../../include/agent/Evaluator.h"
+#include "../../include/agent/PolicyCache.h"
+#include "../../include/agent/PolicyReloader.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace utec::nn;
+
+/// @brief Evalúa `w1,w2` en rondas durante `seconds` segundos recargando los pesos al cambiar.
+int watch(const std::string& w1, const std::string& w2, ParallelEvalOptions opts, double seconds) {
+    PublishedPolicy<float> published;
+    try {
+        published.publish(load_policy_snapshot<float>(w1, w2, 1));
+    } catch (const std::exception& e) {
+        std::cerr << w1 << "," << w2 << ": " << e.what() << "\n";
+        return 1;
+    }
+    PolicyHotReloader<float> reloader(published, w1, w2);
+    const LivePolicy<float> policy(published);
+
+    std::cout << std::setw(6) << "ronda" << std::setw(9) << "version" << std::setw(10) << "golpes" << std::setw(14)
+              << "fallos/1000" << std::setw(14) << "pasos/s" << "\n";
+    std::cout << std::fixed;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    std::uint64_t failures = 0;
+    for (int round = 1; std::chrono::steady_clock::now() < end; ++round) {
+        const auto version = published.version();
+        const EvalResult r = evaluate_parallel(policy, opts);
+        std::cout << std::setw(6) << round << std::setw(9) << version << std::setw(10) << std::setprecision(3)
+                  << r.hit_rate() << std::setw(14) << std::setprecision(2) << r.misses_per_1000() << std::setw(14)
+                  << std::setprecision(0) << r.steps_per_sec() << "\n";
+        if (reloader.failures() != failures) {
+            failures = reloader.failures();
+            std::cerr << "No se pudieron recargar los pesos (se sigue con la version anterior): "
+                      << reloader.last_error() << "\n";
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> args = {
+        {"--steps", "1000000"}, {"--episodes", "0"}, {"--threads", "0"}, {"--envs", "64"}, {"--seed", "1"},
+        {"--repeat", "1"}, {"--cache", "0"}, {"--watch", "0"}};
+    std::vector<std::string> models;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            models.push_back(arg);
+            continue;
+        }
+        if (!args.count(arg) || i + 1 >= argc) {
+            std::cerr << "Opcion desconocida o sin valor: " << arg << "\n";
+            return 1;
+        }
+        args[arg] = argv[++i];
+    }
+    if (models.empty()) models.push_back("Data/pong_model_dense1.weights,Data/pong_model_dense2.weights");
+
+    ParallelEvalOptions opts;
+    std::vector<std::uint32_t> repeats;
+    std::size_t cache = 0;
+    double watch_seconds = 0;
+    try {
+        opts.steps = std::stoul(args["--steps"]);
+        opts.episodes = std::stoul(args["--episodes"]);
+        opts.threads = std::stoul(args["--threads"]);
+        opts.envs_per_thread = std::stoul(args["--envs"]);
+        opts.seed = std::stoull(args["--seed"]);
+        cache = std::stoul(args["--cache"]);
+        watch_seconds = std::stod(args["--watch"]);
+        for (std::size_t pos = 0; pos != std::string::npos;) {
+            const std::size_t comma = args["--repeat"].find(',', pos);
+            repeats.push_back(static_cast<std::uint32_t>(std::stoul(args["--repeat"].substr(pos, comma - pos))));
+            pos = comma == std::string::npos ? comma : comma + 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Argumento invalido: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (watch_seconds > 0) {
+        const auto comma = models.front().find(',');
+        if (comma == std::string::npos) {
+            std::cerr << "Se esperaba capa1.weights,capa2.weights: " << models.front() << "\n";
+            return 1;
+        }
+        opts.action_repeat = repeats.front();
+        return watch(models.front().substr(0, comma), models.front().substr(comma + 1), opts, watch_seconds);
+    }
+
+    std::cout << std::left << std::setw(40) << "modelo" << std::right << std::setw(4) << "k" << std::setw(10) << "golpes"
+              << std::setw(14) << "fallos/1000" << std::setw(14) << "episodio" << std::setw(16) << "consultas/1000"
+              << std::setw(14) << "pasos/s" << "\n";
+    std::cout << std::fixed;
+
+    int errores = 0;
+    for (const auto& pair : models) {
+        const auto comma = pair.find(',');
+        if (comma == std::string::npos) {
+            std::cerr << "Se esperaba capa1.weights,capa2.weights: " << pair << "\n";
+            ++errores;
+            continue;
+        }
+        try {
+            auto model = PongAgent<float>::create_sequential_with_weights(pair.substr(0, comma), pair.substr(comma + 1));
+            const PolicySnapshot<float> policy(static_cast<PongAgent<float>::Sequential&>(*model), 1);
+            std::unique_ptr<PolicyCache<float>> table;
+            if (cache > 0) {
+                utec::utils::ThreadPool pool(opts.threads);
+                table = std::make_unique<PolicyCache<float>>(policy, PolicyCacheGrid{cache, cache, cache}, &pool);
+                utec::utils::Xoshiro256 rng(opts.seed);
+                std::cout << "tabla " << cache << "^3 de " << pair.substr(0, comma) << ": " << table->bytes() / 1024
+                          << " KiB, coincide con la red en " << std::setprecision(4)
+                          << table->agreement(policy, 1000000, rng).rate() << " de los estados\n";
+            }
+            auto print = [&](const std::string& name, std::uint32_t k, const EvalResult& r) {
+                std::cout << std::left << std::setw(40) << name << std::right << std::setw(4) << k
+                          << std::setw(10) << std::setprecision(3) << r.hit_rate()
+                          << std::setw(14) << std::setprecision(2) << r.misses_per_1000()
+                          << std::setw(14) << std::setprecision(1) << r.mean_episode_length()
+                          << std::setw(16) << std::setprecision(1) << 1000.0 * r.decisions / r.steps
+                          << std::setw(14) << std::setprecision(0) << r.steps_per_sec() << "\n";
+            };
+            for (const std::uint32_t k : repeats) {
+                opts.action_repeat = k;
+                print(pair.substr(0, comma), k, evaluate_parallel(policy, opts));
+                if (table) print("  (tabla " + std::to_string(cache) + "^3)", k, evaluate_parallel(*table, opts));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << pair << ": " << e.what() << "\n";
+            ++errores;
+        }
+    }
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+/// @file EvolutionTrainer.cpp
+/// @brief Entrenamiento del agente de Pong por estrategias evolutivas, sin datos etiquetados.
+///
+/// Evalúa la población de cada generación en todos los núcleos, informa el progreso y el tiempo
+/// de entrenamiento hasta la tasa de golpes objetivo, y guarda los pesos finales en el mismo
+/// formato que el menú al guardar el modelo (la opción 6 los carga desde Data/pong_model_*).
+///
+/// Uso:
+///   pong_es [--generations 200] [--population 128] [--episodes 64] [--sigma 0.1] [--lr 0.05]
+///           [--hidden 16] [--threads 0] [--target 0.9] [--eval-every 5] [--stop 1] [--seed 1]
+///           [--out Data/pong_model]
+
+#include "../../include/agent/EvolutionStrategies.h"
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace utec::nn;
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> args = {
+        {"--generations", "200"}, {"--population", "128"}, {"--episodes", "64"}, {"--sigma", "0.1"},
+        {"--lr", "0.05"}, {"--hidden", "16"}, {"--threads", "0"}, {"--target", "0.9"},
+        {"--eval-every", "5"}, {"--stop", "1"}, {"--seed", "1"}, {"--out", "Data/pong_model"}};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (!args.count(arg) || i + 1 >= argc) {
+            std::cerr << "Opcion desconocida o sin valor: " << arg << "\n";
+            return 1;
+        }
+        args[arg] = argv[++i];
+    }
+
+    ESConfig<float> cfg;
+    try {
+        cfg.generations = std::stoul(args["--generations"]);
+        cfg.population = std::stoul(args["--population"]);
+        cfg.episodes = std::stoul(args["--episodes"]);
+        cfg.sigma = std::stof(args["--sigma"]);
+        cfg.learning_rate = std::stof(args["--lr"]);
+        cfg.hidden_size = std::stoul(args["--hidden"]);
+        cfg.threads = std::stoul(args["--threads"]);
+        cfg.target_hit_rate = std::stod(args["--target"]);
+        cfg.eval_every = std::stoul(args["--eval-every"]);
+        cfg.stop_at_target = args["--stop"] != "0";
+        cfg.seed = std::stoull(args["--seed"]);
+    } catch (const std::exception& e) {
+        std::cerr << "Argumento invalido: " << e.what() << "\n";
+        return 1;
+    }
+
+    try {
+        EvolutionStrategies<float> es(cfg);
+        std::cout << std::fixed;
+        auto model = es.train([](const ESStats& s) {
+            if (s.hit_rate < 0) return;
+            std::cout << "Generacion " << std::setw(4) << s.generation << " | retorno medio " << std::setprecision(2)
+                      << std::setw(7) << s.mean_return << " | mejor " << std::setw(7) << s.best_return
+                      << " | golpes " << std::setprecision(3) << s.hit_rate << " | " << std::setprecision(1)
+                      << s.seconds << " s | " << std::setprecision(0) << s.episodes_per_sec << " episodios/s\n";
+        });
+
+        if (es.time_to_quality() < 0)
+            std::cout << "No se alcanzo la tasa de golpes " << cfg.target_hit_rate << " en " << es.generations()
+                      << " generaciones\n";
+        else
+            std::cout << "Tasa de golpes " << std::setprecision(2) << cfg.target_hit_rate << " alcanzada en "
+                      << es.generation_to_quality() << " generaciones, " << std::setprecision(2)
+                      << es.time_to_quality() << " s de entrenamiento\n";
+
+        auto& sequential = static_cast<PongAgent<float>::Sequential&>(*model);
+        sequential.l1->save_weights(args["--out"] + "_dense1.weights");
+        sequential.l2->save_weights(args["--out"] + "_dense2.weights");
+        std::cout << "Pesos guardados en " << args["--out"] << "_dense{1,2}.weights\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
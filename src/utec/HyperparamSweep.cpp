@@ -0,0 +1,119 @@
+/// @file HyperparamSweep.cpp
+/// @brief Barrido de hiperparámetros para el agente de Pong.
+///
+/// Entrena en paralelo todas las configuraciones de una grilla (o una muestra aleatoria),
+/// evalúa cada modelo en EnvGym y escribe una tabla ordenada con el tiempo hasta calidad.
+/// Con `--normalize 0,1` cada configuración se entrena sin y con entradas estandarizadas.
+///
+/// Uso:
+///   pong_sweep [--data Data/pong_train.csv] [--mode grid|random] [--samples 20]
+///              [--hidden 8,16] [--lr 0.0001,0.001] [--opt sgd,adam] [--batch 1,8]
+///              [--epochs 200] [--normalize 0] [--threads 0] [--eval-steps 5000]
+///              [--eval-every 10] [--target 0.8] [--seed 1] [--out Data/sweep_results.csv]
+
+#include "../../include/agent/Sweep.h"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace utec::nn;
+
+/// @brief Separa una lista "a,b,c" y convierte cada elemento con `parse`.
+template <typename V, typename Parse>
+std::vector<V> parse_list(const std::string& text, Parse parse) {
+    std::vector<V> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(parse(item));
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> args = {
+        {"--data", "Data/pong_train.csv"}, {"--mode", "grid"}, {"--samples", "20"},
+        {"--hidden", "8,16"}, {"--lr", "0.0001,0.001"}, {"--opt", "sgd,adam"},
+        {"--batch", "1,8"}, {"--epochs", "200"}, {"--normalize", "0"}, {"--threads", "0"},
+        {"--eval-steps", "5000"}, {"--eval-every", "10"}, {"--target", "0.8"},
+        {"--seed", "1"}, {"--out", "Data/sweep_results.csv"}};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (!args.count(arg) || i + 1 >= argc) {
+            std::cerr << "Opcion desconocida o sin valor: " << arg << "\n";
+            return 1;
+        }
+        args[arg] = argv[++i];
+    }
+
+    SweepSpace<float> space;
+    SweepOptions opts;
+    std::size_t samples = 0;
+    try {
+        space.hidden_sizes = parse_list<size_t>(args["--hidden"], [](const std::string& s) { return std::stoul(s); });
+        space.learning_rates = parse_list<float>(args["--lr"], [](const std::string& s) { return std::stof(s); });
+        space.batch_sizes = parse_list<size_t>(args["--batch"], [](const std::string& s) { return std::stoul(s); });
+        space.epochs = parse_list<int>(args["--epochs"], [](const std::string& s) { return std::stoi(s); });
+        space.normalize = parse_list<bool>(args["--normalize"], [](const std::string& s) { return std::stoi(s) != 0; });
+        space.optimizers = parse_list<OptimizerKind>(args["--opt"], [](const std::string& s) {
+            if (s == "sgd") return OptimizerKind::SGD;
+            if (s == "adam") return OptimizerKind::Adam;
+            throw std::invalid_argument("optimizador desconocido: " + s);
+        });
+        opts.threads = std::stoul(args["--threads"]);
+        opts.eval_steps = std::stoul(args["--eval-steps"]);
+        opts.eval_every = std::stoi(args["--eval-every"]);
+        opts.target_hit_rate = std::stod(args["--target"]);
+        opts.seed = static_cast<unsigned>(std::stoul(args["--seed"]));
+        samples = std::stoul(args["--samples"]);
+    } catch (const std::exception& e) {
+        std::cerr << "Argumento invalido: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (space.hidden_sizes.empty() || space.learning_rates.empty() || space.optimizers.empty()
+        || space.batch_sizes.empty() || space.epochs.empty() || space.normalize.empty()) {
+        std::cerr << "Cada hiperparametro necesita al menos un valor.\n";
+        return 1;
+    }
+
+    const std::string& mode = args["--mode"];
+    if (mode != "grid" && mode != "random") {
+        std::cerr << "Modo desconocido: " << mode << " (grid o random)\n";
+        return 1;
+    }
+
+    std::vector<PongSample> data;
+    try {
+        data = PongAgent<float>::load_training_data(args["--data"]);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    if (data.empty()) {
+        std::cerr << "No hay datos de entrenamiento en " << args["--data"] << "\n";
+        return 1;
+    }
+
+    auto configs = mode == "random" ? space.random(samples, opts.seed) : space.grid();
+
+    std::cout << "Entrenando " << configs.size() << " configuraciones sobre "
+              << data.size() << " muestras...\n";
+    auto results = run_sweep(data, configs, opts);
+
+    print_sweep_table(std::cout, results);
+
+    std::ofstream out(args["--out"]);
+    if (!out) {
+        std::cerr << "No se pudo escribir " << args["--out"] << "\n";
+        return 1;
+    }
+    write_sweep_csv(out, results);
+    std::cout << "Resultados guardados en " << args["--out"] << "\n";
+    return 0;
+}
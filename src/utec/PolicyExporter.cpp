@@ -0,0 +1,59 @@
+/// @file PolicyExporter.cpp
+/// @brief Exporta un modelo guardado como un header de C++ con pesos constexpr.
+///
+/// Lee el par de archivos de pesos y escribe un header autocontenido (ver PolicyExport.h) con
+/// los pesos como arreglos constexpr y `act()` desenrollada para esa topología: un programa
+/// que lo incluye juega con la política sin leer archivos al arrancar.
+///
+/// Uso:
+///   pong_export [--out Data/pong_policy.h] [--namespace pong_policy] [capa1.weights,capa2.weights]
+///
+/// Sin modelo, exporta Data/pong_model_dense1.weights,Data/pong_model_dense2.weights.
+
+#include "../../include/agent/PolicyExport.h"
+
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace utec::nn;
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> args = {{"--out", "Data/pong_policy.h"}, {"--namespace", "pong_policy"}};
+    std::string model = "Data/pong_model_dense1.weights,Data/pong_model_dense2.weights";
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            model = arg;
+            continue;
+        }
+        if (!args.count(arg) || i + 1 >= argc) {
+            std::cerr << "Opcion desconocida o sin valor: " << arg << "\n";
+            return 1;
+        }
+        args[arg] = argv[++i];
+    }
+
+    const auto comma = model.find(',');
+    if (comma == std::string::npos) {
+        std::cerr << "Se esperaba capa1.weights,capa2.weights: " << model << "\n";
+        return 1;
+    }
+    const std::string w1 = model.substr(0, comma), w2 = model.substr(comma + 1);
+
+    try {
+        auto layers = PongAgent<float>::create_sequential_with_weights(w1, w2);
+        const auto& seq = static_cast<const PongAgent<float>::Sequential&>(*layers);
+        PolicyExportOptions opts;
+        opts.name_space = args["--namespace"];
+        opts.source = w1 + " y " + w2;
+        write_policy_header<float>(args["--out"], seq, opts);
+        std::cout << "Politica 3 -> " << seq.l1->out_features() << " -> 3 exportada en " << args["--out"]
+                  << " (namespace " << opts.name_space << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -3,8 +3,6 @@
 #include "../../../include/nn/optimizer.h"
 #include "../../../include/agent/PongAgent.h"
 
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -21,46 +19,16 @@
 /// @param filename Ruta del archivo CSV.
 /// @return Vector de muestras de entrenamiento (PongSample).
 std::vector<utec::nn::PongSample> load_training_data(const std::string& filename) {
-    std::vector<utec::nn::PongSample> data;
-    std::ifstream file(filename);
-    std::string line;
-
-    // Verifica que el archivo se haya abierto correctamente
-    if (!file.is_open()) {
-        std::cerr << "Error: No se pudo abrir el archivo " << filename << std::endl;
-        return data;
+    utec::nn::CsvLoadOptions options;
+    options.skip_invalid = true;  // las filas con formato incorrecto se informan y se omiten
+
+    try {
+        auto result = utec::nn::load_pong_csv(filename, options);
+        if (result.skipped)
+            std::cerr << "Error: " << result.skipped << " lineas con formato incorrecto en " << filename << std::endl;
+        return std::move(result.samples);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return {};
     }
-
-    // Saltar la primera línea (encabezado CSV)
-    std::getline(file, line);
-
-    // Leer línea por línea
-    while (std::getline(file, line)) {
-        try {
-            std::stringstream ss(line);
-            utec::nn::PongSample sample;
-            char comma;
-
-            // Parseo de valores separados por comas
-            ss >> sample.ball_x >> comma
-               >> sample.ball_y >> comma
-               >> sample.ball_vx >> comma
-               >> sample.ball_vy >> comma
-               >> sample.paddle_y >> comma
-               >> sample.action >> comma
-               >> sample.reward;
-
-            if (ss.fail()) {
-                throw std::runtime_error("Formato incorrecto en la línea: " + line);
-            }
-
-            // Agregar muestra a la colección
-            data.push_back(sample);
-
-        } catch (const std::exception& e) {
-            std::cerr << "Error al procesar la línea: " << e.what() << std::endl;
-        }
-    }
-
-    return data;
 }
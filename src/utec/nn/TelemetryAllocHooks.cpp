@@ -0,0 +1,34 @@
+/// @file TelemetryAllocHooks.cpp
+/// @brief Reemplaza operator new/delete para contar bytes y asignaciones por hilo.
+///
+/// Solo se compila con la opción de CMake `PONG_TELEMETRY_ALLOC_HOOKS`; así la telemetría
+/// puede reportar bytes asignados por paso sin costo alguno en las compilaciones normales.
+
+#include "../../../include/nn/telemetry.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+/// @brief Marca los hooks como enlazados durante la inicialización estática
+const bool hooks_registered = [] {
+    utec::neural_network::telemetry_counters::hooks_linked = true;
+    return true;
+}();
+} // namespace
+
+void* operator new(std::size_t size) {
+    utec::neural_network::telemetry_counters::allocated_bytes += size;
+    ++utec::neural_network::telemetry_counters::allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
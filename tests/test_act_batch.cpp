@@ -0,0 +1,190 @@
+/**
+ * @file test_act_batch.cpp
+ * @brief Verifica que PongAgent::act_batch elige lo mismo que act() estado por estado.
+ *
+ * ### Flujo principal:
+ * 1. Estados al azar (y lotes de distintos tamaños, que reutilizan la entrada): act_batch da la
+ *    misma acción que act(s, 0) en cada estado.
+ * 2. Empates: una red cuyas dos primeras salidas son siempre iguales, una red con todas las
+ *    salidas iguales y filas armadas a mano; select_actions (sin saltos para 3 salidas) sigue la
+ *    regla de select_action: si un valor posterior empata con el máximo vigente, la acción es 0.
+ * 3. Exploración: con la misma semilla, act_batch(states, actions, epsilon) y act(s, epsilon)
+ *    estado por estado consumen el generador igual y dan las mismas acciones.
+ * 4. Tamaños distintos de states y actions se rechazan.
+ */
+
+#include "../include/agent/PongAgent.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace utec::nn;
+using utec::algebra::Tensor;
+using utec::neural_network::Dense;
+using utec::neural_network::ReLU;
+
+namespace {
+
+std::vector<State> random_states(std::size_t n, std::uint64_t seed) {
+    utec::utils::Xoshiro256 rng(seed);
+    std::vector<State> states(n);
+    for (auto& s : states)
+        s = {static_cast<float>(rng.uniform01()), static_cast<float>(rng.uniform01()),
+             static_cast<float>(rng.uniform01())};
+    return states;
+}
+
+/// @brief Acciones de act(s, epsilon) estado por estado
+std::vector<int> one_by_one(PongAgent<float>& agent, const std::vector<State>& states, float epsilon) {
+    std::vector<int> actions;
+    for (const auto& s : states) actions.push_back(agent.act(s, epsilon));
+    return actions;
+}
+
+/// @brief Red 3 -> 8 -> 3 con salidas 0 y 1 iguales (columnas idénticas en la segunda capa)
+std::unique_ptr<PongAgent<float>::Sequential> tied_model() {
+    auto l1 = std::make_unique<Dense<float>>(
+        3, 8, [](Tensor<float, 2>& t) {
+            for (std::size_t i = 0; i < t.size(); ++i) t[i] = std::sin(static_cast<float>(i) * 1.3f);
+        },
+        [](Tensor<float, 2>& b) { b.fill(0.1f); });
+    auto l2 = std::make_unique<Dense<float>>(
+        8, 3, [](Tensor<float, 2>& t) {
+            for (std::size_t i = 0; i < 8; ++i) {
+                t(i, 0) = t(i, 1) = std::cos(static_cast<float>(i));
+                t(i, 2) = -std::cos(static_cast<float>(i) * 0.7f);
+            }
+        },
+        [](Tensor<float, 2>& b) { b.fill(0.0f); });
+    return std::make_unique<PongAgent<float>::Sequential>(std::move(l1), std::make_unique<ReLU<float>>(),
+                                                          std::move(l2));
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1. Estados al azar, lotes de varios tamaños
+    {
+        PongAgent<float> agente(PongAgent<float>::build_sequential(16, 3), 1);
+        std::size_t distintos = 0, total = 0;
+        for (std::size_t n : {1u, 7u, 10000u, 7u}) {
+            const auto estados = random_states(n, 100 + n);
+            std::vector<int> acciones(n);
+            agente.act_batch(estados, acciones);
+            const auto esperadas = one_by_one(agente, estados, 0.0f);
+            for (std::size_t i = 0; i < n; ++i) distintos += acciones[i] != esperadas[i];
+            total += n;
+        }
+        std::cout << "Estados al azar (lotes de 1, 7, 10000 y 7): " << distintos << " acciones distintas de "
+                  << total << "\n";
+        if (distintos) ++errores;
+    }
+
+    // 2. Empates
+    {
+        const auto estados = random_states(20000, 7);
+        std::vector<int> acciones(estados.size());
+
+        PongAgent<float> empatada(tied_model(), 1);
+        empatada.act_batch(estados, acciones);
+        const auto esperadas = one_by_one(empatada, estados, 0.0f);
+        std::size_t distintos = 0, empates = 0, regla = 0;
+        for (std::size_t i = 0; i < estados.size(); ++i) {
+            distintos += acciones[i] != esperadas[i];
+            // Salidas 0 y 1 iguales: solo la tercera puede ganar; si no, hay empate y la acción es 0
+            empates += acciones[i] == 0;
+            regla += acciones[i] != 0 && acciones[i] != 1;
+        }
+
+        PongAgent<float> plana(std::make_unique<PongAgent<float>::Sequential>(
+                                   std::make_unique<Dense<float>>(3, 4, [](auto& t) { t.fill(0.5f); }),
+                                   std::make_unique<ReLU<float>>(),
+                                   std::make_unique<Dense<float>>(4, 3, [](auto& t) { t.fill(0.25f); })),
+                               1);
+        plana.act_batch(estados, acciones);
+        std::size_t no_quieto = 0;
+        for (int a : acciones) no_quieto += a != 0;
+
+        // Filas a mano: todas las combinaciones de 4 valores (incluidos empates en cada posición)
+        const float valores[] = {-1.0f, 0.0f, 0.5f, 1.0f};
+        std::vector<float> filas;
+        for (float a : valores)
+            for (float b : valores)
+                for (float c : valores) filas.insert(filas.end(), {a, b, c});
+        const std::size_t n = filas.size() / 3;
+        std::vector<int> sin_saltos(n);
+        PongAgent<float>::select_actions(filas.data(), n, 3, sin_saltos.data());
+        std::size_t a_mano = 0;
+        for (std::size_t i = 0; i < n; ++i) a_mano += sin_saltos[i] != PongAgent<float>::select_action(&filas[i * 3], 3);
+        // Casos de la regla escritos explícitamente
+        const float casos[][3] = {{1, 1, 0}, {0, 1, 1}, {1, 0, 1}, {1, 1, 1}, {0, 0, 1}, {1, 0, 0}, {0, 1, 0}};
+        const int esperado[] = {0, 0, 0, 0, 1, -1, 0};
+        int accion_caso[7];
+        PongAgent<float>::select_actions(&casos[0][0], 7, 3, accion_caso);
+        for (int i = 0; i < 7; ++i) a_mano += accion_caso[i] != esperado[i];
+
+        std::cout << "Empates: salidas 0 y 1 iguales -> " << distintos << " distintas de act(), " << empates
+                  << " estados quietos por empate, " << regla << " fuera de la regla; red plana -> " << no_quieto
+                  << " no quietos; " << n + 7 << " filas a mano -> " << a_mano << " distintas de select_action\n";
+        if (distintos || regla || empates == 0 || no_quieto || a_mano) ++errores;
+    }
+
+    // 3. Exploración con la misma semilla
+    {
+        const auto estados = random_states(50000, 9);
+        std::vector<int> acciones(estados.size());
+        const float epsilon = 0.3f;
+
+        PongAgent<float> lote(PongAgent<float>::build_sequential(16, 5), 42);
+        PongAgent<float> uno(PongAgent<float>::build_sequential(16, 5), 42);
+        lote.act_batch(estados, acciones, epsilon);
+        const auto esperadas = one_by_one(uno, estados, epsilon);
+        std::size_t distintos = 0;
+        for (std::size_t i = 0; i < estados.size(); ++i) distintos += acciones[i] != esperadas[i];
+
+        // Generador externo: mismo flujo que un agente sembrado igual
+        utec::utils::Xoshiro256 rng(77);
+        PongAgent<float> externo(PongAgent<float>::build_sequential(16, 5), 1);
+        PongAgent<float> propio(PongAgent<float>::build_sequential(16, 5), 77);
+        externo.act_batch(estados, acciones, epsilon, rng);
+        const auto propias = one_by_one(propio, estados, epsilon);
+        std::size_t distintos_rng = 0;
+        for (std::size_t i = 0; i < estados.size(); ++i) distintos_rng += acciones[i] != propias[i];
+
+        std::vector<int> greedy(estados.size());
+        lote.act_batch(estados, greedy);
+        std::size_t exploradas = 0;
+        for (std::size_t i = 0; i < estados.size(); ++i) exploradas += acciones[i] != greedy[i];
+
+        std::cout << std::fixed << std::setprecision(3) << "Exploracion (epsilon " << epsilon << "): "
+                  << distintos << " distintas con el generador del agente, " << distintos_rng
+                  << " con un generador externo; " << static_cast<double>(exploradas) / estados.size()
+                  << " de acciones cambiadas (esperado ~" << epsilon * 2 / 3 << ")\n";
+        if (distintos || distintos_rng) ++errores;
+    }
+
+    // 4. Tamaños incompatibles
+    {
+        PongAgent<float> agente(PongAgent<float>::build_sequential(4, 1), 1);
+        const auto estados = random_states(3, 1);
+        std::vector<int> acciones(2);
+        bool rechaza = false;
+        try {
+            agente.act_batch(estados, acciones);
+        } catch (const std::invalid_argument&) {
+            rechaza = true;
+        }
+        std::cout << "3 estados y 2 acciones: " << (rechaza ? "rechazado" : "ACEPTADO") << "\n";
+        if (!rechaza) ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nDecisiones por lotes verificadas\n";
+    return 0;
+}
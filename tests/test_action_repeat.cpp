@@ -0,0 +1,166 @@
+/**
+ * @file test_action_repeat.cpp
+ * @brief Verifica la repetición de acciones y compara la tasa de golpes para varios k.
+ *
+ * ### Flujo principal:
+ * 1. ActionRepeat(k) contra k llamadas a EnvGym::step: mismo estado, pasos, golpes y done, y la
+ *    misma suma de recompensas (salvo redondeo).
+ * 2. VecActionRepeat contra ActionRepeat desde los mismos estados iniciales, cortando en done.
+ * 3. evaluate_repeat con k = 1 da los mismos contadores que evaluate_policy.
+ * 4. Tabla lado a lado: tasa de golpes, fallos y consultas a la red para k = 1, 2, 4, 8.
+ * 5. DQNTrainer y ActorLearner entrenan con action_repeat = 4.
+ */
+
+#include "../include/agent/ActorLearner.h"
+#include "../include/agent/Evaluator.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace utec::nn;
+
+int main() {
+    int errores = 0;
+    utec::utils::Xoshiro256 rng(38);
+
+    // 1. ActionRepeat == k x step (cortando en done)
+    std::size_t distintos = 0, decisiones = 0;
+    for (int prueba = 0; prueba < 5000; ++prueba) {
+        const State s{rng.uniform(0.05f, 0.95f), rng.uniform(0.05f, 0.95f), rng.uniform(0.1f, 0.9f)};
+        const float vx = rng.uniform(0.04f, 0.1f) * (rng.below(2) ? 1.0f : -1.0f);
+        const float vy = rng.uniform(0.02f, 0.06f) * (rng.below(2) ? 1.0f : -1.0f);
+        const std::uint32_t k = 1 + rng.below(12);
+        EnvGym envuelto(1), manual(1);
+        envuelto.set_state(s, vx, vy);
+        manual.set_state(s, vx, vy);
+        ActionRepeat repetido(envuelto, k);
+
+        for (int decision = 0; decision < 20; ++decision) {
+            const int accion = static_cast<int>(rng.below(3)) - 1;
+            const ActionRepeat::Outcome out = repetido.step(accion);
+            ++decisiones;
+            float suma = 0, r = 0;
+            bool done = false;
+            std::uint32_t pasos = 0, golpes = 0;
+            while (pasos < k && !done) {
+                manual.step(accion, r, done);
+                suma += r;
+                golpes += r > 0;
+                ++pasos;
+            }
+            const State& a = out.state;
+            const State& b = manual.state();
+            if (a.ball_x != b.ball_x || a.ball_y != b.ball_y || a.paddle_y != b.paddle_y || out.steps != pasos
+                || out.hits != golpes || out.done != done || std::abs(out.reward - suma) > 1e-4f)
+                ++distintos;
+            if (done) break;
+        }
+    }
+    std::cout << "=== REPETICION DE ACCIONES ===\n";
+    std::cout << "Decisiones comparadas con step(): " << decisiones << " | diferencias: " << distintos << "\n";
+    if (distintos) ++errores;
+
+    // 2. VecActionRepeat == ActionRepeat por entorno, hasta el primer done de cada uno
+    {
+        constexpr std::size_t N = 37;
+        constexpr std::uint32_t K = 5;
+        VecEnvGym envs(N, 2);
+        VecActionRepeat vec(envs, K);
+        std::vector<EnvGym> solos(N, EnvGym(std::uint64_t{3}));
+        std::vector<bool> vivo(N, true);
+        for (std::size_t i = 0; i < N; ++i) {
+            const State s{rng.uniform(0.05f, 0.95f), rng.uniform(0.05f, 0.95f), rng.uniform(0.1f, 0.9f)};
+            const float vx = rng.uniform(0.04f, 0.1f) * (rng.below(2) ? 1.0f : -1.0f);
+            const float vy = rng.uniform(0.02f, 0.06f) * (rng.below(2) ? 1.0f : -1.0f);
+            envs.set_env(i, s, vx, vy);
+            solos[i].set_state(s, vx, vy);
+        }
+        std::vector<int> acciones(N);
+        std::size_t diferencias = 0;
+        for (int decision = 0; decision < 40; ++decision) {
+            for (auto& a : acciones) a = static_cast<int>(rng.below(3)) - 1;
+            vec.step(acciones);
+            for (std::size_t i = 0; i < N; ++i) {
+                if (!vivo[i]) continue;
+                ActionRepeat solo(solos[i], K);
+                const ActionRepeat::Outcome out = solo.step(acciones[i]);
+                if (out.steps != vec.steps()[i] || out.hits != vec.hits()[i] || out.done != (vec.dones()[i] != 0)
+                    || std::abs(out.reward - vec.rewards()[i]) > 1e-4f)
+                    ++diferencias;
+                if (out.done) {
+                    vivo[i] = false;
+                    continue;
+                }
+                const State a = vec.state(i);
+                if (a.ball_x != out.state.ball_x || a.ball_y != out.state.ball_y || a.paddle_y != out.state.paddle_y)
+                    ++diferencias;
+            }
+        }
+        std::cout << "VecActionRepeat contra ActionRepeat: " << diferencias << " diferencias\n";
+        if (diferencias) ++errores;
+    }
+
+    // 3. k = 1 equivale a evaluate_policy
+    auto modelo = PongAgent<float>::build_sequential(32, 5);
+    std::unique_ptr<utec::neural_network::ILayer<float>> guardado;
+    try {
+        guardado = PongAgent<float>::create_sequential_with_weights("Data/pong_model_dense1.weights",
+                                                                     "Data/pong_model_dense2.weights");
+        std::cout << "Modelo cargado desde Data/\n";
+    } catch (const std::exception&) {
+        std::cout << "Sin pesos en Data/: se usa un modelo aleatorio\n";
+    }
+    const auto& red = guardado ? static_cast<PongAgent<float>::Sequential&>(*guardado) : *modelo;
+    const PolicySnapshot<float> politica(red, 1);
+    auto decidir = [&](const State& s) { return politica.act(s); };
+    {
+        EnvGym a(9), b(9);
+        ActionRepeat uno(b, 1);
+        const EvalResult base = evaluate_policy(decidir, a, 500000);
+        const EvalResult rep = evaluate_repeat(decidir, uno, 500000);
+        const bool iguales = base.steps == rep.steps && base.hits == rep.hits && base.misses == rep.misses
+                             && base.episode_steps == rep.episode_steps && base.decisions == rep.decisions;
+        std::cout << "evaluate_repeat(k = 1) vs evaluate_policy: " << (iguales ? "identicos" : "DISTINTOS") << "\n";
+        if (!iguales) ++errores;
+    }
+
+    // 4. Lado a lado para varios k
+    std::cout << "\n" << std::setw(4) << "k" << std::setw(10) << "golpes" << std::setw(14) << "fallos/1000"
+              << std::setw(16) << "consultas/1000" << std::setw(14) << "pasos/s" << "\n";
+    ParallelEvalOptions opts;
+    opts.steps = 2000000;
+    for (const std::uint32_t k : {1u, 2u, 4u, 8u}) {
+        opts.action_repeat = k;
+        const EvalResult r = evaluate_parallel(politica, opts);
+        std::cout << std::fixed << std::setw(4) << k << std::setw(10) << std::setprecision(3) << r.hit_rate()
+                  << std::setw(14) << std::setprecision(2) << r.misses_per_1000() << std::setw(16)
+                  << std::setprecision(1) << 1000.0 * r.decisions / r.steps << std::setw(14) << std::setprecision(0)
+                  << r.steps_per_sec() << "\n";
+        // Cada consulta vale a lo sumo k pasos; se corta antes solo al perder la bola
+        if (r.decisions * k < r.steps || r.steps < opts.steps) ++errores;
+    }
+
+    // 5. Entrenamiento con acciones repetidas
+    DQNConfig<float> cfg;
+    cfg.total_steps = 20000;
+    cfg.log_every = 0;
+    cfg.action_repeat = 4;
+    DQNTrainer<float> dqn(cfg);
+    const auto entrenado = dqn.train();
+    ActorLearnerConfig<float> acfg;
+    acfg.dqn = cfg;
+    acfg.num_actors = 2;
+    ActorLearner<float> paralelo(acfg);
+    const auto entrenado_paralelo = paralelo.train();
+    std::cout << "\nDQN con action_repeat = 4: " << dqn.updates() << " actualizaciones"
+              << " | actor-aprendiz: " << (entrenado_paralelo ? "ok" : "sin red") << "\n";
+    if (!entrenado || !entrenado_paralelo || dqn.updates() == 0) ++errores;
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nRepeticion de acciones verificada\n";
+    return 0;
+}
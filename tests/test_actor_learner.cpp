@@ -0,0 +1,111 @@
+/**
+ * @file test_actor_learner.cpp
+ * @brief Verifica la cola SPSC y las copias de política, y compara DQN en un hilo contra actor–aprendiz.
+ *
+ * ### Flujo principal:
+ * 1. Un productor y un consumidor pasan millones de enteros por una SpscQueue pequeña:
+ *    deben llegar todos, en orden.
+ * 2. Un PolicySnapshot debe elegir las mismas acciones que la red de la que se copió.
+ * 3. Entrena con DQNTrainer y con ActorLearner el mismo número de transiciones y compara
+ *    velocidad y tasa de golpes en evaluación.
+ */
+
+#include "../include/agent/ActorLearner.h"
+#include "../include/agent/Evaluator.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+using namespace utec::nn;
+
+int main() {
+    int errores = 0;
+
+    // 1. Cola SPSC entre dos hilos
+    {
+        constexpr std::uint64_t N = 5000000;
+        utec::utils::SpscQueue<std::uint64_t> cola(1024);
+        std::thread productor([&] {
+            for (std::uint64_t i = 0; i < N; ++i)
+                while (!cola.try_push(i)) std::this_thread::yield();
+        });
+        std::uint64_t esperado = 0, desordenados = 0, valor;
+        const auto inicio = std::chrono::steady_clock::now();
+        while (esperado < N) {
+            if (cola.try_pop(valor)) {
+                desordenados += valor != esperado;
+                ++esperado;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        productor.join();
+        const double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        std::cout << "=== COLA SPSC ===\n";
+        std::cout << "Elementos: " << esperado << " | fuera de orden: " << desordenados << " | "
+                  << static_cast<long>(N / seg) << " elementos/s\n";
+        if (desordenados != 0) ++errores;
+    }
+
+    // 2. La copia de solo inferencia decide igual que la red
+    {
+        auto modelo = PongAgent<float>::build_sequential(32, 7);
+        PolicySnapshot<float> copia(*modelo, 1);
+        utec::utils::Xoshiro256 rng(11);
+        size_t distintas = 0;
+        for (int i = 0; i < 20000; ++i) {
+            const State s{rng.uniform01(), rng.uniform01(), rng.uniform01()};
+            distintas += copia.act(s) != PongAgent<float>::greedy_action(*modelo, s);
+        }
+        std::cout << "\n=== POLITICA PUBLICADA ===\n";
+        std::cout << "Acciones distintas entre red y copia: " << distintas << " de 20000\n";
+        if (distintas != 0) ++errores;
+    }
+
+    // 3. Mismo presupuesto en un hilo y con actores
+    DQNConfig<float> dqn;
+    dqn.total_steps = 200000;
+    dqn.log_every = 0;
+
+    auto evaluar = [](utec::neural_network::ILayer<float>& red) {
+        EnvGym env(99);
+        auto politica = [&](const State& s) { return PongAgent<float>::greedy_action(red, s); };
+        return evaluate_policy(politica, env, 20000).hit_rate();
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    DQNTrainer<float> sincrono(dqn);
+    auto red_sincrona = sincrono.train();
+    const double seg_sincrono = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    ActorLearnerConfig<float> cfg;
+    cfg.dqn = dqn;
+    cfg.dqn.log_every = 50000;
+    size_t esperas_actor = 0, esperas_aprendiz = 0;
+    inicio = std::chrono::steady_clock::now();
+    ActorLearner<float> paralelo(cfg);
+    auto red_paralela = paralelo.train([&](const ActorLearnerStats& s) {
+        esperas_actor += s.actor_stalls;
+        esperas_aprendiz += s.learner_waits;
+        std::cout << "  pasos " << s.steps << " | actualizaciones " << s.updates << " | politica v"
+                  << s.policy_version << " | golpes " << s.hit_rate() << "\n";
+    });
+    const double seg_paralelo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    const double golpes_sincrono = evaluar(*red_sincrona);
+    const double golpes_paralelo = evaluar(*red_paralela);
+    std::cout << "\n=== DQN (" << dqn.total_steps << " transiciones) ===\n";
+    std::cout << "Un hilo:        " << seg_sincrono << " s | tasa de golpes " << golpes_sincrono << "\n";
+    std::cout << "Actor-aprendiz: " << seg_paralelo << " s con " << paralelo.num_actors()
+              << " actores | tasa de golpes " << golpes_paralelo << "\n";
+    std::cout << "Esperas: actores con cola llena " << esperas_actor << ", aprendiz sin datos " << esperas_aprendiz << "\n";
+    if (golpes_paralelo < 0.5) ++errores;
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nActor-aprendiz verificado\n";
+    return 0;
+}
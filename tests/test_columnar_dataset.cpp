@@ -0,0 +1,186 @@
+/**
+ * @file test_columnar_dataset.cpp
+ * @brief Verifica el formato binario por columnas y mide el tiempo de apertura frente al CSV.
+ *
+ * ### Flujo principal:
+ * 1. Ida y vuelta: muestras -> binario -> PongColumns reproduce cada campo; las columnas
+ *    quedan alineadas a 64 bytes y las etiquetas ocupan un byte por fila.
+ * 2. Archivos inválidos (magia distinta, truncados, acción fuera de int8) se rechazan.
+ * 3. TensorView: slice sin copia, to_tensor y vista sobre un Tensor.
+ * 4. train_from_columns da exactamente los mismos pesos que train_from_samples.
+ * 5. Con 1M de filas se compara cargar el CSV contra abrir el binario y recorrer una columna.
+ */
+
+#include "../include/agent/PongAgent.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+using namespace utec::nn;
+
+namespace {
+
+std::vector<PongSample> random_samples(std::size_t n, std::uint64_t seed) {
+    utec::utils::Xoshiro256 rng(seed);
+    std::vector<PongSample> out(n);
+    for (auto& s : out)
+        s = {static_cast<float>(rng.uniform01()), static_cast<float>(rng.uniform01()),
+             static_cast<float>(rng.uniform(-0.03, 0.03)), static_cast<float>(rng.uniform(-0.03, 0.03)),
+             static_cast<float>(rng.uniform01()), static_cast<int>(rng.below(3)) - 1, rng.below(2) ? 1.0f : -1.0f};
+    return out;
+}
+
+bool same(const PongSample& a, const PongSample& b) {
+    return a.ball_x == b.ball_x && a.ball_y == b.ball_y && a.ball_vx == b.ball_vx && a.ball_vy == b.ball_vy
+           && a.paddle_y == b.paddle_y && a.action == b.action && a.reward == b.reward;
+}
+
+template <typename F>
+bool throws(F&& f) {
+    try {
+        f();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+    const std::string path = "/tmp/pong_columnas.bin";
+
+    // 1. Ida y vuelta
+    {
+        const auto muestras = random_samples(1001, 3);
+        save_pong_columns(path, muestras);
+        const PongColumns cols(path);
+        std::size_t distintas = 0;
+        for (std::size_t r = 0; r < muestras.size(); ++r) distintas += !same(muestras[r], cols.sample(r));
+        bool alineadas = true;
+        for (std::size_t c = 0; c < static_cast<std::size_t>(PongColumn::Count); ++c) {
+            const void* p = c == static_cast<std::size_t>(PongColumn::Action)
+                                ? static_cast<const void*>(cols.action().data())
+                                : static_cast<const void*>(cols.column(static_cast<PongColumn>(c)).data());
+            alineadas = alineadas && reinterpret_cast<std::uintptr_t>(p) % COLUMN_ALIGNMENT == 0;
+        }
+        const std::size_t csv_equivalente = 7 * 4 * muestras.size();
+        std::cout << "Ida y vuelta: " << cols.rows() << " filas, " << distintas << " distintas, columnas "
+                  << (alineadas ? "alineadas" : "DESALINEADAS") << ", " << cols.bytes() << " bytes ("
+                  << csv_equivalente << " como struct de 7 campos de 4 bytes)\n";
+        if (cols.rows() != muestras.size() || distintas || !alineadas || !is_columnar_file(path)) ++errores;
+
+        save_pong_columns(path, {});
+        if (PongColumns(path).rows() != 0) ++errores;
+    }
+
+    // 2. Archivos inválidos
+    {
+        std::ofstream("/tmp/pong_no_columnas.bin") << "ball_x,ball_y\n";
+        save_pong_columns(path, random_samples(100, 4));
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+        std::vector<PongSample> accion_grande(1, PongSample{0, 0, 0, 0, 0, 300, 0});
+        const bool ok = throws([] { PongColumns("/tmp/pong_no_columnas.bin"); })
+                        && throws([&] { PongColumns{path}; }) && throws([] { PongColumns("/tmp/no_existe.bin"); })
+                        && throws([&] { save_pong_columns(path, accion_grande); });
+        std::cout << "Archivos invalidos: " << (ok ? "rechazados" : "ACEPTADOS") << "\n";
+        if (!ok) ++errores;
+    }
+
+    // 3. TensorView
+    {
+        Tensor<float, 2> t(4, 3);
+        for (std::size_t i = 0; i < t.size(); ++i) t[i] = static_cast<float>(i);
+        TensorView<float, 2> v(t);
+        const TensorView<const float, 2> filas = TensorView<const float, 2>(v).slice(1, 3);
+        v(2, 1) = 100.0f;
+        const auto copia = filas.to_tensor();
+        const bool ok = filas.shape()[0] == 2 && filas.data() == t.data() + 3 && filas(1, 1) == 100.0f
+                        && copia(0, 0) == 3.0f && copia.shape() == filas.shape()
+                        && throws([&] { return filas(2, 0); });
+        std::cout << "TensorView: " << (ok ? "correcta" : "INCORRECTA") << "\n";
+        if (!ok) ++errores;
+    }
+
+    // 4. Mismo entrenamiento desde columnas
+    {
+        const auto muestras = random_samples(512, 5);
+        save_pong_columns(path, muestras);
+        const PongColumns cols(path);
+        TrainConfig<float> cfg;
+        cfg.epochs = 3;
+        cfg.batch_size = 32;
+        cfg.seed = 11;
+        auto a = PongAgent<float>::train_from_samples(muestras, cfg);
+        auto b = PongAgent<float>::train_from_columns(cols, cfg);
+        auto& sa = static_cast<PongAgent<float>::Sequential&>(*a);
+        auto& sb = static_cast<PongAgent<float>::Sequential&>(*b);
+        const auto& w1 = sa.l1->weights();
+        const auto& w2 = sb.l1->weights();
+        const auto& u1 = sa.l2->weights();
+        const auto& u2 = sb.l2->weights();
+        const bool iguales = std::equal(w1.begin(), w1.end(), w2.begin()) && std::equal(u1.begin(), u1.end(), u2.begin());
+        std::cout << "train_from_columns vs train_from_samples: " << (iguales ? "pesos identicos" : "DISTINTOS") << "\n";
+        if (!iguales) ++errores;
+    }
+
+    // 5. Apertura: CSV vs binario
+    {
+        constexpr std::size_t filas = 1'000'000;
+        const auto muestras = random_samples(filas, 6);
+        const std::string csv = "/tmp/pong_columnas.csv";
+        {
+            std::ofstream out(csv);
+            out << "ball_x,ball_y,ball_vx,ball_vy,paddle_y,action,reward\n";
+            char buf[160];
+            for (const auto& s : muestras) {
+                std::snprintf(buf, sizeof(buf), "%.9g,%.9g,%.9g,%.9g,%.9g,%d,%.9g\n", s.ball_x, s.ball_y, s.ball_vx,
+                              s.ball_vy, s.paddle_y, s.action, s.reward);
+                out << buf;
+            }
+        }
+        save_pong_columns(path, muestras);
+
+        auto t0 = std::chrono::steady_clock::now();
+        const auto desde_csv = load_pong_csv(csv).samples;
+        const double t_csv = seconds_since(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        const PongColumns cols(path);
+        const double t_abrir = seconds_since(t0);
+        double suma = 0.0;
+        for (const float x : cols.ball_x()) suma += x;
+        const double t_columna = seconds_since(t0);
+
+        std::size_t distintas = 0;
+        for (std::size_t r = 0; r < filas; ++r) distintas += !same(desde_csv[r], cols.sample(r));
+
+        std::cout << std::fixed << std::setprecision(2) << "\n" << filas << " filas: CSV "
+                  << std::filesystem::file_size(csv) / 1048576.0 << " MiB, binario " << cols.bytes() / 1048576.0
+                  << " MiB\n";
+        std::cout << std::setprecision(3) << "  cargar CSV (mmap + from_chars) : " << t_csv * 1e3 << " ms\n";
+        std::cout << "  abrir binario                  : " << t_abrir * 1e3 << " ms\n";
+        std::cout << "  abrir + recorrer ball_x        : " << t_columna * 1e3 << " ms (suma " << std::setprecision(1)
+                  << suma << ")\n";
+        std::cout << "  filas distintas entre formatos : " << distintas << "\n";
+        if (distintas || desde_csv.size() != filas) ++errores;
+        std::remove(csv.c_str());
+    }
+    std::remove(path.c_str());
+    std::remove("/tmp/pong_no_columnas.bin");
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nFormato por columnas verificado\n";
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file test_compiled_network.cpp
+ * @brief Verifica que una red compilada (`NeuralNetwork::compile`) entrene igual que la interpretada.
+ *
+ * ### Flujo principal:
+ * 1. Construye dos redes idénticas para XOR (Dense+ReLU, Dense+Sigmoid, Dense+Sigmoid).
+ * 2. Compila solo la segunda; el plan debe fusionar las tres parejas Dense+activación.
+ * 3. Entrena ambas con los mismos datos y compara predicciones y pérdida final.
+ * 4. forward(X, out) y predict(X, out) dan lo mismo que las versiones que devuelven un
+ *    Tensor y reutilizan `out` en vez de reservar otro.
+ */
+
+#include "../include/nn/neural_network.h"
+#include "../include/nn/dense.h"
+#include "../include/nn/activation.h"
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+using namespace utec::neural_network;
+using utec::algebra::Tensor;
+
+/// @brief Inicializador determinista para que ambas redes partan de los mismos pesos
+void init_weights(Tensor<float, 2>& t) {
+    for (size_t i = 0; i < t.size(); ++i)
+        t[i] = std::sin(static_cast<float>(i * 7 + t.shape()[1])) * 0.8f;
+}
+
+void build_xor(NeuralNetwork<float>& net) {
+    net.add_layer(std::make_unique<Dense<float>>(2, 16, init_weights));
+    net.add_layer(std::make_unique<ReLU<float>>());
+    net.add_layer(std::make_unique<Dense<float>>(16, 8, init_weights));
+    net.add_layer(std::make_unique<Sigmoid<float>>());
+    net.add_layer(std::make_unique<Dense<float>>(8, 1, init_weights));
+    net.add_layer(std::make_unique<Sigmoid<float>>());
+}
+
+int main() {
+    Tensor<float, 2> X(4, 2), Y(4, 1);
+    X = {0, 0, 0, 1, 1, 0, 1, 1};
+    Y = {0, 1, 1, 0};
+
+    NeuralNetwork<float> interpreted, compiled;
+    build_xor(interpreted);
+    build_xor(compiled);
+    compiled.compile(4);
+
+    std::cout << compiled.plan()->describe() << "\n";
+    if (compiled.plan()->steps().size() != 3) {
+        std::cout << "FALLO: se esperaban 3 pasos fusionados\n";
+        return 1;
+    }
+
+    interpreted.train<MSELoss>(X, Y, 2000, 4, 0.5f);
+    compiled.train<MSELoss>(X, Y, 2000, 4, 0.5f);
+
+    auto a = interpreted.predict(X);
+    auto b = compiled.predict(X);
+    float max_diff = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        max_diff = std::max(max_diff, std::abs(a[i] - b[i]));
+
+    std::cout << "Interpretada:\n" << a << "\nCompilada:\n" << b << "\n";
+    std::cout << "Diferencia maxima: " << max_diff << "\n";
+
+    // Salida en un Tensor del llamador: se reserva la primera vez y después se reutiliza
+    Tensor<float, 2> out;
+    compiled.predict(X, out);
+    const float* buffer = out.data();
+    bool reuse = true;
+    for (int rep = 0; rep < 3; ++rep) {
+        compiled.predict(X, out);
+        for (size_t i = 0; i < b.size(); ++i) reuse &= out[i] == b[i];
+        compiled.forward(X, out);
+        for (size_t i = 0; i < b.size(); ++i) reuse &= out[i] == b[i];
+        reuse &= out.data() == buffer;
+    }
+    std::cout << "predict(X, out) y forward(X, out): "
+              << (reuse ? "mismo resultado y mismo buffer" : "DISTINTOS o reservan otro buffer") << "\n";
+
+    bool ok = reuse && max_diff < 1e-4f && b[0] < 0.1f && b[1] > 0.9f && b[2] > 0.9f && b[3] < 0.1f;
+    std::cout << (ok ? "OK: la red compilada reproduce la interpretada\n"
+                     : "FALLO: la red compilada diverge\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file test_csv_loader.cpp
+ * @brief Verifica el cargador de CSV proyectado en memoria y mide su velocidad.
+ *
+ * ### Flujo principal:
+ * 1. Casos borde: encabezado, "\r\n", filas vacías, formato manual de 5 columnas, último
+ *    renglón sin salto de línea, filas mal formadas (con y sin skip_invalid) y campos con
+ *    espacios o tabuladores alrededor.
+ * 2. Un CSV generado de 1M de filas se carga con el lector anterior (getline + stringstream),
+ *    con el nuevo en 1 hilo y en paralelo; las muestras deben ser idénticas.
+ * 3. Data/pong_train.csv se carga completo (no tiene encabezado: no se pierde la primera fila).
+ */
+
+#include "../include/agent/CsvLoader.h"
+#include "../include/utils/random.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace utec::nn;
+
+namespace {
+
+std::string write_file(const std::string& name, const std::string& content) {
+    const std::string path = "/tmp/" + name;
+    std::ofstream(path, std::ios::binary) << content;
+    return path;
+}
+
+bool same(const PongSample& a, const PongSample& b) {
+    return a.ball_x == b.ball_x && a.ball_y == b.ball_y && a.ball_vx == b.ball_vx && a.ball_vy == b.ball_vy
+           && a.paddle_y == b.paddle_y && a.action == b.action && a.reward == b.reward;
+}
+
+bool same(const std::vector<PongSample>& a, const std::vector<PongSample>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const PongSample& x, const PongSample& y) { return same(x, y); });
+}
+
+/// Lector anterior: getline por fila y por campo, stof/stoi
+std::vector<PongSample> load_getline(const std::string& path) {
+    std::vector<PongSample> data;
+    std::ifstream file(path);
+    std::string line, val;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        PongSample s;
+        std::getline(ss, val, ','); s.ball_x = std::stof(val);
+        std::getline(ss, val, ','); s.ball_y = std::stof(val);
+        std::getline(ss, val, ','); s.ball_vx = std::stof(val);
+        std::getline(ss, val, ','); s.ball_vy = std::stof(val);
+        std::getline(ss, val, ','); s.paddle_y = std::stof(val);
+        std::getline(ss, val, ','); s.action = std::stoi(val);
+        std::getline(ss, val, ','); s.reward = std::stof(val);
+        data.push_back(s);
+    }
+    return data;
+}
+
+template <typename F>
+double seconds(F&& f) {
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1. Casos borde
+    {
+        const auto path = write_file("csv_bordes.csv",
+                                     "\xEF\xBB\xBF" "ball_x,ball_y,ball_vx,ball_vy,paddle_y,action,reward\r\n"
+                                     "0.5,0.25,-0.02,0.01,0.75,1,1\r\n"
+                                     "\r\n"
+                                     "1e-3,0,0,0,1,-1,-1\n"
+                                     "\n"
+                                     "0.53,0.51,0.55,0,-0.01\n"
+                                     "0.1,0.2,0.3,0.4,0.5,0,0.5");
+        const auto r = load_pong_csv(path);
+        const std::vector<PongSample> esperado{{0.5f, 0.25f, -0.02f, 0.01f, 0.75f, 1, 1.0f},
+                                               {1e-3f, 0.0f, 0.0f, 0.0f, 1.0f, -1, -1.0f},
+                                               {0.53f, 0.51f, 0.0f, 0.0f, 0.55f, 0, -0.01f},
+                                               {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0, 0.5f}};
+        const bool ok = same(r.samples, esperado) && r.skipped == 0;
+        std::cout << "Casos borde: " << r.samples.size() << " filas " << (ok ? "correctas" : "INCORRECTAS") << "\n";
+        if (!ok) ++errores;
+
+        const auto malo = write_file("csv_malo.csv", "0.1,0.2,0.3,0.4,0.5,0,1\n0.1,0.2,x,0.4,0.5,0,1\n"
+                                                     "0.1,0.2,0.3\n0.1,0.2,0.3,0.4,0.5,1.5,1\n0,0,0,0,0,1,1\n");
+        std::string mensaje;
+        try {
+            load_pong_csv(malo);
+        } catch (const std::runtime_error& e) {
+            mensaje = e.what();
+        }
+        CsvLoadOptions saltar;
+        saltar.skip_invalid = true;
+        const auto r2 = load_pong_csv(malo, saltar);
+        const bool ok2 = mensaje.find("linea 2") != std::string::npos && r2.samples.size() == 2 && r2.skipped == 3;
+        std::cout << "Filas mal formadas: \"" << mensaje << "\", saltadas " << r2.skipped << "\n";
+        if (!ok2) ++errores;
+
+        bool lanza = false;
+        try {
+            load_pong_csv("/tmp/no_existe_pong.csv");
+        } catch (const std::runtime_error&) {
+            lanza = true;
+        }
+        if (!lanza || !load_pong_csv(write_file("csv_vacio.csv", "")).samples.empty()) ++errores;
+
+        // Espacios y tabuladores alrededor de los campos (el lector con stof/stoi los aceptaba)
+        const auto espacios = write_file("csv_espacios.csv", "ball_x, ball_y, ball_vx, ball_vy, paddle_y, action, reward\n"
+                                                             "0.1, 0.2, 0.0, 0.0, 0.5, 1, 1\n"
+                                                             "\t0.3 ,0.4,\t-0.01 , 0.02,0.6 , -1 ,\t-1 \n"
+                                                             " 0.53, 0.51, 0.55, 0, -0.01\n");
+        const auto r3 = load_pong_csv(espacios);
+        const std::vector<PongSample> esperado3{{0.1f, 0.2f, 0.0f, 0.0f, 0.5f, 1, 1.0f},
+                                                {0.3f, 0.4f, -0.01f, 0.02f, 0.6f, -1, -1.0f},
+                                                {0.53f, 0.51f, 0.0f, 0.0f, 0.55f, 0, -0.01f}};
+        const bool ok3 = same(r3.samples, esperado3) && r3.skipped == 0;
+        std::cout << "Campos con espacios: " << r3.samples.size() << " filas "
+                  << (ok3 ? "correctas" : "INCORRECTAS") << "\n";
+        if (!ok3) ++errores;
+    }
+
+    // 2. Archivo grande: lector anterior vs nuevo
+    {
+        constexpr std::size_t filas = 1'000'000;
+        utec::utils::Xoshiro256 rng(7);
+        std::string contenido = "ball_x,ball_y,ball_vx,ball_vy,paddle_y,action,reward\n";
+        char buf[160];
+        for (std::size_t i = 0; i < filas; ++i) {
+            const int n = std::snprintf(buf, sizeof(buf), "%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d\n", rng.uniform01(),
+                                        rng.uniform01(), rng.uniform(-0.03, 0.03), rng.uniform(-0.03, 0.03),
+                                        rng.uniform01(), static_cast<int>(rng.below(3)) - 1,
+                                        rng.below(2) ? 1 : -1);
+            contenido.append(buf, static_cast<std::size_t>(n));
+        }
+        const auto path = write_file("csv_grande.csv", contenido);
+        const double mb = static_cast<double>(contenido.size()) / (1 << 20);
+
+        std::vector<PongSample> antes, uno, varios;
+        CsvLoadOptions un_hilo;
+        un_hilo.threads = 1;
+        CsvLoadOptions paralelo;
+        paralelo.threads = std::max(2u, std::thread::hardware_concurrency());
+        const double t_antes = seconds([&] { antes = load_getline(path); });
+        const double t_uno = seconds([&] { uno = load_pong_csv(path, un_hilo).samples; });
+        const double t_varios = seconds([&] { varios = load_pong_csv(path, paralelo).samples; });
+
+        std::cout << std::fixed << std::setprecision(1) << "\nCSV de " << filas << " filas (" << mb << " MiB)\n";
+        std::cout << "  getline + stringstream : " << std::setw(7) << mb / t_antes << " MiB/s\n";
+        std::cout << "  mmap + from_chars 1 h  : " << std::setw(7) << mb / t_uno << " MiB/s ("
+                  << t_antes / t_uno << "x)\n";
+        std::cout << "  mmap + from_chars " << paralelo.threads << " h  : " << std::setw(7) << mb / t_varios
+                  << " MiB/s (" << t_antes / t_varios << "x)\n";
+        const bool iguales = antes.size() == filas && same(antes, uno) && same(antes, varios);
+        std::cout << "  Muestras: " << (iguales ? "identicas" : "DISTINTAS") << "\n";
+        if (!iguales) ++errores;
+        std::remove(path.c_str());
+    }
+
+    // 3. Datos del repositorio
+    {
+        std::ifstream f("Data/pong_train.csv");
+        if (f) {
+            std::size_t lineas = 0;
+            for (std::string l; std::getline(f, l);) lineas += !l.empty();
+            const auto r = load_pong_csv("Data/pong_train.csv");
+            std::cout << "\nData/pong_train.csv: " << r.samples.size() << " de " << lineas << " filas\n";
+            if (r.samples.size() != lineas) ++errores;
+        }
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nCargador de CSV verificado\n";
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_evolution_strategies.cpp
+ * @brief Verifica el entrenador por estrategias evolutivas y mide el tiempo hasta la calidad objetivo.
+ *
+ * ### Flujo principal:
+ * 1. Los parámetros planos reproducen la red: flatten/unflatten y PolicySnapshot desde el
+ *    vector plano dan las mismas acciones que el modelo.
+ * 2. Los rangos centrados suman 0 y los empates reciben el mismo peso.
+ * 3. Con la misma semilla el resultado no depende de la cantidad de hilos.
+ * 4. Entrena hasta una tasa de golpes de 0.9 e informa el tiempo que tomó.
+ */
+
+#include "../include/agent/EvolutionStrategies.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+using namespace utec::nn;
+using ES = EvolutionStrategies<float>;
+
+int main() {
+    int errores = 0;
+
+    // 1. Parámetros planos
+    {
+        auto modelo = PongAgent<float>::build_sequential(8, 3);
+        const auto plano = ES::flatten(*modelo);
+        const PolicySnapshot<float> desde_modelo(*modelo, 1);
+        const PolicySnapshot<float> desde_plano(plano, 8, 1);
+        auto copia = PongAgent<float>::build_sequential(8, 99);
+        ES::unflatten(plano, *copia);
+        utec::utils::Xoshiro256 rng(4);
+        std::size_t distintos = 0;
+        for (int i = 0; i < 50000; ++i) {
+            const State s{rng.uniform01(), rng.uniform01(), rng.uniform01()};
+            const int a = desde_modelo.act(s);
+            distintos += a != desde_plano.act(s);
+            distintos += a != PongAgent<float>::greedy_action(*copia, s);
+        }
+        std::cout << "Parametros: " << plano.size() << " (7H + 3) | acciones distintas: " << distintos << "\n";
+        if (plano.size() != PolicySnapshot<float>::parameter_count(8) || distintos) ++errores;
+    }
+
+    // 2. Rangos centrados
+    {
+        const std::vector<double> retornos{3.0, -1.0, 3.0, 10.0, 0.5};
+        const auto w = ES::centered_ranks(retornos);
+        const double suma = std::accumulate(w.begin(), w.end(), 0.0);
+        const bool ok = std::abs(suma) < 1e-12 && w[0] == w[2] && w[3] == 0.5 && w[1] == -0.5;
+        const std::vector<double> iguales(6, -5.0);
+        const auto cero = ES::centered_ranks(iguales);
+        const bool quieto = std::all_of(cero.begin(), cero.end(), [](double v) { return v == 0.0; });
+        std::cout << "Rangos centrados: " << (ok && quieto ? "correctos" : "INCORRECTOS") << "\n";
+        if (!ok || !quieto) ++errores;
+    }
+
+    // 3. Mismo resultado con 1 y 3 hilos
+    {
+        ESConfig<float> cfg;
+        cfg.generations = 5;
+        cfg.population = 32;
+        cfg.episodes = 8;
+        cfg.eval_every = 0;
+        cfg.noise_size = 1 << 16;
+        cfg.threads = 1;
+        ES uno(cfg);
+        uno.train();
+        cfg.threads = 3;
+        ES tres(cfg);
+        tres.train();
+        const auto a = uno.parameters();
+        const auto b = tres.parameters();
+        const bool iguales = std::equal(a.begin(), a.end(), b.begin(), b.end());
+        std::cout << "1 hilo vs 3 hilos: " << (iguales ? "parametros identicos" : "DISTINTOS") << "\n";
+        if (!iguales) ++errores;
+    }
+
+    // 4. Tiempo hasta la calidad objetivo
+    {
+        ESConfig<float> cfg;
+        cfg.target_hit_rate = 0.9;
+        cfg.stop_at_target = true;
+        ES es(cfg);
+        std::cout << "\nEntrenando (poblacion " << cfg.population << ", " << cfg.episodes << " episodios por miembro)\n";
+        std::cout << std::fixed;
+        auto modelo = es.train([](const ESStats& s) {
+            if (s.hit_rate < 0 || s.generation % 25 != 0) return;
+            std::cout << "  generacion " << std::setw(4) << s.generation << " | retorno " << std::setprecision(2)
+                      << std::setw(7) << s.mean_return << " | golpes " << std::setprecision(3) << s.hit_rate
+                      << " | " << std::setprecision(0) << s.episodes_per_sec << " episodios/s\n";
+        });
+        const double final = es.evaluate().hit_rate();
+        std::cout << std::setprecision(2) << "Tiempo hasta golpes >= 0.9: ";
+        if (es.time_to_quality() < 0)
+            std::cout << "no se alcanzo en " << es.generations() << " generaciones\n";
+        else
+            std::cout << es.time_to_quality() << " s (generacion " << es.generation_to_quality() << ")\n";
+        std::cout << "Tasa de golpes final: " << std::setprecision(3) << final << "\n";
+        if (!modelo || es.time_to_quality() < 0) ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nEstrategias evolutivas verificadas\n";
+    return 0;
+}
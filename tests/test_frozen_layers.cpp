@@ -0,0 +1,191 @@
+/**
+ * @file test_frozen_layers.cpp
+ * @brief Verifica freeze_layer y requires_input_grad en la red interpretada y en la compilada.
+ *
+ * ### Flujo principal:
+ * 1. Las capas congeladas quedan idénticas bit a bit después de entrenar, en los dos caminos.
+ * 2. Las capas entrenables reciben la misma actualización con la red interpretada y con la
+ *    compilada, y congelar la primera capa no cambia la actualización de las de arriba.
+ * 3. El backward se detiene en la capa entrenable más baja: solo las capas de arriba piden dX,
+ *    una capa espía debajo de ella no recibe ningún backward, y una Dense sin requires_input_grad
+ *    devuelve un gradiente vacío.
+ */
+
+#include "../include/nn/activation.h"
+#include "../include/nn/dense.h"
+#include "../include/nn/neural_network.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace utec::neural_network;
+using utec::algebra::Tensor;
+
+namespace {
+
+void init_weights(Tensor<float, 2>& t) {
+    for (size_t i = 0; i < t.size(); ++i) t[i] = std::sin(static_cast<float>(i * 7 + t.shape()[1])) * 0.5f;
+}
+
+void init_bias(Tensor<float, 2>& t) {
+    for (size_t i = 0; i < t.size(); ++i) t[i] = std::cos(static_cast<float>(i)) * 0.1f;
+}
+
+/// @brief Capa identidad que cuenta cuántas veces se le pide el backward
+struct Spy : ILayer<float> {
+    int backward_calls = 0;
+    Tensor<float, 2> forward(const Tensor<float, 2>& input) override { return input; }
+    Tensor<float, 2> backward(const Tensor<float, 2>& grad) override {
+        ++backward_calls;
+        return grad;
+    }
+    void update_params(IOptimizer<float>&) override {}
+};
+
+/// @brief Dense(4,16)+ReLU, Dense(16,8)+Sigmoid, Dense(8,2)+Sigmoid
+void build(NeuralNetwork<float>& net) {
+    net.add_layer(std::make_unique<Dense<float>>(4, 16, init_weights, init_bias));
+    net.add_layer(std::make_unique<ReLU<float>>());
+    net.add_layer(std::make_unique<Dense<float>>(16, 8, init_weights, init_bias));
+    net.add_layer(std::make_unique<Sigmoid<float>>());
+    net.add_layer(std::make_unique<Dense<float>>(8, 2, init_weights, init_bias));
+    net.add_layer(std::make_unique<Sigmoid<float>>());
+}
+
+Dense<float>& dense(NeuralNetwork<float>& net, size_t i) { return dynamic_cast<Dense<float>&>(net.layer(i)); }
+
+/// @brief Parámetros de la Dense `i` (pesos y bias) como un vector
+std::vector<float> params(NeuralNetwork<float>& net, size_t i) {
+    auto& d = dense(net, i);
+    std::vector<float> p(d.weights().begin(), d.weights().end());
+    p.insert(p.end(), d.bias().begin(), d.bias().end());
+    return p;
+}
+
+bool same_bits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+float max_diff(const std::vector<float>& a, const std::vector<float>& b) {
+    float d = 0;
+    for (size_t i = 0; i < a.size(); ++i) d = std::max(d, std::abs(a[i] - b[i]));
+    return d;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    Tensor<float, 2> X(64, 4), Y(64, 2);
+    for (size_t i = 0; i < X.size(); ++i) X[i] = std::sin(static_cast<float>(i) * 0.37f);
+    for (size_t r = 0; r < 64; ++r) {
+        Y(r, 0) = X(r, 0) * X(r, 1) > 0 ? 1.0f : 0.0f;
+        Y(r, 1) = 1.0f - Y(r, 0);
+    }
+
+    // 1 y 2. Congeladas intactas; entrenables iguales en ambos caminos
+    {
+        NeuralNetwork<float> interpretada, compilada, libre;
+        build(interpretada);
+        build(compilada);
+        build(libre);
+        const auto inicial0 = params(interpretada, 0), inicial2 = params(interpretada, 2);
+        interpretada.freeze_layer(0);
+        compilada.freeze_layer(0);
+        compilada.compile(16);
+
+        // Un paso: congelar la capa 0 no cambia la actualización de las capas 2 y 4
+        interpretada.train<MSELoss>(X, Y, 1, 64, 0.5f);
+        libre.train<MSELoss>(X, Y, 1, 64, 0.5f);
+        const bool un_paso = same_bits(params(interpretada, 2), params(libre, 2))
+                             && same_bits(params(interpretada, 4), params(libre, 4))
+                             && !same_bits(params(libre, 0), inicial0);
+
+        compilada.train<MSELoss>(X, Y, 1, 64, 0.5f);   // lote mayor que el plan: camino interpretado
+        interpretada.train<MSELoss>(X, Y, 50, 16, 0.5f);
+        compilada.train<MSELoss>(X, Y, 50, 16, 0.5f);  // lote de 16: con el plan
+
+        const bool intactas = same_bits(params(interpretada, 0), inicial0) && same_bits(params(compilada, 0), inicial0);
+        const float d2 = max_diff(params(interpretada, 2), params(compilada, 2));
+        const float d4 = max_diff(params(interpretada, 4), params(compilada, 4));
+        const bool entrenan = !same_bits(params(interpretada, 2), inicial2);
+
+        std::cout << "Capa 0 congelada: " << (intactas ? "identica bit a bit" : "CAMBIO")
+                  << " tras 51 epocas (interpretada y compilada)\n"
+                  << "Un paso con la capa 0 congelada: capas 2 y 4 " << (un_paso ? "iguales" : "DISTINTAS")
+                  << " a la red sin congelar\n"
+                  << "Capas entrenables, interpretada vs compilada: diferencia maxima " << std::scientific
+                  << std::setprecision(2) << d2 << " (capa 2), " << d4 << " (capa 4)" << std::defaultfloat << "\n";
+        if (!intactas || !un_paso || !entrenan || d2 > 1e-5f || d4 > 1e-5f) ++errores;
+
+        // Congelar todas las Dense: nada cambia en ningún camino
+        const auto antes = params(compilada, 4);
+        for (size_t i : {2u, 4u}) {
+            interpretada.freeze_layer(i);
+            compilada.freeze_layer(i);
+        }
+        compilada.compile(16);
+        compilada.train<MSELoss>(X, Y, 3, 16, 0.5f);
+        const bool todas = same_bits(params(compilada, 4), antes);
+        std::cout << "Todas las Dense congeladas (plan recompilado): " << (todas ? "ningun cambio" : "CAMBIO") << "\n";
+        if (!todas) ++errores;
+    }
+
+    // 3. El backward se detiene en la capa entrenable más baja
+    {
+        NeuralNetwork<float> red;
+        red.add_layer(std::make_unique<Dense<float>>(4, 16, init_weights, init_bias));
+        red.add_layer(std::make_unique<Spy>());
+        red.add_layer(std::make_unique<Dense<float>>(16, 8, init_weights, init_bias));
+        red.add_layer(std::make_unique<ReLU<float>>());
+        red.add_layer(std::make_unique<Dense<float>>(8, 2, init_weights, init_bias));
+        auto& espia = dynamic_cast<Spy&>(red.layer(1));
+
+        red.train<MSELoss>(X, Y, 2, 16, 0.1f);
+        const int con_capa0 = espia.backward_calls;   // la capa 0 entrena: el espía propaga
+
+        red.freeze_layer(0);
+        espia.backward_calls = 0;
+        red.train<MSELoss>(X, Y, 2, 16, 0.1f);
+        const int sin_capa0 = espia.backward_calls;
+
+        auto flags = [&red] {
+            std::string pide;
+            for (size_t i = 0; i < red.size(); ++i) pide += red.layer(i).requires_input_grad() ? '1' : '0';
+            return pide;
+        };
+        const std::string desde2 = flags();   // la más baja entrenable es la 2
+        red.freeze_layer(2);                  // pasa a ser la 4, la última
+        const std::string desde4 = flags();
+
+        Dense<float> sola(4, 3, init_weights, init_bias);
+        sola.set_frozen(true);
+        sola.set_requires_input_grad(false);
+        sola.forward(X);
+        Tensor<float, 2> g(64, 3);
+        g.fill(1.0f);
+        const bool vacio = sola.backward(g).size() == 0;
+
+        std::cout << "Backward del espia: " << con_capa0 << " con la capa 0 entrenable, " << sin_capa0
+                  << " con la capa 0 congelada\n"
+                  << "requires_input_grad por capa: " << desde2 << " con la capa 0 congelada (esperado 00011), "
+                  << desde4 << " con las capas 0 y 2 congeladas (esperado 00000)\n"
+                  << "Dense congelada sin requires_input_grad: "
+                  << (vacio ? "gradiente vacio" : "CALCULA dX") << "\n";
+        if (con_capa0 != 8 || sin_capa0 != 0 || desde2 != "00011" || desde4 != "00000" || !vacio) ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nCapas congeladas verificadas\n";
+    return 0;
+}
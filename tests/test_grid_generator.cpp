@@ -0,0 +1,137 @@
+/**
+ * @file test_grid_generator.cpp
+ * @brief Verifica el generador de datos sobre grilla y mide su velocidad de escritura.
+ *
+ * ### Flujo principal:
+ * 1. La grilla por índices enteros incluye los extremos 0 y 1 exactos y coincide con un
+ *    recorrido de referencia (acción ideal + acción incorrecta por punto).
+ * 2. El CSV y el binario se leen de vuelta (load_pong_csv / PongColumns) con las mismas filas.
+ * 3. La salida es idéntica byte a byte con 1 y con varios hilos.
+ * 4. Genera ~8M de filas en CSV y en binario e informa filas por minuto.
+ */
+
+#include "../include/agent/CsvLoader.h"
+#include "../include/agent/GridGenerator.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+using namespace utec::nn;
+
+namespace {
+
+bool same(const PongSample& a, const PongSample& b) {
+    return a.ball_x == b.ball_x && a.ball_y == b.ball_y && a.ball_vx == b.ball_vx && a.ball_vy == b.ball_vy
+           && a.paddle_y == b.paddle_y && a.action == b.action && a.reward == b.reward;
+}
+
+bool same(const std::vector<PongSample>& a, const std::vector<PongSample>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const PongSample& x, const PongSample& y) { return same(x, y); });
+}
+
+std::string read_all(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1. Grilla por defecto contra un recorrido de referencia
+    const GridGenerator grid{GridSpec{}};
+    std::vector<PongSample> filas;
+    grid.generate(0, grid.points(), filas);
+    {
+        std::vector<PongSample> referencia;
+        for (int ix = 0; ix <= 10; ++ix)
+            for (int iy = 0; iy <= 10; ++iy)
+                for (float vx : {-0.02f, 0.02f})
+                    for (float vy : {-0.01f, 0.01f})
+                        for (int ip = 0; ip <= 10; ++ip) {
+                            const float bx = ix / 10.0f, by = iy / 10.0f, py = ip / 10.0f;
+                            const int a = by > py + 0.05f ? 1 : (by < py - 0.05f ? -1 : 0);
+                            referencia.push_back({bx, by, vx, vy, py, a, 1.0f});
+                            referencia.push_back({bx, by, vx, vy, py, a == 1 ? -1 : 1, -1.0f});
+                        }
+        const bool extremos = filas.front().ball_x == 0.0f && filas.back().ball_x == 1.0f
+                              && filas.back().paddle_y == 1.0f;
+        const bool ok = same(filas, referencia) && grid.rows() == 10648 && extremos;
+        std::cout << "Grilla 11x11x2x2x11: " << filas.size() << " filas, extremos 0 y 1 "
+                  << (extremos ? "incluidos" : "FALTAN") << ", " << (ok ? "igual a la referencia" : "DISTINTA")
+                  << "\n";
+        if (!ok) ++errores;
+
+        // Bloques que empiezan en mitad de un eje
+        std::vector<PongSample> tramo;
+        grid.generate(1234, 777, tramo);
+        const bool tramo_ok = std::equal(tramo.begin(), tramo.end(), filas.begin() + 2468,
+                                         [](const PongSample& x, const PongSample& y) { return same(x, y); });
+        if (!tramo_ok || tramo.size() != 1554) ++errores;
+    }
+
+    // 2 y 3. CSV y binario de ida y vuelta, 1 vs varios hilos
+    {
+        GridSpec spec;
+        spec.ball_x_steps = 37;
+        spec.ball_y_steps = 41;
+        spec.paddle_steps = 29;
+        spec.ball_vx = {-0.03f, 0.0f, 0.03f};
+        const GridGenerator g(spec);
+        std::vector<PongSample> esperadas;
+        g.generate(0, g.points(), esperadas);
+
+        const std::size_t hilos = std::max(2u, std::thread::hardware_concurrency());
+        g.write_csv("/tmp/grilla_1.csv", 1);
+        g.write_csv("/tmp/grilla_n.csv", hilos);
+        g.write_columns("/tmp/grilla_1.bin", 1);
+        g.write_columns("/tmp/grilla_n.bin", hilos);
+
+        const bool csv_ok = same(load_pong_csv("/tmp/grilla_n.csv").samples, esperadas);
+        const bool bin_ok = same(PongColumns("/tmp/grilla_n.bin").samples(), esperadas);
+        const bool iguales = read_all("/tmp/grilla_1.csv") == read_all("/tmp/grilla_n.csv")
+                             && read_all("/tmp/grilla_1.bin") == read_all("/tmp/grilla_n.bin");
+        std::cout << "Grilla de " << g.rows() << " filas: CSV " << (csv_ok ? "correcto" : "INCORRECTO") << ", binario "
+                  << (bin_ok ? "correcto" : "INCORRECTO") << ", 1 vs " << hilos << " hilos "
+                  << (iguales ? "identicos" : "DISTINTOS") << "\n";
+        if (!csv_ok || !bin_ok || !iguales) ++errores;
+        for (const char* f : {"/tmp/grilla_1.csv", "/tmp/grilla_n.csv", "/tmp/grilla_1.bin", "/tmp/grilla_n.bin"})
+            std::remove(f);
+    }
+
+    // 4. Velocidad
+    {
+        GridSpec spec;
+        spec.ball_x_steps = 101;
+        spec.ball_y_steps = 101;
+        spec.paddle_steps = 101;
+        spec.ball_vx = {-0.02f, 0.02f};
+        spec.ball_vy = {-0.01f, 0.01f};
+        const GridGenerator g(spec);
+        const auto csv = g.write_csv("/tmp/grilla_grande.csv");
+        const auto bin = g.write_columns("/tmp/grilla_grande.bin");
+        std::cout << std::fixed << std::setprecision(1) << "\n" << g.rows() / 1e6 << "M filas\n";
+        std::cout << "  CSV     : " << std::setw(7) << csv.bytes / 1048576.0 << " MiB en " << std::setprecision(2)
+                  << csv.seconds << " s -> " << std::setprecision(0) << csv.rows_per_sec() * 60 / 1e6
+                  << "M filas/min\n";
+        std::cout << std::setprecision(1) << "  binario : " << std::setw(7) << bin.bytes / 1048576.0 << " MiB en "
+                  << std::setprecision(2) << bin.seconds << " s -> " << std::setprecision(0)
+                  << bin.rows_per_sec() * 60 / 1e6 << "M filas/min\n";
+        if (csv.rows != g.rows() || PongColumns("/tmp/grilla_grande.bin").rows() != g.rows()) ++errores;
+        std::remove("/tmp/grilla_grande.csv");
+        std::remove("/tmp/grilla_grande.bin");
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nGenerador de datos verificado\n";
+    return 0;
+}
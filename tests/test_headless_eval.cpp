@@ -0,0 +1,72 @@
+/**
+ * @file test_headless_eval.cpp
+ * @brief Verifica la evaluación en paralelo sin pantalla y la compara con evaluate_policy.
+ *
+ * ### Flujo principal:
+ * 1. Carga el modelo guardado en Data/ (o uno aleatorio si no existe).
+ * 2. Evalúa con evaluate_policy (un entorno, un hilo) y con evaluate_parallel.
+ * 3. Comprueba que se simulan exactamente los pasos pedidos, que la misma semilla repite el
+ *    resultado y que el modo por episodios se detiene al alcanzar la cuota.
+ */
+
+#include "../include/agent/Evaluator.h"
+#include <iomanip>
+#include <iostream>
+
+using namespace utec::nn;
+
+void imprimir(const std::string& nombre, const EvalResult& r) {
+    std::cout << std::left << std::setw(28) << nombre << std::right << std::fixed
+              << " pasos " << std::setw(9) << r.steps
+              << " | golpes " << std::setprecision(3) << r.hit_rate()
+              << " | fallos/1000 " << std::setprecision(2) << r.misses_per_1000()
+              << " | episodio " << std::setprecision(1) << r.mean_episode_length()
+              << " | " << std::setprecision(0) << r.steps_per_sec() << " pasos/s\n";
+}
+
+int main() {
+    int errores = 0;
+
+    std::unique_ptr<utec::neural_network::ILayer<float>> modelo;
+    try {
+        modelo = PongAgent<float>::create_sequential_with_weights("Data/pong_model_dense1.weights",
+                                                                  "Data/pong_model_dense2.weights");
+        std::cout << "Modelo cargado desde Data/\n";
+    } catch (const std::exception&) {
+        modelo = PongAgent<float>::build_sequential(8, 3);
+        std::cout << "Sin pesos en Data/: se usa un modelo aleatorio\n";
+    }
+    const PolicySnapshot<float> politica(static_cast<PongAgent<float>::Sequential&>(*modelo), 1);
+
+    // 1. Referencia: un entorno, un hilo
+    EnvGym env(7);
+    const EvalResult base = evaluate_policy([&](const State& s) { return politica.act(s); }, env, 1000000);
+    imprimir("evaluate_policy (1 entorno)", base);
+
+    // 2. En paralelo: pasos exactos y repetible con la misma semilla
+    ParallelEvalOptions opts;
+    opts.steps = 4000000;
+    opts.threads = 4;
+    const EvalResult a = evaluate_parallel(politica, opts);
+    const EvalResult b = evaluate_parallel(politica, opts);
+    imprimir("evaluate_parallel (4 hilos)", a);
+    if (a.steps != opts.steps) ++errores;
+    if (a.hits != b.hits || a.misses != b.misses || a.episode_steps != b.episode_steps) {
+        std::cout << "ERROR: la misma semilla dio resultados distintos\n";
+        ++errores;
+    }
+
+    // 3. Por episodios: termina al completar la cuota (repartida entre hilos)
+    opts.steps = 100000000;
+    opts.episodes = 2000;
+    const EvalResult c = evaluate_parallel(politica, opts);
+    imprimir("2000 episodios", c);
+    if (c.misses < opts.episodes || c.steps >= opts.steps) ++errores;
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nEvaluacion sin pantalla verificada\n";
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_input_normalization.cpp
+ * @brief Verifica las estadísticas en una pasada y la normalización plegada en la primera capa.
+ *
+ * ### Flujo principal:
+ * 1. feature_stats coincide con la media y varianza de dos pasadas aun con valores grandes y
+ *    dispersión chica, da los mismos bits con uno o varios hilos, y una fila con peso k cuenta
+ *    como k filas repetidas.
+ * 2. fold_into: la capa plegada con entradas crudas da lo mismo que la original con entradas
+ *    estandarizadas.
+ * 3. Entrenamiento con normalize_inputs: el modelo que recibe on_epoch en la última época ya
+ *    está plegado (elige lo mismo que el devuelto con entradas crudas), y la pérdida final no es
+ *    peor que sin normalizar.
+ * 4. Rangos de las 5 características de datos de rollout (incluidas las velocidades, que hoy la
+ *    red no usa) para ver la diferencia de escalas.
+ */
+
+#include "../include/agent/InputNormalization.h"
+#include "../include/agent/PongAgent.h"
+#include "../include/agent/RolloutGenerator.h"
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace utec::nn;
+using utec::algebra::Tensor;
+using utec::neural_network::Dense;
+
+namespace {
+
+bool close(double a, double b, double rel) { return std::abs(a - b) <= rel * std::max(1.0, std::abs(b)); }
+
+bool same_bits(const FeatureStats<1>& a, const FeatureStats<1>& b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1. Estadísticas
+    {
+        const std::size_t n = 1'000'003;
+        std::vector<double> valores(n);
+        utec::utils::Xoshiro256 rng(11);
+        for (auto& v : valores) v = 1e6 + rng.uniform01() * 1e-2;
+
+        auto fila = [&](std::size_t i, std::array<double, 1>& x) {
+            x[0] = valores[i];
+            return 1.0;
+        };
+        const auto uno = feature_stats<1>(n, fila, 1);
+        const auto varios = feature_stats<1>(n, fila, 4);
+
+        long double suma = 0, cuadrados = 0;
+        for (double v : valores) suma += v;
+        const long double media = suma / n;
+        for (double v : valores) cuadrados += (v - media) * (v - media);
+        const double varianza = static_cast<double>(cuadrados / n);
+
+        const bool exacta = close(uno[0].mean, static_cast<double>(media), 1e-12)
+                            && close(uno[0].variance(), varianza, 1e-6);
+        const bool hilos = same_bits(uno, varios);
+
+        // Peso k == k filas repetidas
+        std::vector<std::pair<double, int>> pesadas{{0.5, 3}, {2.0, 1}, {-1.0, 4}, {7.0, 2}};
+        RunningStats con_peso, repetidas;
+        for (const auto& [x, k] : pesadas) {
+            con_peso.add(x, k);
+            for (int j = 0; j < k; ++j) repetidas.add(x);
+        }
+        const bool pesos = close(con_peso.mean, repetidas.mean, 1e-12) && close(con_peso.variance(), repetidas.variance(), 1e-12);
+
+        std::cout << std::setprecision(10) << "Estadisticas de " << n << " valores ~1e6: media " << uno[0].mean
+                  << ", varianza " << uno[0].variance() << " (dos pasadas: " << varianza << ") "
+                  << (exacta ? "coincide" : "DISTINTA") << ", 1 y 4 hilos " << (hilos ? "mismos bits" : "DISTINTOS")
+                  << ", pesos " << (pesos ? "= filas repetidas" : "MAL") << "\n";
+        if (!exacta || !hilos || !pesos) ++errores;
+    }
+
+    // 2. Plegado en la capa
+    {
+        Dense<float> capa(3, 16, [](Tensor<float, 2>& t) {
+            for (std::size_t i = 0; i < t.size(); ++i) t[i] = std::sin(static_cast<float>(i) * 1.7f);
+        });
+        for (std::size_t j = 0; j < 16; ++j) capa.bias()[j] = std::cos(static_cast<float>(j));
+        InputNormalization<float> norm;
+        norm.mean = {0.5f, 0.4f, 0.6f};
+        norm.scale = {3.4f, 2.9f, 4.1f};
+        auto plegada = norm.folded(capa);
+
+        Tensor<float, 2> crudas(64, 3);
+        utec::utils::Xoshiro256 rng(5);
+        for (std::size_t i = 0; i < crudas.size(); ++i) crudas[i] = static_cast<float>(rng.uniform01());
+        Tensor<float, 2> estandarizadas = crudas;
+        norm.apply(estandarizadas);
+
+        const auto a = capa.forward(estandarizadas);
+        const auto b = plegada->forward(crudas);
+        float error = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) error = std::max(error, std::abs(a[i] - b[i]));
+        std::cout << "Capa plegada: error maximo " << std::scientific << std::setprecision(2) << error
+                  << std::defaultfloat << " frente a la original con entradas estandarizadas\n";
+        if (error > 1e-5f) ++errores;
+    }
+
+    // 3 y 4. Entrenamiento y escalas
+    {
+        RolloutConfig rc;
+        rc.rows = 20000;
+        rc.epsilon = 0.1;
+        rc.seed = 3;
+        const auto muestras = RolloutGenerator(rc).generate();
+
+        TrainConfig<float> cfg;
+        cfg.hidden_size = 16;
+        cfg.batch_size = 32;
+        cfg.learning_rate = 0.05f;
+        cfg.epochs = 20;
+        cfg.seed = 7;
+
+        auto sin = cfg;
+        float perdida_sin = 0, perdida_con = 0;
+        auto m_sin = PongAgent<float>::train_from_samples(muestras, sin, nullptr, [&](int, float loss, auto&) {
+            perdida_sin = loss;
+            return true;
+        });
+
+        auto con = cfg;
+        con.normalize_inputs = true;
+        std::vector<int> acciones_callback;
+        auto m_con = PongAgent<float>::train_from_samples(muestras, con, nullptr, [&](int epoch, float loss, auto& model) {
+            perdida_con = loss;
+            if (epoch + 1 == con.epochs)
+                for (std::size_t i = 0; i < 2000; ++i) {
+                    const auto& s = muestras[i];
+                    acciones_callback.push_back(PongAgent<float>::greedy_action(model, {s.ball_x, s.ball_y, s.paddle_y}));
+                }
+            return true;
+        });
+
+        std::size_t callback = 0, aciertos_sin = 0, aciertos_con = 0;
+        for (std::size_t i = 0; i < acciones_callback.size(); ++i) {
+            const auto& s = muestras[i];
+            const State st{s.ball_x, s.ball_y, s.paddle_y};
+            const int a = PongAgent<float>::greedy_action(*m_con, st);
+            callback += a == acciones_callback[i];
+            aciertos_con += a == s.action;
+            aciertos_sin += PongAgent<float>::greedy_action(*m_sin, st) == s.action;
+        }
+        const bool ok = callback == acciones_callback.size() && perdida_con <= perdida_sin;
+        std::cout << std::setprecision(4) << "Entrenamiento (" << cfg.epochs << " epocas, lote " << cfg.batch_size << "): perdida final "
+                  << perdida_sin << " sin normalizar, " << perdida_con << " normalizando; acierto a la etiqueta "
+                  << aciertos_sin / 20.0 << "% vs " << aciertos_con / 20.0 << "%\n"
+                  << "  on_epoch recibe el modelo plegado: "
+                  << (callback == acciones_callback.size() ? "mismas acciones que el devuelto" : "DISTINTO") << "\n";
+        if (!ok) ++errores;
+
+        // 4. Escalas de las 5 características
+        const auto stats = feature_stats<5>(muestras.size(), [&](std::size_t i, std::array<double, 5>& x) {
+            const auto& s = muestras[i];
+            x = {s.ball_x, s.ball_y, s.ball_vx, s.ball_vy, s.paddle_y};
+            return 1.0;
+        });
+        const char* nombres[] = {"ball_x", "ball_y", "ball_vx", "ball_vy", "paddle_y"};
+        std::cout << "Caracteristicas de " << muestras.size() << " filas de rollout (media / desvio):";
+        for (std::size_t i = 0; i < 5; ++i)
+            std::cout << (i ? ", " : " ") << nombres[i] << " " << std::setprecision(3) << stats[i].mean << " / "
+                      << stats[i].stddev();
+        std::cout << "\n";
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nNormalizacion de entradas verificada\n";
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file test_policy_cache.cpp
+ * @brief Verifica la tabla de acciones precalculada (PolicyCache) contra la red exacta.
+ *
+ * ### Flujo principal:
+ * 1. En el centro de cada celda la tabla devuelve exactamente la acción de la red.
+ * 2. Coincidencia con la red en estados uniformes y en estados de partidas reales, para varias
+ *    resoluciones, junto con el tamaño de la tabla.
+ * 3. Latencia de act(): tabla contra PolicySnapshot.
+ * 4. Invalidación: refresh() no reconstruye con la misma versión y los mismos pesos; sí al
+ *    publicar pesos nuevos y con la misma versión pero otros pesos.
+ */
+
+#include "../include/agent/Evaluator.h"
+#include "../include/agent/PolicyCache.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace utec::nn;
+
+int main() {
+    int errores = 0;
+    std::unique_ptr<utec::neural_network::ILayer<float>> modelo;
+    try {
+        modelo = PongAgent<float>::create_sequential_with_weights("Data/pong_model_dense1.weights",
+                                                                  "Data/pong_model_dense2.weights");
+        std::cout << "Modelo cargado desde Data/\n";
+    } catch (const std::exception&) {
+        modelo = PongAgent<float>::build_sequential(16, 4);
+        std::cout << "Sin pesos en Data/: se usa un modelo aleatorio\n";
+    }
+    auto& red = static_cast<PongAgent<float>::Sequential&>(*modelo);
+    const PolicySnapshot<float> exacta(red, 1);
+    utec::utils::ThreadPool pool;
+
+    // 1. Centros de celda exactos (rejilla no cúbica para probar el orden de los ejes)
+    {
+        const PolicyCacheGrid grid{7, 11, 5};
+        const PolicyCache<float> tabla(exacta, grid, &pool);
+        std::size_t distintos = 0;
+        for (std::size_t x = 0; x < grid.ball_x; ++x)
+            for (std::size_t y = 0; y < grid.ball_y; ++y)
+                for (std::size_t p = 0; p < grid.paddle_y; ++p) {
+                    const State s{(x + 0.5f) / grid.ball_x, (y + 0.5f) / grid.ball_y, (p + 0.5f) / grid.paddle_y};
+                    distintos += tabla.act(s) != exacta.act(s);
+                }
+        // Fuera de [0, 1] se usa la celda del borde
+        distintos += tabla.act({-0.3f, 2.0f, 0.5f}) != tabla.act({0.0f, 0.999f, 0.5f});
+        std::cout << "Centros de celda distintos de la red: " << distintos << "\n";
+        if (distintos) ++errores;
+    }
+
+    // 2. Coincidencia por resolución, en estados uniformes y de partidas
+    std::vector<State> partida;
+    {
+        EnvGym env(5);
+        State s = env.reset();
+        float r = 0;
+        bool done = false;
+        for (int i = 0; i < 200000; ++i) {
+            partida.push_back(s);
+            s = env.step(exacta.act(s), r, done);
+            if (done) s = env.reset();
+        }
+    }
+    std::cout << "\n" << std::setw(8) << "celdas" << std::setw(12) << "KiB" << std::setw(14) << "uniforme"
+              << std::setw(14) << "partidas" << std::setw(14) << "build ms" << "\n";
+    double coincidencia_64 = 0;
+    for (const std::size_t n : {16u, 32u, 64u, 128u}) {
+        const auto inicio = std::chrono::steady_clock::now();
+        const PolicyCache<float> tabla(exacta, {n, n, n}, &pool);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        utec::utils::Xoshiro256 rng(39);
+        const double uniforme = tabla.agreement(exacta, 500000, rng).rate();
+        const double jugada = tabla.agreement(exacta, partida).rate();
+        if (n == 64) coincidencia_64 = jugada;
+        std::cout << std::setw(6) << n << "^3" << std::setw(12) << tabla.bytes() / 1024 << std::fixed
+                  << std::setprecision(4) << std::setw(14) << uniforme << std::setw(14) << jugada
+                  << std::setprecision(1) << std::setw(14) << ms << "\n";
+    }
+    if (coincidencia_64 < 0.95) {
+        std::cout << "ERROR: con 64^3 celdas la tabla deberia coincidir en al menos 95% de los estados\n";
+        ++errores;
+    }
+
+    // 3. Latencia de una decisión
+    {
+        const PolicyCache<float> tabla(exacta, {}, &pool);
+        auto medir = [&](auto&& politica) {
+            int suma = 0;
+            const auto inicio = std::chrono::steady_clock::now();
+            for (int rep = 0; rep < 10; ++rep)
+                for (const State& s : partida) suma += politica(s);
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+            volatile int sumidero = suma;  // evita que el compilador descarte el bucle
+            (void)sumidero;
+            return ns / (10.0 * partida.size());
+        };
+        const double red_ns = medir([&](const State& s) { return exacta.act(s); });
+        const double tabla_ns = medir([&](const State& s) { return tabla.act(s); });
+        std::cout << std::setprecision(1) << "\nact(): red " << red_ns << " ns | tabla " << tabla_ns << " ns\n";
+    }
+
+    // 4. Invalidación por versión y por pesos
+    {
+        PublishedPolicy<float> publicada;
+        publicada.publish(std::make_shared<const PolicySnapshot<float>>(red, 1));
+        PolicyCache<float> tabla(*publicada.load(), {32, 32, 32});
+        const bool misma = tabla.refresh(publicada);
+        // Pesos nuevos: la acción preferida cambia y la tabla debe seguirla
+        red.l2->bias()(0, 0) += 100.0f;
+        publicada.publish(std::make_shared<const PolicySnapshot<float>>(red, 2));
+        const bool nueva = tabla.refresh(publicada, &pool);
+        utec::utils::Xoshiro256 rng(1);
+        const double tras = tabla.agreement(*publicada.load(), 100000, rng).rate();
+        std::cout << "refresh con la misma version: " << (misma ? "reconstruye" : "no reconstruye")
+                  << " | con version nueva: " << (nueva ? "reconstruye" : "no reconstruye")
+                  << " | coincidencia tras reconstruir " << std::setprecision(4) << tras << "\n";
+        if (misma || !nueva || tabla.version() != 2 || tras < 0.99) ++errores;
+
+        // Misma versión con otros pesos (EvolutionStrategies y pong_eval numeran así sus copias)
+        red.l2->bias()(0, 0) -= 200.0f;
+        const PolicySnapshot<float> otra(red, 2);
+        const bool mismos_pesos = tabla.refresh(*publicada.load());
+        const bool otros_pesos = tabla.refresh(otra);
+        const double tras_otra = tabla.agreement(otra, 100000, rng).rate();
+        std::cout << "misma version y mismos pesos: " << (mismos_pesos ? "reconstruye" : "no reconstruye")
+                  << " | misma version y otros pesos: " << (otros_pesos ? "reconstruye" : "no reconstruye")
+                  << " | coincidencia " << std::setprecision(4) << tras_otra << "\n";
+        if (mismos_pesos || !otros_pesos || tabla.weights_hash() != otra.weights_hash() || tras_otra < 0.99)
+            ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nTabla de politica verificada\n";
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file test_policy_export.cpp
+ * @brief Verifica el header generado por pong_export (Data/pong_policy.h).
+ *
+ * ### Flujo principal:
+ * 1. La acción del header se puede calcular en tiempo de compilación (static_assert).
+ * 2. Rearmando el modelo desde los arreglos constexpr, export_policy_header reproduce el header
+ *    byte a byte (los literales hexadecimales no pierden precisión).
+ * 3. En una grilla con bordes y en un millón de estados al azar, outputs() y act() del header
+ *    dan exactamente lo mismo que PolicySnapshot con esos pesos.
+ * 4. Modelos que no son 3 -> H -> 3 o con pesos no finitos se rechazan.
+ * 5. Tiempos: carga de los .weights frente a ninguna carga, y act() del header frente a
+ *    PolicySnapshot.
+ */
+
+#include "../Data/pong_policy.h"
+#include "../include/agent/PolicyExport.h"
+#include "../include/agent/PolicySnapshot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+using namespace utec::nn;
+using utec::algebra::Tensor;
+using utec::neural_network::Dense;
+using utec::neural_network::ReLU;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+static_assert(pong_policy::act(0.5f, 0.5f, 0.5f) >= -1 && pong_policy::act(0.5f, 0.5f, 0.5f) <= 1,
+              "act() del header debe poder evaluarse en tiempo de compilacion");
+constexpr int ACCION_COMPILADA = pong_policy::act(0.2f, 0.8f, 0.3f);
+
+/// @brief Modelo con los pesos de los arreglos constexpr del header
+PongAgent<float>::Sequential from_header() {
+    const std::size_t H = pong_policy::HIDDEN;
+    auto l1 = std::make_unique<Dense<float>>(
+        3, H,
+        [](Tensor<float, 2>& t) {
+            for (std::size_t k = 0; k < 3; ++k)
+                for (std::size_t i = 0; i < pong_policy::HIDDEN; ++i) t(k, i) = pong_policy::W1[k][i];
+        },
+        [](Tensor<float, 2>& b) { std::copy_n(pong_policy::B1, pong_policy::HIDDEN, b.data()); });
+    auto l2 = std::make_unique<Dense<float>>(
+        H, 3,
+        [](Tensor<float, 2>& t) {
+            for (std::size_t i = 0; i < pong_policy::HIDDEN; ++i)
+                for (std::size_t j = 0; j < 3; ++j) t(i, j) = pong_policy::W2[i][j];
+        },
+        [](Tensor<float, 2>& b) { std::copy_n(pong_policy::B2, 3, b.data()); });
+    return PongAgent<float>::Sequential(std::move(l1), std::make_unique<ReLU<float>>(), std::move(l2));
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+    const auto modelo = from_header();
+    const PolicySnapshot<float> politica(modelo, 1);
+
+    // 1. Tiempo de compilación
+    {
+        const bool ok = ACCION_COMPILADA == politica.act({0.2f, 0.8f, 0.3f});
+        std::cout << "act(0.2, 0.8, 0.3) calculada al compilar: " << ACCION_COMPILADA
+                  << (ok ? " (igual a PolicySnapshot)" : " (DISTINTA de PolicySnapshot)") << "\n";
+        if (!ok) ++errores;
+    }
+
+    // 2. Ida y vuelta del texto
+    {
+        std::ifstream file("Data/pong_policy.h", std::ios::binary);
+        std::ostringstream texto;
+        texto << file.rdbuf();
+        PolicyExportOptions opts;
+        opts.source = "Data/pong_model_dense1.weights y Data/pong_model_dense2.weights";
+        const bool ok = file && export_policy_header<float>(modelo, opts) == texto.str();
+        std::cout << "Header regenerado desde sus propios pesos: " << (ok ? "identico byte a byte" : "DISTINTO") << "\n";
+        if (!ok) ++errores;
+    }
+
+    // 3. Mismas salidas y acciones que PolicySnapshot
+    {
+        std::size_t estados = 0, distintos = 0;
+        auto comparar = [&](float bx, float by, float py) {
+            float esperado[3];
+            politica.outputs({bx, by, py}, esperado);
+            const auto o = pong_policy::outputs(bx, by, py);
+            distintos += o[0] != esperado[0] || o[1] != esperado[1] || o[2] != esperado[2]
+                         || pong_policy::act(bx, by, py) != politica.act({bx, by, py});
+            ++estados;
+        };
+        for (int i = 0; i <= 40; ++i)
+            for (int j = 0; j <= 40; ++j)
+                for (int k = 0; k <= 40; ++k) comparar(i / 40.0f, j / 40.0f, k / 40.0f);
+        utec::utils::Xoshiro256 rng(9);
+        for (int n = 0; n < 1'000'000; ++n)
+            comparar(static_cast<float>(rng.uniform01()), static_cast<float>(rng.uniform01()),
+                     static_cast<float>(rng.uniform01()));
+        std::cout << "Salidas y acciones frente a PolicySnapshot: " << distintos << " distintas en " << estados
+                  << " estados\n";
+        if (distintos) ++errores;
+    }
+
+    // 4. Modelos inválidos
+    {
+        int rechazados = 0;
+        auto malo = from_header();
+        malo.l2->weights()(0, 1) = std::numeric_limits<float>::quiet_NaN();
+        try {
+            export_policy_header<float>(malo);
+        } catch (const std::invalid_argument&) {
+            ++rechazados;
+        }
+        PongAgent<float>::Sequential cuatro(std::make_unique<Dense<float>>(4, 8, [](auto& t) { t.fill(0.1f); }),
+                                            std::make_unique<ReLU<float>>(),
+                                            std::make_unique<Dense<float>>(8, 3, [](auto& t) { t.fill(0.1f); }));
+        try {
+            export_policy_header<float>(cuatro);
+        } catch (const std::invalid_argument&) {
+            ++rechazados;
+        }
+        std::cout << "Pesos NaN y modelo 4 -> 8 -> 3: " << rechazados << " de 2 rechazados\n";
+        if (rechazados != 2) ++errores;
+    }
+
+    // 5. Tiempos
+    {
+        auto t0 = Clock::now();
+        auto cargado = PongAgent<float>::create_sequential_with_weights("Data/pong_model_dense1.weights",
+                                                                        "Data/pong_model_dense2.weights");
+        const double us_carga = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+
+        const int n = 5'000'000;
+        std::vector<State> estados(4096);
+        utec::utils::Xoshiro256 rng(4);
+        for (auto& s : estados)
+            s = {static_cast<float>(rng.uniform01()), static_cast<float>(rng.uniform01()),
+                 static_cast<float>(rng.uniform01())};
+        long suma = 0;
+        t0 = Clock::now();
+        for (int i = 0; i < n; ++i) suma += politica.act(estados[i & 4095]);
+        const double ns_snapshot = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / n;
+        t0 = Clock::now();
+        for (int i = 0; i < n; ++i) suma -= pong_policy::act(estados[i & 4095]);
+        const double ns_header = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / n;
+
+        std::cout << std::fixed << std::setprecision(1) << "Carga de los .weights: " << us_carga
+                  << " us (el header no carga nada)\n"
+                  << "act(): " << ns_snapshot << " ns con PolicySnapshot, " << ns_header << " ns con el header"
+                  << (suma ? " (ACCIONES DISTINTAS)" : "") << "\n";
+        if (suma || !cargado) ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nExportacion a header verificada\n";
+    return 0;
+}
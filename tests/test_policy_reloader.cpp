@@ -0,0 +1,224 @@
+/**
+ * @file test_policy_reloader.cpp
+ * @brief Verifica la recarga en caliente de pesos mientras otros hilos siguen jugando.
+ *
+ * ### Flujo principal:
+ * 1. Un cambio en los archivos se publica recién cuando se ve igual en dos revisiones seguidas;
+ *    sin cambios no se publica nada.
+ * 2. Un archivo incompleto o de otra forma no cambia la política vigente y se cuenta como
+ *    fallo; al completarlo se publica.
+ * 3. Varios hilos juegan sin parar mientras el hilo vigilante publica modelos nuevos: cada
+ *    copia que usan da exactamente las salidas de una de las versiones guardadas (nunca una
+ *    mezcla) y se mide la latencia de refresh() + act() durante las recargas.
+ * 4. evaluate_parallel con LivePolicy sigue jugando mientras se recarga.
+ * 5. La política recargada vuelve al agente (como al salir de simular): to_model() da un modelo
+ *    con exactamente las mismas salidas y acciones, y PongAgent lo usa después de set_model().
+ */
+
+#include "../include/agent/Evaluator.h"
+#include "../include/agent/PolicyReloader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+
+using namespace utec::nn;
+using namespace utec::neural_network;
+
+namespace {
+
+const std::string W1 = "/tmp/pong_recarga_dense1.weights";
+const std::string W2 = "/tmp/pong_recarga_dense2.weights";
+const State ESTADO{0.3f, 0.7f, 0.4f};
+
+/// @brief Modelo 3 -> H -> 3 cuyos pesos dependen de `k` (cada versión da salidas distintas)
+PongAgent<float>::Sequential model(int k, std::size_t hidden = 16) {
+    auto w = [k](Tensor<float, 2>& t) {
+        for (std::size_t i = 0; i < t.size(); ++i) t[i] = std::sin(static_cast<float>(i * 7 + k * 13)) * 0.5f;
+    };
+    return PongAgent<float>::Sequential(std::make_unique<Dense<float>>(3, hidden, w), std::make_unique<ReLU<float>>(),
+                                        std::make_unique<Dense<float>>(hidden, 3, w));
+}
+
+/// @brief Salidas esperadas para ESTADO con los pesos tal como quedan en el archivo
+std::array<float, 3> expected(int k) {
+    save_policy_weights<float>(model(k), W1, W2);
+    float out[3];
+    load_policy_snapshot<float>(W1, W2, 1)->outputs(ESTADO, out);
+    return {out[0], out[1], out[2]};
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+    using namespace std::chrono_literals;
+
+    // Salidas de cada versión, calculadas de antemano
+    std::map<std::array<float, 3>, int> versiones;
+    for (int k = 0; k < 40; ++k) versiones[expected(k)] = k;
+    save_policy_weights<float>(model(0), W1, W2);
+
+    // 1 y 2. Revisiones a mano
+    {
+        PublishedPolicy<float> publicada;
+        publicada.publish(load_policy_snapshot<float>(W1, W2, 1));
+        PolicyHotReloader<float> recarga(publicada, W1, W2, 250ms, false);
+
+        const bool quieto = !recarga.poll_once() && !recarga.poll_once() && publicada.version() == 1;
+        std::this_thread::sleep_for(10ms);
+        save_policy_weights<float>(model(1), W1, W2);
+        const bool espera = !recarga.poll_once();           // primera vez que lo ve: espera
+        const bool publica = recarga.poll_once() && publicada.version() == 2;
+        float out[3];
+        publicada.load()->outputs(ESTADO, out);
+        const bool nueva = versiones[{out[0], out[1], out[2]}] == 1;
+
+        std::this_thread::sleep_for(10ms);
+        std::ofstream(W1) << "3 16\n0.1 0.2 0.3";            // cortado
+        recarga.poll_once();
+        const bool rechaza = !recarga.poll_once() && recarga.failures() == 1 && publicada.version() == 2;
+        std::this_thread::sleep_for(10ms);
+        save_policy_weights<float>(model(2, 8), W1, W2);    // capa oculta de otro tamaño
+        std::ofstream(W2) << "16 3\n";                      // y la segunda capa de la forma vieja
+        recarga.poll_once();
+        const bool forma = !recarga.poll_once() && recarga.failures() == 2 && publicada.version() == 2;
+        std::this_thread::sleep_for(10ms);
+        save_policy_weights<float>(model(2, 8), W1, W2);
+        recarga.poll_once();
+        const bool repara = recarga.poll_once() && publicada.version() == 3 && publicada.load()->hidden() == 8;
+
+        const bool ok = quieto && espera && publica && nueva && rechaza && forma && repara;
+        std::cout << "Revisiones: sin cambios " << (quieto ? "no publica" : "PUBLICA") << ", cambio "
+                  << (espera && publica && nueva ? "publicado en la segunda revision" : "MAL") << ", archivo cortado "
+                  << (rechaza ? "rechazado" : "ACEPTADO") << ", capas de distinta forma "
+                  << (forma ? "rechazadas" : "ACEPTADAS") << ", luego " << (repara ? "recargado" : "NO RECARGADO")
+                  << " (" << recarga.last_error() << ")\n";
+        if (!ok) ++errores;
+    }
+
+    // 3. Lectores sin pausa mientras el vigilante recarga
+    {
+        save_policy_weights<float>(model(0), W1, W2);
+        PublishedPolicy<float> publicada;
+        publicada.publish(load_policy_snapshot<float>(W1, W2, 1));
+        PolicyHotReloader<float> recarga(publicada, W1, W2, 5ms);
+
+        const std::size_t lectores = std::max(2u, std::thread::hardware_concurrency());
+        std::atomic<bool> parar{false};
+        std::atomic<std::uint64_t> mezclas{0}, pasos{0};
+        std::vector<std::vector<double>> latencias(lectores);
+        std::vector<std::vector<int>> vistas(lectores);
+        std::vector<std::jthread> hilos;
+        for (std::size_t t = 0; t < lectores; ++t) {
+            hilos.emplace_back([&, t] {
+                std::shared_ptr<const PolicySnapshot<float>> local;
+                float out[3];
+                while (!parar.load(std::memory_order_relaxed)) {
+                    const auto t0 = std::chrono::steady_clock::now();
+                    const bool cambio = publicada.refresh(local);
+                    const int accion = local->act(ESTADO);
+                    const double ns =
+                        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+                    if (latencias[t].size() < 2'000'000) latencias[t].push_back(ns);
+                    if (cambio) {
+                        local->outputs(ESTADO, out);
+                        const auto it = versiones.find({out[0], out[1], out[2]});
+                        if (it == versiones.end() || accion < -1 || accion > 1) ++mezclas;
+                        else vistas[t].push_back(it->second);
+                    }
+                    pasos.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        const int modelos = 20;
+        for (int k = 1; k <= modelos; ++k) {
+            save_policy_weights<float>(model(k), W1, W2);
+            const auto limite = std::chrono::steady_clock::now() + 2s;
+            while (recarga.reloads() < static_cast<std::uint64_t>(k) && std::chrono::steady_clock::now() < limite)
+                std::this_thread::sleep_for(1ms);
+        }
+        std::this_thread::sleep_for(20ms);
+        parar = true;
+        hilos.clear();
+
+        std::vector<double> todas;
+        std::size_t ultimas = 0;
+        bool en_orden = true;
+        for (std::size_t t = 0; t < lectores; ++t) {
+            todas.insert(todas.end(), latencias[t].begin(), latencias[t].end());
+            ultimas += !vistas[t].empty() && vistas[t].back() == modelos;
+            en_orden &= std::is_sorted(vistas[t].begin(), vistas[t].end());
+        }
+        std::sort(todas.begin(), todas.end());
+        const bool ok = recarga.reloads() == modelos && mezclas == 0 && ultimas == lectores && en_orden
+                        && recarga.failures() == 0;
+        std::cout << std::fixed << std::setprecision(0) << lectores << " lectores, " << pasos.load() << " acciones, "
+                  << recarga.reloads() << " recargas: " << (mezclas ? "COPIAS MEZCLADAS" : "cada copia es una version entera")
+                  << ", todos terminan en la ultima " << (ultimas == lectores ? "si" : "NO") << "\n"
+                  << "  refresh() + act(): mediana " << todas[todas.size() / 2] << " ns, p99.9 "
+                  << todas[todas.size() * 999 / 1000] << " ns, maximo " << todas.back() << " ns\n";
+        if (!ok) ++errores;
+    }
+
+    // 4. Evaluación en paralelo con la política viva
+    {
+        save_policy_weights<float>(model(0), W1, W2);
+        PublishedPolicy<float> publicada;
+        publicada.publish(load_policy_snapshot<float>(W1, W2, 1));
+        PolicyHotReloader<float> recarga(publicada, W1, W2, 2ms);
+        std::jthread escritor([&](std::stop_token stop) {
+            for (int k = 1; !stop.stop_requested(); k = k % 30 + 1) {
+                save_policy_weights<float>(model(k), W1, W2);
+                std::this_thread::sleep_for(10ms);
+            }
+        });
+        ParallelEvalOptions opciones;
+        opciones.steps = 3'000'000;
+        const auto r = evaluate_parallel(LivePolicy<float>(publicada), opciones);
+        escritor.request_stop();
+        escritor.join();
+        std::cout << "evaluate_parallel con LivePolicy: " << r.steps << " pasos en " << std::setprecision(2)
+                  << r.seconds << " s con " << recarga.reloads() << " recargas en el medio\n";
+        if (r.steps != opciones.steps) ++errores;
+    }
+
+    // 5. De la política recargada al agente
+    {
+        save_policy_weights<float>(model(7), W1, W2);
+        const auto recargada = load_policy_snapshot<float>(W1, W2, 2);
+        PongAgent<float> agente(std::make_unique<PongAgent<float>::Sequential>(model(0)));
+        agente.set_model(recargada->to_model());
+        const auto& nuevo = static_cast<const PongAgent<float>::Sequential&>(*agente.get_model());
+        const PolicySnapshot<float> copia(nuevo, 3);
+
+        std::size_t distintos = 0;
+        utec::utils::Xoshiro256 rng(21);
+        for (int n = 0; n < 100'000; ++n) {
+            const State s{static_cast<float>(rng.uniform01()), static_cast<float>(rng.uniform01()),
+                          static_cast<float>(rng.uniform01())};
+            float a[3], b[3];
+            recargada->outputs(s, a);
+            copia.outputs(s, b);
+            distintos += a[0] != b[0] || a[1] != b[1] || a[2] != b[2] || recargada->act(s) != agente.act(s, 0.0f);
+        }
+        std::cout << "Modelo recargado devuelto al agente: " << distintos << " estados distintos de 100000\n";
+        if (distintos) ++errores;
+    }
+    std::remove(W1.c_str());
+    std::remove(W2.c_str());
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nRecarga en caliente verificada\n";
+    return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file test_prepared_dataset.cpp
+ * @brief Verifica la preparación de tensores de entrenamiento y su caché en disco.
+ *
+ * ### Flujo principal:
+ * 1. Sin fusión, train_from_prepared da los mismos pesos que train_from_samples.
+ * 2. Con fusión (opcional), cada entrada aparece una vez con objetivo = frecuencia de acciones y peso =
+ *    repeticiones; con un solo lote por época el paso de SGD es el mismo que con las filas repetidas.
+ * 3. La caché se escribe en la primera preparación y se usa en la segunda; si el origen cambia
+ *    o la caché está dañada se vuelve a preparar. Cachés de otras opciones o de otro tipo
+ *    conviven sin borrarse; de cada combinación queda una sola por origen.
+ * 4. Con Data/pong_train.csv: filas, estados distintos y conflictos, y tiempos de parseo +
+ *    preparación frente a la caché y de una época frente a train_from_samples.
+ */
+
+#include "../include/agent/PongAgent.h"
+#include "../include/agent/PreparedDataset.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace utec::nn;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+auto& seq(std::unique_ptr<utec::neural_network::ILayer<float>>& m) { return static_cast<PongAgent<float>::Sequential&>(*m); }
+
+bool same_weights(std::unique_ptr<utec::neural_network::ILayer<float>>& a,
+                  std::unique_ptr<utec::neural_network::ILayer<float>>& b, float tol = 0.0f) {
+    auto close = [tol](float x, float y) { return std::abs(x - y) <= tol; };
+    auto &sa = seq(a), &sb = seq(b);
+    return std::equal(sa.l1->weights().begin(), sa.l1->weights().end(), sb.l1->weights().begin(), close)
+           && std::equal(sa.l2->weights().begin(), sa.l2->weights().end(), sb.l2->weights().begin(), close)
+           && std::equal(sa.l1->bias().begin(), sa.l1->bias().end(), sb.l1->bias().begin(), close);
+}
+
+std::size_t cache_files(const std::string& source) {
+    const auto src = std::filesystem::path(source);
+    std::size_t n = 0;
+    for (const auto& f : std::filesystem::directory_iterator(src.parent_path())) {
+        const auto name = f.path().filename().string();
+        n += name.starts_with(src.filename().string() + ".") && name.ends_with(".prep");
+    }
+    return n;
+}
+
+void write_csv(const std::string& path, const std::vector<PongSample>& samples) {
+    std::string text(PONG_CSV_HEADER);
+    for (const auto& s : samples) append_pong_csv(text, s);
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // Estados de una grilla chica, cada uno repetido con acciones en conflicto
+    std::vector<PongSample> muestras;
+    utec::utils::Xoshiro256 rng(3);
+    for (int i = 0; i < 400; ++i) {
+        const float bx = static_cast<float>(i % 20) / 20.0f, by = static_cast<float>(i / 20) / 20.0f;
+        const float py = static_cast<float>(rng.below(5)) / 4.0f;
+        for (int k = 0; k < 3; ++k) muestras.push_back({bx, by, 0.02f, -0.01f, py, static_cast<int>(rng.below(3)) - 1, 1.0f});
+    }
+    muestras.push_back({0.5f, 0.5f, 0.0f, 0.0f, -0.0f, 2, 1.0f});   // acción fuera de rango
+    muestras.push_back({0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 1, 1.0f});    // misma entrada (-0 == +0)
+
+    TrainConfig<float> cfg;
+    cfg.epochs = 3;
+    cfg.batch_size = 16;
+    cfg.seed = 5;
+
+    PrepareOptions fusion;
+    fusion.merge_duplicates = true;
+
+    // 1. Sin fusión (por defecto)
+    {
+        const auto datos = prepare_dataset<float>(muestras);
+        auto a = PongAgent<float>::train_from_samples(muestras, cfg);
+        auto b = PongAgent<float>::train_from_prepared(datos, cfg);
+        const bool ok = datos.rows() == muestras.size() && same_weights(a, b);
+        std::cout << "Sin fusion: " << datos.rows() << " filas, train_from_prepared "
+                  << (ok ? "identico a train_from_samples" : "DISTINTO") << "\n";
+        if (!ok) ++errores;
+    }
+
+    // 2. Con fusión
+    {
+        const auto datos = prepare_dataset<float>(muestras, fusion);
+        double peso = 0;
+        bool objetivos = true;
+        for (std::size_t r = 0; r < datos.rows(); ++r) {
+            peso += datos.weights[r];
+            const float suma = datos.targets(r, 0) + datos.targets(r, 1) + datos.targets(r, 2);
+            objetivos &= r + 1 == datos.rows() ? std::abs(suma - 0.5f) < 1e-6f : std::abs(suma - 1.0f) < 1e-6f;
+        }
+
+        // Un lote por época: el paso con filas fusionadas y pesos es el de las filas repetidas
+        // escalado por la cantidad de filas, así que se compara con una tasa ajustada.
+        auto completo = cfg;
+        completo.batch_size = muestras.size();
+        auto fusionado = completo;
+        fusionado.batch_size = datos.rows();
+        fusionado.learning_rate = completo.learning_rate * static_cast<float>(datos.rows()) / static_cast<float>(muestras.size());
+        auto a = PongAgent<float>::train_from_samples(muestras, completo);
+        auto b = PongAgent<float>::train_from_prepared(datos, fusionado);
+        const bool mismo_paso = same_weights(a, b, 1e-5f);
+
+        const bool ok = datos.rows() < muestras.size() && peso == static_cast<double>(muestras.size()) && objetivos
+                        && datos.conflicts > 0 && mismo_paso;
+        std::cout << "Con fusion: " << muestras.size() << " filas -> " << datos.rows() << " estados, "
+                  << datos.conflicts << " en conflicto, pesos " << (peso == muestras.size() ? "suman el total" : "MAL")
+                  << ", paso de SGD " << (mismo_paso ? "igual" : "DISTINTO") << " al de las filas repetidas\n";
+        if (!ok) ++errores;
+    }
+
+    // 3. Caché
+    {
+        const std::string csv = "/tmp/pong_preparado.csv";
+        write_csv(csv, muestras);
+        const auto primera = prepare_dataset_file<float>(csv);
+        const auto segunda = prepare_dataset_file<float>(csv);
+
+        const bool iguales = std::equal(primera.inputs.begin(), primera.inputs.end(), segunda.inputs.begin())
+                             && std::equal(primera.targets.begin(), primera.targets.end(), segunda.targets.begin())
+                             && primera.weights == segunda.weights && primera.conflicts == segunda.conflicts;
+        const bool uso = !primera.from_cache && segunda.from_cache && cache_files(csv) == 1;
+
+        // Otras opciones y otro tipo: cada una tiene su caché y no borra las demás
+        prepare_dataset_file<float>(csv, fusion);
+        prepare_dataset_file<double>(csv);
+        const bool conviven = prepare_dataset_file<float>(csv).from_cache && prepare_dataset_file<float>(csv, fusion).from_cache
+                              && prepare_dataset_file<double>(csv).from_cache && cache_files(csv) == 3;
+
+        auto mas = muestras;
+        mas.push_back({0.25f, 0.75f, 0.0f, 0.0f, 0.5f, 1, 1.0f});
+        write_csv(csv, mas);
+        const auto cambiado = prepare_dataset_file<float>(csv);
+        const bool invalida = !cambiado.from_cache && cambiado.source_rows == mas.size() && cache_files(csv) == 3;
+
+        for (const auto& f : std::filesystem::directory_iterator("/tmp"))
+            if (f.path().filename().string().starts_with("pong_preparado.csv.")) std::filesystem::resize_file(f.path(), 100);
+        const auto danada = prepare_dataset_file<float>(csv);
+        const auto reparada = prepare_dataset_file<float>(csv);
+        const bool repara = !danada.from_cache && reparada.from_cache && reparada.rows() == cambiado.rows();
+
+        std::cout << "Cache: primera vez " << (primera.from_cache ? "LEIDA" : "preparada") << ", segunda "
+                  << (segunda.from_cache ? "leida" : "NO LEIDA") << (iguales ? " e igual" : " y DISTINTA")
+                  << ", origen cambiado " << (invalida ? "se prepara de nuevo" : "MAL") << ", cache danada "
+                  << (repara ? "se reemplaza" : "MAL") << ", otras opciones " << (conviven ? "conservadas" : "BORRADAS") << "\n";
+        if (!iguales || !uso || !conviven || !invalida || !repara) ++errores;
+
+        std::remove(csv.c_str());
+        for (const auto& f : std::filesystem::directory_iterator("/tmp"))
+            if (f.path().filename().string().starts_with("pong_preparado.csv.")) std::filesystem::remove(f.path());
+    }
+
+    // 4. Datos reales del proyecto
+    {
+        std::ifstream origen("Data/pong_train.csv", std::ios::binary);
+        if (!origen) {
+            std::cout << "\n(Data/pong_train.csv no esta disponible: se omite la medicion)\n";
+        } else {
+            const std::string copia = "/tmp/pong_train_preparado.csv";
+            std::ofstream(copia, std::ios::binary) << origen.rdbuf();
+
+            auto t0 = Clock::now();
+            const auto datos = prepare_dataset_file<float>(copia, fusion);
+            const double ms_prep = ms_since(t0);
+            t0 = Clock::now();
+            const auto cache = prepare_dataset_file<float>(copia, fusion);
+            const double ms_cache = ms_since(t0);
+
+            const auto muestras_csv = load_pong_csv(copia).samples;
+            TrainConfig<float> epocas;
+            epocas.epochs = 50;
+            epocas.seed = 1;
+            t0 = Clock::now();
+            PongAgent<float>::train_from_samples(muestras_csv, epocas);
+            const double ms_filas = ms_since(t0) / epocas.epochs;
+            t0 = Clock::now();
+            PongAgent<float>::train_from_prepared(cache, epocas);
+            const double ms_prep_epoca = ms_since(t0) / epocas.epochs;
+
+            std::cout << std::fixed << std::setprecision(3) << "\nData/pong_train.csv: " << datos.source_rows
+                      << " filas -> " << datos.rows() << " estados distintos, " << datos.conflicts
+                      << " con acciones en conflicto\n"
+                      << "  parseo + preparacion : " << ms_prep << " ms\n"
+                      << "  desde la cache       : " << ms_cache << " ms\n"
+                      << "  epoca (lote 1)       : " << ms_filas << " ms con train_from_samples, " << ms_prep_epoca
+                      << " ms con train_from_prepared\n";
+            if (!cache.from_cache || cache.rows() != datos.rows()) ++errores;
+
+            std::remove(copia.c_str());
+            for (const auto& f : std::filesystem::directory_iterator("/tmp"))
+                if (f.path().filename().string().starts_with("pong_train_preparado.csv.")) std::filesystem::remove(f.path());
+        }
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nPreparacion de datos verificada\n";
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_prioritized_replay.cpp
+ * @brief Verifica el sum-tree y la memoria de repetición priorizada, y mide su latencia.
+ *
+ * ### Flujo principal:
+ * 1. Llena un SumTree con prioridades conocidas, muestrea y compara las frecuencias con p_i / Σp.
+ * 2. Comprueba que el recorrido por lotes (find_sorted) elige las mismas hojas que find().
+ * 3. Sube la prioridad de una transición y verifica que se muestrea más y con menor peso.
+ * 4. Llena una memoria grande y mide la latencia de muestrear + actualizar un lote.
+ */
+
+#include "../include/agent/PrioritizedReplay.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace utec::nn;
+
+int main() {
+    int errores = 0;
+    utec::utils::Xoshiro256 rng(3);
+
+    // 1. Frecuencias de muestreo proporcionales a la prioridad
+    constexpr std::size_t HOJAS = 1000;
+    SumTree tree(HOJAS);
+    for (std::size_t i = 0; i < HOJAS; ++i) tree.set(i, static_cast<double>(i % 10 + 1));
+    // Se agrupan las hojas por prioridad (1..10) para que el ruido de muestreo sea pequeño
+    std::vector<std::size_t> cuentas(10, 0);
+    constexpr std::size_t MUESTRAS = 2000000;
+    for (std::size_t k = 0; k < MUESTRAS; ++k) ++cuentas[tree.find(rng.uniform01() * tree.total()) % 10];
+
+    double peor = 0;
+    for (std::size_t c = 0; c < cuentas.size(); ++c) {
+        const double esperado = MUESTRAS * (100.0 * (c + 1)) / tree.total();
+        peor = std::max(peor, std::abs(cuentas[c] - esperado) / esperado);
+    }
+    std::cout << "=== SUM-TREE ===\n";
+    std::cout << "Total: " << tree.total() << " (esperado 5500)\n";
+    std::cout << "Mayor desviacion relativa de frecuencia por prioridad: " << peor << "\n";
+    if (tree.total() != 5500.0 || peor > 0.02) ++errores;
+
+    // 2. Recorrido por lotes == búsquedas individuales
+    std::vector<double> objetivos(4096), copia;
+    for (std::size_t k = 0; k < objetivos.size(); ++k)
+        objetivos[k] = (k + rng.uniform01()) * tree.total() / objetivos.size();
+    copia = objetivos;
+    std::vector<std::size_t> hojas;
+    tree.find_sorted(copia, hojas);
+    std::size_t distintas = 0;
+    for (std::size_t k = 0; k < objetivos.size(); ++k) distintas += hojas[k] != tree.find(objetivos[k]);
+    std::cout << "Lote de " << objetivos.size() << " objetivos, hojas distintas a find(): " << distintas << "\n";
+    if (distintas != 0) ++errores;
+
+    // 3. Una transición con error TD grande se muestrea más y pesa menos
+    PrioritizedReplay<float> replay(10000);
+    State s{0.5f, 0.5f, 0.5f};
+    for (int i = 0; i < 10000; ++i) replay.push(s, 0, 0.0f, s, false);
+    std::vector<std::size_t> todos(10000);
+    std::vector<float> bajos(10000, 0.01f);
+    for (std::size_t i = 0; i < todos.size(); ++i) todos[i] = i;
+    replay.update_priorities(todos, bajos);
+    replay.update_priorities({42}, {50.0f});
+
+    ReplayBatch<float> lote;
+    std::size_t veces = 0;
+    float peso_42 = 1;
+    for (int r = 0; r < 200; ++r) {
+        replay.sample(64, rng, lote, 1.0);
+        for (std::size_t k = 0; k < lote.size(); ++k) {
+            if (lote.indices[k] == 42) {
+                ++veces;
+                peso_42 = lote.weights[k];
+            }
+        }
+    }
+    const double prob = replay.tree().get(42) / replay.tree().total();
+    std::cout << "\n=== PRIORIDADES ===\n";
+    std::cout << "P(42) = " << prob << " | veces muestreada: " << veces << " de " << 200 * 64
+              << " | peso de importancia: " << peso_42 << "\n";
+    if (veces < 200 * 64 * prob * 0.8 || peso_42 >= 0.5f) ++errores;
+
+    // 4. Latencia con una memoria grande
+    constexpr std::size_t GRANDE = 2000000;
+    PrioritizedReplay<float> grande(GRANDE);
+    auto inicio = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < GRANDE; ++i) grande.push(s, static_cast<int>(i % 3) - 1, 0.0f, s, false);
+    const double llenado = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::vector<float> td(256);
+    std::vector<double> tiempos;
+    for (int r = 0; r < 2000; ++r) {
+        for (auto& e : td) e = rng.uniform(-2.0f, 2.0f);
+        const auto t0 = std::chrono::steady_clock::now();
+        grande.sample(td.size(), rng, lote, 0.5);
+        grande.update_priorities(lote.indices, td);
+        tiempos.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+    }
+    std::sort(tiempos.begin(), tiempos.end());
+    std::cout << "\n=== LATENCIA (" << GRANDE << " transiciones, lotes de " << td.size() << ") ===\n";
+    std::cout << "Insercion: " << GRANDE / llenado << " transiciones/s\n";
+    std::cout << "Muestrear + actualizar: p50 " << tiempos[tiempos.size() / 2] << " us | p99 "
+              << tiempos[tiempos.size() * 99 / 100] << " us | max " << tiempos.back() << " us\n";
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nMemoria priorizada verificada\n";
+    return 0;
+}
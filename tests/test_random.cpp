@@ -0,0 +1,152 @@
+/**
+ * @file test_random.cpp
+ * @brief Verifica el generador xoshiro256** (utils/random.h).
+ *
+ * ### Flujo principal:
+ * 1. Vectores de referencia: SplitMix64 con semilla 0 y xoshiro256** con estado {1, 2, 3, 4}
+ *    dan las salidas publicadas por sus autores.
+ * 2. La misma semilla da la misma secuencia (también después de seed()); semillas vecinas no.
+ * 3. jump() y long_jump() conmutan con avanzar el generador (son potencias de la misma
+ *    transformación lineal), y los flujos de fork() no comparten ningún valor en sus primeros
+ *    millones de salidas.
+ * 4. below(n) queda en [0, n) para varios n (incluido 2^32 - 1) y reparte parejo; uniform01()
+ *    queda en [0, 1); funciona con las distribuciones de <random>.
+ */
+
+#include "../include/utils/random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using utec::utils::Xoshiro256;
+
+int main() {
+    int errores = 0;
+
+    // 1. Vectores de referencia
+    {
+        const std::uint64_t splitmix[] = {0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL, 0x06c45d188009454fULL,
+                                          0xf88bb8a8724c81ecULL};
+        const std::uint64_t xoshiro[] = {11520ULL,
+                                         0ULL,
+                                         1509978240ULL,
+                                         1215971899390074240ULL,
+                                         1216172134540287360ULL,
+                                         607988272756665600ULL,
+                                         16172922978634559625ULL,
+                                         8476171486693032832ULL,
+                                         10595114339597558777ULL,
+                                         2904607092377533576ULL};
+        int distintos = 0;
+        std::uint64_t x = 0;
+        for (std::uint64_t v : splitmix) distintos += utec::utils::splitmix64(x) != v;
+        auto rng = Xoshiro256::from_state(1, 2, 3, 4);
+        for (std::uint64_t v : xoshiro) distintos += rng() != v;
+
+        // seed(s) es el estado de cuatro pasos de SplitMix64 desde s
+        std::uint64_t s = 12345;
+        const std::uint64_t a = utec::utils::splitmix64(s), b = utec::utils::splitmix64(s),
+                            c = utec::utils::splitmix64(s), d = utec::utils::splitmix64(s);
+        distintos += !(Xoshiro256(12345) == Xoshiro256::from_state(a, b, c, d));
+
+        std::cout << "Vectores de referencia (SplitMix64 y xoshiro256**): " << distintos << " distintos de 15\n";
+        if (distintos) ++errores;
+    }
+
+    // 2. Reproducibilidad
+    {
+        Xoshiro256 a(2024), b(2024), vecino(2025);
+        int distintos = 0, iguales_vecino = 0;
+        std::vector<std::uint64_t> primeros;
+        for (int i = 0; i < 100000; ++i) {
+            const auto x = a();
+            distintos += x != b();
+            iguales_vecino += x == vecino();
+            if (i < 1000) primeros.push_back(x);
+        }
+        a.seed(2024);
+        for (std::uint64_t x : primeros) distintos += a() != x;
+        std::cout << "Misma semilla: " << distintos << " diferencias (tambien tras seed()); semilla vecina: "
+                  << iguales_vecino << " valores iguales en la misma posicion\n";
+        if (distintos || iguales_vecino) ++errores;
+    }
+
+    // 3. Saltos y flujos
+    {
+        // Saltar y después avanzar n pasos == avanzar n pasos y después saltar
+        Xoshiro256 a(7), b(7), c(7), d(7);
+        a.jump();
+        for (int i = 0; i < 1000; ++i) a(), b(), c();
+        b.jump();
+        d.long_jump();
+        for (int i = 0; i < 1000; ++i) d();
+        c.long_jump();
+        const bool conmutan = a == b && c == d && !(a == c) && !(a == Xoshiro256(7));
+
+        // Flujos de fork(): ningún valor repetido entre 8 flujos de 500k salidas
+        Xoshiro256 base(99);
+        std::vector<Xoshiro256> flujos;
+        for (int k = 0; k < 8; ++k) flujos.push_back(base.fork());
+        Xoshiro256 primero(99);
+        const bool fork_copia = flujos[0] == primero;
+        primero.jump();
+        const bool fork_salta = flujos[1] == primero;
+
+        std::unordered_set<std::uint64_t> vistos;
+        vistos.reserve(8 * 500000);
+        std::size_t repetidos = 0;
+        for (auto& f : flujos)
+            for (int i = 0; i < 500000; ++i) repetidos += !vistos.insert(f()).second;
+
+        std::cout << "jump/long_jump conmutan con avanzar: " << (conmutan ? "si" : "NO") << "; fork devuelve el flujo actual "
+                  << (fork_copia && fork_salta ? "y salta 2^128" : "MAL") << "; 8 flujos x 500000 salidas: " << repetidos
+                  << " valores repetidos\n";
+        if (!conmutan || !fork_copia || !fork_salta || repetidos) ++errores;
+    }
+
+    // 4. Rangos
+    {
+        Xoshiro256 rng(5);
+        std::size_t fuera = 0;
+        for (std::uint32_t n : {1u, 2u, 3u, 7u, 1000u, 0xffffffffu})
+            for (int i = 0; i < 200000; ++i) fuera += rng.below(n) >= n;
+
+        std::size_t cuenta[3] = {0, 0, 0};
+        const int N = 3'000'000;
+        for (int i = 0; i < N; ++i) ++cuenta[rng.below(3)];
+        double chi2 = 0;
+        for (std::size_t c : cuenta) chi2 += (c - N / 3.0) * (c - N / 3.0) / (N / 3.0);
+
+        float minimo = 1, maximo = 0;
+        for (int i = 0; i < 1'000'000; ++i) {
+            const float u = rng.uniform01();
+            minimo = std::min(minimo, u);
+            maximo = std::max(maximo, u);
+            fuera += !(u >= 0.0f && u < 1.0f);
+        }
+
+        std::uniform_int_distribution<int> dado(1, 6);
+        for (int i = 0; i < 10000; ++i) {
+            const int v = dado(rng);
+            fuera += v < 1 || v > 6;
+        }
+
+        std::cout << "below(n) y uniform01(): " << fuera << " valores fuera de rango; below(3) "
+                  << cuenta[0] << " / " << cuenta[1] << " / " << cuenta[2] << " (chi^2 = " << chi2
+                  << "); uniform01 en [" << minimo << ", " << maximo << "]\n";
+        // chi^2 con 2 grados de libertad: 13.8 corresponde a p = 0.001
+        if (fuera || chi2 > 13.8) ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nGenerador xoshiro256** verificado\n";
+    return 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file test_replay_buffer.cpp
+ * @brief Verifica la memoria de repetición en anillo y los pasos de aprendizaje de DQN.
+ *
+ * ### Flujo principal:
+ * 1. Anillo: size() crece hasta la capacidad y se queda ahí; cada inserción nueva sobrescribe
+ *    la más antigua y push() devuelve la posición usada.
+ * 2. gather/sample: las columnas SoA (estado, siguiente estado, acción, recompensa, fin) de
+ *    cada fila del lote son de la misma transición, y sample solo elige posiciones ocupadas.
+ * 3. TD-target: con un lote de una transición y SGD, el bias de la salida de la acción tomada
+ *    se mueve exactamente -lr · clamp(Q(s, a) - y) con y = r + γ · max Q'(s', ·), y con done
+ *    el término γ · max Q' no cuenta.
+ * 4. Red objetivo: se copia de la red en línea cada `target_sync` actualizaciones y entre
+ *    copias no cambia.
+ * 5. DQNTrainer: pasos, actualizaciones y tamaño de la memoria concuerdan con la configuración.
+ */
+
+#include "../include/agent/DQNTrainer.h"
+#include "../include/agent/PolicySnapshot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace utec::nn;
+using utec::algebra::Tensor;
+
+namespace {
+
+/// @brief Transición `i`: todos sus campos derivan de i, así una fila mezclada se detecta
+void push_numbered(ReplayBuffer<float>& buffer, int i, std::size_t& position) {
+    const float f = static_cast<float>(i);
+    position = buffer.push({f, f + 0.25f, f + 0.5f}, i % 3 - 1, f * 10, {f + 1, f + 1.25f, f + 1.5f}, i % 2 == 1);
+}
+
+/// @brief true si la fila k del lote es una transición numerada completa; deja su número en `i`
+bool consistent(const ReplayBatch<float>& b, std::size_t k, int& i) {
+    const float f = b.states(k, 0);
+    i = static_cast<int>(f);
+    return b.states(k, 1) == f + 0.25f && b.states(k, 2) == f + 0.5f && b.next_states(k, 0) == f + 1
+           && b.next_states(k, 1) == f + 1.25f && b.next_states(k, 2) == f + 1.5f && b.actions[k] == i % 3 - 1
+           && b.rewards[k] == f * 10 && b.dones[k] == (i % 2 == 1);
+}
+
+template <typename Model>
+bool same_params(const Model& a, const Model& b) {
+    return std::equal(a.l1->weights().begin(), a.l1->weights().end(), b.l1->weights().begin())
+           && std::equal(a.l1->bias().begin(), a.l1->bias().end(), b.l1->bias().begin())
+           && std::equal(a.l2->weights().begin(), a.l2->weights().end(), b.l2->weights().begin())
+           && std::equal(a.l2->bias().begin(), a.l2->bias().end(), b.l2->bias().begin());
+}
+
+Tensor<float, 2> row(const State& s) {
+    Tensor<float, 2> x(1, 3);
+    x = {s.ball_x, s.ball_y, s.paddle_y};
+    return x;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1 y 2. Anillo, gather y sample
+    {
+        ReplayBuffer<float> buffer(5);
+        std::size_t posicion = 0, posiciones_mal = 0;
+        std::string tamanos;
+        for (int i = 0; i < 12; ++i) {
+            push_numbered(buffer, i, posicion);
+            posiciones_mal += posicion != static_cast<std::size_t>(i % 5);
+            tamanos += std::to_string(buffer.size());
+        }
+
+        // Cada posición guarda la última transición con i % 5 == posición: 10, 11, 7, 8, 9
+        ReplayBatch<float> lote;
+        lote.resize(5);
+        for (std::size_t k = 0; k < 5; ++k) lote.indices[k] = 4 - k;
+        buffer.gather(lote);
+        const int esperadas[] = {9, 8, 7, 11, 10};
+        std::size_t filas_mal = 0;
+        for (std::size_t k = 0; k < 5; ++k) {
+            int i = -1;
+            filas_mal += !consistent(lote, k, i) || i != esperadas[k];
+        }
+
+        // sample sobre una memoria a medio llenar: solo posiciones ocupadas, filas completas
+        ReplayBuffer<float> parcial(100);
+        for (int i = 0; i < 30; ++i) push_numbered(parcial, i, posicion);
+        utec::utils::Xoshiro256 rng(3);
+        std::size_t muestras_mal = 0;
+        for (int rep = 0; rep < 200; ++rep) {
+            parcial.sample(64, rng, lote);
+            for (std::size_t k = 0; k < lote.size(); ++k) {
+                int i = -1;
+                muestras_mal += lote.indices[k] >= 30 || !consistent(lote, k, i)
+                                || static_cast<std::size_t>(i) != lote.indices[k] || lote.weights[k] != 1.0f;
+            }
+        }
+
+        int rechazos = 0;
+        try {
+            ReplayBuffer<float> vacia(0);
+        } catch (const std::invalid_argument&) {
+            ++rechazos;
+        }
+        try {
+            ReplayBuffer<float>(4).sample(1, rng, lote);
+        } catch (const std::logic_error&) {
+            ++rechazos;
+        }
+
+        std::cout << "Anillo de 5 con 12 inserciones: size() " << tamanos << ", " << posiciones_mal
+                  << " posiciones inesperadas, " << filas_mal << " filas de gather distintas de 9 8 7 11 10\n"
+                  << "sample con 30 de 100 ocupadas: " << muestras_mal
+                  << " filas mezcladas o fuera de rango en 12800; capacidad 0 y memoria vacia: " << rechazos
+                  << " de 2 rechazadas\n";
+        if (tamanos != "123455555555" || posiciones_mal || filas_mal || muestras_mal || rechazos != 2) ++errores;
+    }
+
+    // 3. TD-target con y sin done
+    {
+        DQNConfig<float> cfg;
+        cfg.hidden_size = 8;
+        cfg.optimizer = OptimizerKind::SGD;
+        cfg.learning_rate = 0.1f;
+        cfg.gamma = 0.9f;
+        cfg.batch_size = 1;
+        cfg.buffer_capacity = 1;
+        cfg.warmup = 1;
+        cfg.target_sync = 1000;
+        cfg.seed = 11;
+
+        const State s{0.3f, 0.6f, 0.5f}, siguiente{0.7f, 0.2f, 0.4f};
+        const int accion = 1;
+        const float r = 0.4f;
+        auto paso = [&](bool done, double& esperado, double& obtenido) {
+            DQNLearner<float> learner(cfg, utec::utils::Xoshiro256(1));
+            learner.push(s, accion, r, siguiente, done);
+            const auto q = learner.online().forward(row(s));
+            float objetivo[3];
+            PolicySnapshot<float>(learner.target(), 1).outputs(siguiente, objetivo);   // mismas sumas que Dense
+            const float max_q = std::max({objetivo[0], objetivo[1], objetivo[2]});
+            const float y = r + (done ? 0.0f : cfg.gamma * max_q);
+            const float diff = q[accion + 1] - y;
+            const float antes = learner.online().l2->bias()[accion + 1];
+            learner.update(0.0);
+            esperado = -cfg.learning_rate * std::clamp(diff, -1.0f, 1.0f);
+            obtenido = learner.online().l2->bias()[accion + 1] - antes;
+            return std::abs(obtenido - esperado) < 1e-6 && max_q != 0.0f;
+        };
+        double e1 = 0, o1 = 0, e2 = 0, o2 = 0;
+        const bool sigue = paso(false, e1, o1);
+        const bool termina = paso(true, e2, o2);
+
+        std::cout << "TD-target (lote de 1, SGD): cambio del bias " << o1 << " (esperado " << e1 << ") sin done, "
+                  << o2 << " (esperado " << e2 << ") con done\n";
+        if (!sigue || !termina || e1 == e2) ++errores;
+    }
+
+    // 4. Sincronización de la red objetivo
+    {
+        DQNConfig<float> cfg;
+        cfg.hidden_size = 8;
+        cfg.batch_size = 16;
+        cfg.buffer_capacity = 256;
+        cfg.warmup = 0;
+        cfg.target_sync = 3;
+        DQNLearner<float> learner(cfg, utec::utils::Xoshiro256(2));
+        utec::utils::Xoshiro256 rng(4);
+        for (int i = 0; i < 256; ++i) {
+            const State a{static_cast<float>(rng.uniform01()), static_cast<float>(rng.uniform01()),
+                          static_cast<float>(rng.uniform01())};
+            learner.push(a, static_cast<int>(rng.below(3)) - 1, rng.uniform(-1, 1), a, rng.below(10) == 0);
+        }
+
+        std::string iguales;   // 1 si la objetivo es igual a la red en línea tras cada actualización
+        std::size_t cambios_entre_copias = 0;
+        auto copia = PongAgent<float>::build_sequential(8, 1);
+        for (int u = 1; u <= 10; ++u) {
+            learner.update(0.0);
+            iguales += same_params(learner.target(), learner.online()) ? '1' : '0';
+            if (u % 3 == 0) {
+                *copia->l1 = *learner.online().l1;
+                *copia->l2 = *learner.online().l2;
+            } else if (u > 3) {
+                cambios_entre_copias += !same_params(learner.target(), *copia);
+            }
+        }
+        std::cout << "Red objetivo con target_sync = 3: igual a la red en linea tras las actualizaciones " << iguales
+                  << " (esperado 0010010010), " << cambios_entre_copias << " cambios entre copias\n";
+        if (iguales != "0010010010" || cambios_entre_copias || learner.updates() != 10) ++errores;
+    }
+
+    // 5. Contadores de DQNTrainer
+    {
+        DQNConfig<float> cfg;
+        cfg.hidden_size = 8;
+        cfg.num_envs = 4;
+        cfg.total_steps = 2000;
+        cfg.warmup = 400;
+        cfg.train_every = 4;
+        cfg.buffer_capacity = 1000;
+        cfg.batch_size = 8;
+        cfg.log_every = 0;
+        DQNTrainer<float> trainer(cfg);
+        auto red = trainer.train();
+        // Las actualizaciones empiezan con 400 transiciones y siguen una cada 4: (2000 - 400 + 4) / 4
+        const std::size_t esperadas = (cfg.total_steps - cfg.warmup + cfg.num_envs) / cfg.train_every;
+        std::cout << "DQNTrainer: " << trainer.steps() << " pasos, " << trainer.updates() << " actualizaciones (esperadas "
+                  << esperadas << "), memoria con " << trainer.replay_size() << " de " << cfg.buffer_capacity << "\n";
+        if (trainer.steps() != cfg.total_steps || trainer.updates() != esperadas
+            || trainer.replay_size() != cfg.buffer_capacity || !red)
+            ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nMemoria de repeticion y DQN verificados\n";
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_rollout_generator.cpp
+ * @brief Verifica la generación de datos por partidas del experto y mide su velocidad.
+ *
+ * ### Flujo principal:
+ * 1. InterceptExpert predice el punto de cruce con rebotes y casi nunca falla en EnvGym.
+ * 2. Cada fila reproduce el paso que grabó: EnvGym::set_state + step da la misma recompensa.
+ * 3. Un fragmento generado solo es igual al mismo tramo de la generación completa, y la salida
+ *    es idéntica byte a byte con 1 y con varios hilos.
+ * 4. El CSV y el binario se leen de vuelta con las mismas filas.
+ * 5. Genera ~4M de filas en binario e informa filas por minuto.
+ */
+
+#include "../include/agent/CsvLoader.h"
+#include "../include/agent/RolloutGenerator.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+using namespace utec::nn;
+
+namespace {
+
+bool same(const PongSample& a, const PongSample& b) {
+    return a.ball_x == b.ball_x && a.ball_y == b.ball_y && a.ball_vx == b.ball_vx && a.ball_vy == b.ball_vy
+           && a.paddle_y == b.paddle_y && a.action == b.action && a.reward == b.reward;
+}
+
+bool same(const std::vector<PongSample>& a, const std::vector<PongSample>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const PongSample& x, const PongSample& y) { return same(x, y); });
+}
+
+std::string read_all(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1. Predicción y tasa de golpes
+    {
+        const State sube{0.5f, 0.5f, 0.5f};
+        const float directo = InterceptExpert::intercept_y(sube, -0.1f, 0.02f);     // 5 pasos: 0.6
+        const float rebote = InterceptExpert::intercept_y(sube, -0.05f, 0.1f);      // 10 pasos: 1.5 -> 0.5
+        const float vuelta = InterceptExpert::intercept_y({0.75f, 0.2f, 0.5f}, 0.05f, 0.01f);  // 25 pasos: 0.45
+        const bool prediccion = std::abs(directo - 0.6f) < 1e-5f && std::abs(rebote - 0.5f) < 1e-5f
+                                && std::abs(vuelta - 0.45f) < 1e-5f;
+
+        RolloutConfig cfg;
+        cfg.rows = 200'000;
+        cfg.shard_rows = 50'000;
+        RolloutStats stats;
+        const auto filas = RolloutGenerator(cfg).generate(&stats);
+        const bool ok = prediccion && filas.size() == cfg.rows && stats.hit_rate() > 0.99;
+        std::cout << "Experto: prediccion con rebotes " << (prediccion ? "correcta" : "INCORRECTA") << ", "
+                  << stats.hits << " golpes y " << stats.misses << " fallos en " << stats.episodes
+                  << " episodios (" << std::fixed << std::setprecision(2) << 100.0 * stats.hit_rate() << "%)\n";
+        if (!ok) ++errores;
+
+        // 2. Cada fila es el paso real: mismo estado y velocidad -> misma recompensa
+        std::size_t distintas = 0;
+        EnvGym env(std::uint64_t{1});
+        for (std::size_t i = 0; i < filas.size(); i += 97) {
+            const auto& s = filas[i];
+            env.set_state({s.ball_x, s.ball_y, s.paddle_y}, s.ball_vx, s.ball_vy);
+            float reward = 0.0f;
+            bool done = false;
+            env.step(s.action, reward, done);
+            distintas += reward != s.reward;
+        }
+        std::cout << "Pasos repetidos con set_state: " << (distintas ? "DISTINTOS" : "misma recompensa") << "\n";
+        if (distintas) ++errores;
+
+        // Con exploración aparecen fallos y acciones fuera del experto
+        cfg.epsilon = 0.3f;
+        RolloutStats ruido;
+        RolloutGenerator(cfg).generate(&ruido);
+        if (ruido.misses == 0) ++errores;
+    }
+
+    // 3 y 4. Fragmentos reproducibles, 1 vs varios hilos, ida y vuelta
+    {
+        RolloutConfig cfg;
+        cfg.rows = 123'457;
+        cfg.shard_rows = 10'000;
+        cfg.epsilon = 0.05f;
+        cfg.seed = 42;
+        const RolloutGenerator gen(cfg);
+        const auto esperadas = gen.generate();
+
+        std::vector<PongSample> quinto;
+        gen.generate_shard(5, quinto);
+        const bool fragmento = std::equal(quinto.begin(), quinto.end(), esperadas.begin() + 50'000,
+                                          [](const PongSample& x, const PongSample& y) { return same(x, y); });
+        std::vector<PongSample> ultimo;
+        gen.generate_shard(gen.shards() - 1, ultimo);
+
+        auto uno = cfg;
+        uno.threads = 1;
+        auto varios = cfg;
+        varios.threads = std::max(2u, std::thread::hardware_concurrency());
+        RolloutGenerator(uno).write_csv("/tmp/partidas_1.csv");
+        RolloutGenerator(varios).write_csv("/tmp/partidas_n.csv");
+        RolloutGenerator(uno).write_columns("/tmp/partidas_1.bin");
+        RolloutGenerator(varios).write_columns("/tmp/partidas_n.bin");
+
+        const bool csv_ok = same(load_pong_csv("/tmp/partidas_n.csv").samples, esperadas);
+        const bool bin_ok = same(PongColumns("/tmp/partidas_n.bin").samples(), esperadas);
+        const bool iguales = read_all("/tmp/partidas_1.csv") == read_all("/tmp/partidas_n.csv")
+                             && read_all("/tmp/partidas_1.bin") == read_all("/tmp/partidas_n.bin");
+        std::cout << gen.shards() << " fragmentos de " << cfg.rows << " filas: fragmento suelto "
+                  << (fragmento && ultimo.size() == 3457 ? "igual" : "DISTINTO") << ", CSV "
+                  << (csv_ok ? "correcto" : "INCORRECTO") << ", binario " << (bin_ok ? "correcto" : "INCORRECTO")
+                  << ", 1 vs " << varios.threads << " hilos " << (iguales ? "identicos" : "DISTINTOS") << "\n";
+        if (!fragmento || ultimo.size() != 3457 || !csv_ok || !bin_ok || !iguales) ++errores;
+        for (const char* f : {"/tmp/partidas_1.csv", "/tmp/partidas_n.csv", "/tmp/partidas_1.bin", "/tmp/partidas_n.bin"})
+            std::remove(f);
+    }
+
+    // 5. Velocidad
+    {
+        RolloutConfig cfg;
+        cfg.rows = 4'000'000;
+        const auto bin = RolloutGenerator(cfg).write_columns("/tmp/partidas_grande.bin");
+        std::cout << std::fixed << std::setprecision(1) << "\n" << bin.rows / 1e6 << "M filas en " << bin.episodes
+                  << " episodios\n";
+        std::cout << "  binario : " << std::setw(7) << bin.bytes / 1048576.0 << " MiB en " << std::setprecision(2)
+                  << bin.seconds << " s -> " << std::setprecision(0) << bin.rows_per_sec() * 60 / 1e6
+                  << "M filas/min\n";
+        if (PongColumns("/tmp/partidas_grande.bin").rows() != cfg.rows) ++errores;
+        std::remove("/tmp/partidas_grande.bin");
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nGenerador por partidas verificado\n";
+    return 0;
+}
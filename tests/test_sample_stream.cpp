@@ -0,0 +1,219 @@
+/**
+ * @file test_sample_stream.cpp
+ * @brief Verifica la lectura por bloques con mezcla (SampleStream) y mide su memoria.
+ *
+ * ### Flujo principal:
+ * 1. CsvSampleSource con tramos de 4 KiB da las mismas filas que load_pong_csv, con encabezado,
+ *    "\r\n", filas vacías y el formato de 5 columnas.
+ * 2. Con mezcla, cada pasada es una permutación de la fuente, distinta en cada época y
+ *    repetible con la misma semilla; las primeras muestras vienen de muchos bloques.
+ * 3. Sin mezcla, train_from_stream da los mismos pesos que train_from_samples, y
+ *    NeuralNetwork::train sobre el flujo los mismos que sobre los tensores completos.
+ * 4. Recorre 50M de muestras generadas: la memoria residente no crece con la cantidad de filas.
+ */
+
+#include "../include/agent/PongAgent.h"
+#include "../include/nn/neural_network.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <unistd.h>
+
+using namespace utec::nn;
+
+namespace {
+
+PongSample make_sample(std::uint64_t i) {
+    utec::utils::Xoshiro256 rng(i + 1);
+    const float ball_y = static_cast<float>(rng.uniform01());
+    const float paddle_y = static_cast<float>(rng.uniform01());
+    const int action = ball_y > paddle_y + 0.05f ? 1 : (ball_y < paddle_y - 0.05f ? -1 : 0);
+    return {static_cast<float>(rng.uniform01()), ball_y, 0.01f, -0.01f, paddle_y, action, 1.0f};
+}
+
+auto key(const PongSample& s) { return std::tie(s.ball_x, s.ball_y, s.paddle_y, s.action); }
+
+bool same(const PongSample& a, const PongSample& b) {
+    return key(a) == key(b) && a.ball_vx == b.ball_vx && a.ball_vy == b.ball_vy && a.reward == b.reward;
+}
+
+std::vector<PongSample> drain(SampleStream& stream) {
+    std::vector<PongSample> out, batch(100);
+    while (const std::size_t n = stream.next_batch(std::span<PongSample>(batch)))
+        out.insert(out.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(n));
+    return out;
+}
+
+bool is_permutation_of(std::vector<PongSample> a, std::vector<PongSample> b) {
+    auto less = [](const PongSample& x, const PongSample& y) { return key(x) < key(y); };
+    std::sort(a.begin(), a.end(), less);
+    std::sort(b.begin(), b.end(), less);
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), same);
+}
+
+std::size_t resident_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+    const std::string csv = "/tmp/pong_stream.csv";
+
+    std::vector<PongSample> fuente(20000);
+    for (std::size_t i = 0; i < fuente.size(); ++i) fuente[i] = make_sample(i);
+    {
+        std::ofstream out(csv, std::ios::binary);
+        out << "ball_x,ball_y,ball_vx,ball_vy,paddle_y,action,reward\r\n";
+        for (std::size_t i = 0; i < fuente.size(); ++i) {
+            const auto& s = fuente[i];
+            char buf[160];
+            std::snprintf(buf, sizeof(buf), "%.9g,%.9g,%.9g,%.9g,%.9g,%d,%.9g\r\n", s.ball_x, s.ball_y, s.ball_vx,
+                          s.ball_vy, s.paddle_y, s.action, s.reward);
+            out << buf;
+            if (i % 1000 == 0) out << "\r\n";
+        }
+    }
+
+    // 1. CSV por tramos
+    {
+        StreamOptions sin_mezcla;
+        sin_mezcla.shuffle_rows = 0;
+        sin_mezcla.chunk_rows = 777;
+        SampleStream stream(std::make_unique<CsvSampleSource>(csv, 4096), sin_mezcla);
+        const auto leidas = drain(stream);
+        const auto cargadas = load_pong_csv(csv).samples;
+        const bool ok = std::equal(leidas.begin(), leidas.end(), cargadas.begin(), cargadas.end(), same)
+                        && leidas.size() == fuente.size();
+
+        const std::string manual = "/tmp/pong_stream_manual.csv";
+        std::ofstream(manual) << "0.53,0.51,0.55,1,-0.01\n0.56,0.52,0.65,2,-0.01";
+        CsvSampleSource cinco(manual, 4096);
+        std::vector<PongSample> dos(4);
+        const bool ok5 = cinco.read(dos) == 2 && dos[1].paddle_y == 0.65f && dos[1].action == 2;
+        std::remove(manual.c_str());
+        std::cout << "CSV por tramos de 4 KiB: " << leidas.size() << " filas "
+                  << (ok && ok5 ? "iguales a load_pong_csv" : "DISTINTAS") << "\n";
+        if (!ok || !ok5) ++errores;
+    }
+
+    // 2. Mezcla
+    {
+        StreamOptions opts;
+        opts.chunk_rows = 1000;
+        opts.shuffle_rows = 4096;
+        opts.seed = 9;
+        SampleStream a(std::make_unique<CsvSampleSource>(csv), opts);
+        SampleStream b(std::make_unique<CsvSampleSource>(csv), opts);
+        const auto pasada1 = drain(a);
+        a.reset();
+        const auto pasada2 = drain(a);
+        const auto repetida = drain(b);
+
+        std::map<std::tuple<float, float, float, int>, std::size_t> posicion;
+        for (std::size_t i = 0; i < fuente.size(); ++i) posicion[key(fuente[i])] = i;
+        std::size_t bloques[5] = {};
+        for (std::size_t i = 0; i < 1000; ++i) ++bloques[std::min<std::size_t>(4, posicion[key(pasada1[i])] / 1000)];
+        const std::size_t de_otros = 1000 - bloques[0];
+
+        const bool permutaciones = is_permutation_of(pasada1, fuente) && is_permutation_of(pasada2, fuente);
+        const bool distintas = !std::equal(pasada1.begin(), pasada1.end(), pasada2.begin(), pasada2.end(), same);
+        const bool repetible = std::equal(pasada1.begin(), pasada1.end(), repetida.begin(), repetida.end(), same);
+        std::cout << "Mezcla: permutacion " << (permutaciones ? "si" : "NO") << ", epocas distintas "
+                  << (distintas ? "si" : "NO") << ", repetible " << (repetible ? "si" : "NO") << ", "
+                  << de_otros << " de las primeras 1000 fuera del primer bloque\n";
+        if (!permutaciones || !distintas || !repetible || de_otros < 500) ++errores;
+    }
+
+    // 3. Mismo entrenamiento que con los datos en memoria
+    {
+        StreamOptions sin_mezcla;
+        sin_mezcla.shuffle_rows = 0;
+        sin_mezcla.chunk_rows = 3000;
+        const std::vector<PongSample> datos(fuente.begin(), fuente.begin() + 5000);
+        TrainConfig<float> cfg;
+        cfg.epochs = 2;
+        cfg.batch_size = 64;
+        cfg.seed = 3;
+        SampleStream stream(std::make_unique<GeneratedSampleSource>(datos.size(), make_sample), sin_mezcla);
+        auto a = PongAgent<float>::train_from_samples(datos, cfg);
+        auto b = PongAgent<float>::train_from_stream(stream, cfg);
+        auto& sa = static_cast<PongAgent<float>::Sequential&>(*a);
+        auto& sb = static_cast<PongAgent<float>::Sequential&>(*b);
+        const bool iguales = std::equal(sa.l1->weights().begin(), sa.l1->weights().end(), sb.l1->weights().begin())
+                             && std::equal(sa.l2->weights().begin(), sa.l2->weights().end(), sb.l2->weights().begin());
+
+        using namespace utec::neural_network;
+        auto build = [](NeuralNetwork<float>& net) {
+            auto init = [](Tensor<float, 2>& t) {
+                for (std::size_t i = 0; i < t.size(); ++i) t[i] = std::sin(static_cast<float>(i * 5 + 1)) * 0.5f;
+            };
+            net.add_layer(std::make_unique<Dense<float>>(3, 8, init));
+            net.add_layer(std::make_unique<ReLU<float>>());
+            net.add_layer(std::make_unique<Dense<float>>(8, 3, init));
+        };
+        Tensor<float, 2> X(datos.size(), 3), Y(datos.size(), 3);
+        for (std::size_t r = 0; r < datos.size(); ++r) {
+            X(r, 0) = datos[r].ball_x;
+            X(r, 1) = datos[r].ball_y;
+            X(r, 2) = datos[r].paddle_y;
+            Y(r, 0) = datos[r].action == -1;
+            Y(r, 1) = datos[r].action == 0;
+            Y(r, 2) = datos[r].action == 1;
+        }
+        NeuralNetwork<float> en_memoria, por_flujo;
+        build(en_memoria);
+        build(por_flujo);
+        en_memoria.compile(64);
+        por_flujo.compile(64);
+        en_memoria.train<MSELoss>(X, Y, 2, 64, 0.05f);
+        por_flujo.train<MSELoss>(stream, 2, 64, 0.05f);
+        const auto pa = en_memoria.predict(X);
+        const auto pb = por_flujo.predict(X);
+        const bool red_igual = std::equal(pa.begin(), pa.end(), pb.begin());
+        std::cout << "Sin mezcla: train_from_stream " << (iguales ? "identico" : "DISTINTO")
+                  << ", NeuralNetwork::train sobre el flujo " << (red_igual ? "identico" : "DISTINTO") << "\n";
+        if (!iguales || !red_igual) ++errores;
+    }
+
+    // 4. Memoria constante con muchas filas
+    {
+        StreamOptions opts;
+        SampleStream stream(std::make_unique<GeneratedSampleSource>(50'000'000, make_sample), opts);
+        std::vector<PongSample> lote(256);
+        std::uint64_t filas = 0, golpes = 0;
+        std::size_t rss_10m = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        while (const std::size_t n = stream.next_batch(std::span<PongSample>(lote))) {
+            for (std::size_t i = 0; i < n; ++i) golpes += lote[i].action == 1;
+            filas += n;
+            if (filas == 10'000'128) rss_10m = resident_bytes();
+        }
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        const std::size_t rss_final = resident_bytes();
+        std::cout << std::fixed << std::setprecision(1) << "\n" << filas / 1e6 << "M filas generadas en " << s
+                  << " s (" << filas / s / 1e6 << "M filas/s), accion +1: " << 100.0 * golpes / filas << "%\n";
+        std::cout << "  buferes del flujo       : " << stream.memory_bytes() / 1048576.0 << " MiB\n";
+        std::cout << "  residente a 10M / 50M   : " << rss_10m / 1048576.0 << " / " << rss_final / 1048576.0
+                  << " MiB\n";
+        std::cout << "  como vector<PongSample> : " << filas * sizeof(PongSample) / 1048576.0 << " MiB\n";
+        if (filas != 50'000'000 || rss_final > rss_10m + (std::size_t{8} << 20)) ++errores;
+    }
+    std::remove(csv.c_str());
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nLectura por bloques verificada\n";
+    return 0;
+}
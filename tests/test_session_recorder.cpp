@@ -0,0 +1,200 @@
+/**
+ * @file test_session_recorder.cpp
+ * @brief Verifica la grabación asíncrona de partidas y mide cuánto tarda record().
+ *
+ * ### Flujo principal:
+ * 1. Graba 200k pasos de EnvGym y los lee de vuelta iguales; los registros repiten su paso con
+ *    EnvGym::set_state (estado previo + velocidad) y marcan los fines de episodio.
+ * 2. Una segunda sesión agrega al mismo archivo; un registro cortado al final se ignora al leer
+ *    y se recorta al volver a grabar.
+ * 3. Rechaza archivos de otro formato o de otra versión del esquema.
+ * 4. Con la cola llena, record() descarta en vez de esperar y lo cuenta.
+ * 5. train_from_csv entrena directamente desde la grabación.
+ * 6. Compara el tiempo por paso de record() con escribir una línea con ofstream.
+ */
+
+#include "../include/agent/PongAgent.h"
+#include "../include/agent/SessionRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace utec::nn;
+
+namespace {
+
+bool same(const StepRecord& a, const StepRecord& b) { return std::memcmp(&a, &b, sizeof(StepRecord)) == 0; }
+
+/// @brief Juega `steps` pasos al azar y devuelve los registros que corresponden
+std::vector<StepRecord> play(std::size_t steps, std::uint64_t seed) {
+    utec::utils::Xoshiro256 rng(seed);
+    EnvGym env(seed);
+    State s = env.reset();
+    std::vector<StepRecord> out;
+    out.reserve(steps);
+    for (std::size_t i = 0; i < steps; ++i) {
+        const float vx = env.ball_vx(), vy = env.ball_vy();
+        const int action = static_cast<int>(rng.below(3)) - 1;
+        float reward = 0.0f;
+        bool done = false;
+        const State next = env.step(action, reward, done);
+        out.push_back({s.ball_x, s.ball_y, vx, vy, s.paddle_y, action, reward, done ? STEP_DONE : 0u});
+        s = done ? env.reset() : next;
+    }
+    return out;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+    const std::string ruta = "/tmp/pong_sesion.rec";
+    std::remove(ruta.c_str());
+
+    const auto pasos = play(200'000, 7);
+    std::vector<double> latencias;
+    latencias.reserve(pasos.size());
+
+    // 1. Ida y vuelta
+    {
+        SessionRecorder grabador(ruta, std::size_t{1} << 18);
+        for (const auto& p : pasos) {
+            const auto t0 = std::chrono::steady_clock::now();
+            grabador.record(p);
+            latencias.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count());
+        }
+        grabador.close();
+        const auto leidos = read_step_records(ruta);
+        const bool ok = grabador.dropped() == 0 && grabador.written() == pasos.size()
+                        && std::equal(leidos.begin(), leidos.end(), pasos.begin(), pasos.end(), same);
+
+        // Repetir un paso desde el estado grabado da la misma recompensa y el mismo fin
+        std::size_t distintos = 0, repetidos = 0, fines = 0;
+        EnvGym env(std::uint64_t{1});
+        for (std::size_t i = 0; i < leidos.size(); i += 13, ++repetidos) {
+            const auto& r = leidos[i];
+            env.set_state({r.ball_x, r.ball_y, r.paddle_y}, r.ball_vx, r.ball_vy);
+            float reward = 0.0f;
+            bool done = false;
+            env.step(r.action, reward, done);
+            distintos += reward != r.reward || done != ((r.flags & STEP_DONE) != 0);
+        }
+        for (const auto& r : leidos) fines += (r.flags & STEP_DONE) != 0;
+        std::cout << "Grabacion de " << pasos.size() << " pasos: " << (ok ? "leida igual" : "DISTINTA") << ", "
+                  << fines << " fines de episodio, " << repetidos - distintos << " de " << repetidos
+                  << " pasos repetidos con set_state iguales\n";
+        if (!ok || distintos != 0 || fines == 0) ++errores;
+    }
+
+    // 2. Varias sesiones y registros cortados
+    {
+        const auto extra = play(1000, 8);
+        {
+            SessionRecorder grabador(ruta);
+            for (const auto& p : extra) grabador.record(p);
+        }
+        std::ofstream(ruta, std::ios::binary | std::ios::app).write("\x01\x02\x03\x04\x05", 5);
+        const bool cortado_ignorado = read_step_records(ruta).size() == pasos.size() + extra.size();
+        {
+            SessionRecorder grabador(ruta);
+            grabador.record(extra.front());
+        }
+        const auto todos = read_step_records(ruta);
+        const bool ok = cortado_ignorado && todos.size() == pasos.size() + extra.size() + 1
+                        && same(todos[pasos.size()], extra.front()) && same(todos.back(), extra.front())
+                        && std::filesystem::file_size(ruta) == sizeof(RecordingHeader) + todos.size() * sizeof(StepRecord);
+        std::cout << "Tres sesiones en un archivo: " << todos.size() << " pasos, registro cortado "
+                  << (ok ? "ignorado y recortado" : "MAL MANEJADO") << "\n";
+        if (!ok) ++errores;
+    }
+
+    // 3. Archivos ajenos
+    {
+        const std::string csv = "/tmp/pong_sesion.csv";
+        std::ofstream(csv) << "0.5,0.5,0.5,1,-0.01\n";
+        std::string otra(sizeof(RecordingHeader), '\0');
+        std::memcpy(otra.data(), RECORDING_MAGIC, 8);
+        otra[8] = 2;   // versión 2
+        const std::string vieja = "/tmp/pong_sesion_v2.rec";
+        std::ofstream(vieja, std::ios::binary) << otra;
+
+        int rechazos = 0;
+        for (const auto& f : {csv, vieja}) {
+            try {
+                SessionRecorder g(f);
+            } catch (const std::runtime_error&) {
+                ++rechazos;
+            }
+            try {
+                read_step_records(f);
+            } catch (const std::runtime_error&) {
+                ++rechazos;
+            }
+        }
+        std::cout << "Archivos de otro formato o version: " << rechazos << " de 4 rechazos\n";
+        if (rechazos != 4 || std::filesystem::file_size(csv) != 20) ++errores;
+        std::remove(csv.c_str());
+        std::remove(vieja.c_str());
+    }
+
+    // 4. Cola llena: se descarta sin esperar
+    {
+        const std::string lleno = "/tmp/pong_sesion_llena.rec";
+        std::remove(lleno.c_str());
+        SessionRecorder grabador(lleno, 64, std::chrono::milliseconds(200));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));   // el hilo de fondo ya duerme
+        std::size_t aceptados = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < 10'000; ++i) aceptados += grabador.record(pasos[i]);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        grabador.close();
+        const bool ok = grabador.dropped() > 0 && aceptados + grabador.dropped() == 10'000
+                        && read_step_records(lleno).size() == aceptados && ms < 100.0;
+        std::cout << "Cola de 64 llena: " << aceptados << " aceptados, " << grabador.dropped() << " descartados en "
+                  << std::fixed << std::setprecision(2) << ms << " ms " << (ok ? "sin esperar" : "MAL") << "\n";
+        if (!ok) ++errores;
+        std::remove(lleno.c_str());
+    }
+
+    // 5. Entrenamiento desde la grabación
+    {
+        const auto muestras = load_pong_recording(ruta);
+        auto modelo = PongAgent<float>::train_from_csv(ruta, 1, 0.01f);
+        const bool ok = is_recording_file(ruta) && muestras.size() == pasos.size() + 1001 && modelo
+                        && muestras[5].ball_vx == pasos[5].ball_vx && muestras[5].action == pasos[5].action;
+        std::cout << "train_from_csv sobre la grabacion: " << (ok ? "entrenado" : "FALLO") << " con "
+                  << muestras.size() << " muestras\n";
+        if (!ok) ++errores;
+        for (const auto& f : std::filesystem::directory_iterator("/tmp"))   // caché de la preparación
+            if (f.path().filename().string().starts_with("pong_sesion.rec.")) std::filesystem::remove(f.path());
+    }
+    std::remove(ruta.c_str());
+
+    // 6. Costo por paso en el bucle del juego
+    {
+        std::sort(latencias.begin(), latencias.end());
+        const std::string texto = "/tmp/pong_sesion_texto.csv";
+        std::ofstream archivo(texto, std::ios::app);
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const auto& p : pasos)
+            archivo << p.ball_x << "," << p.ball_y << "," << p.paddle_y << "," << p.action << "," << p.reward << "\n";
+        archivo.close();
+        const double ns_texto =
+            std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / pasos.size();
+        std::remove(texto.c_str());
+        std::cout << std::fixed << std::setprecision(0) << "\nrecord(): mediana " << latencias[latencias.size() / 2]
+                  << " ns, p99 " << latencias[latencias.size() * 99 / 100] << " ns por paso\n"
+                  << "ofstream << (5 columnas): " << ns_texto << " ns por paso en promedio\n";
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nGrabacion de partidas verificada\n";
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_sweep.cpp
+ * @brief Verifica la expansión de SweepSpace y el ranking de run_sweep.
+ *
+ * ### Flujo principal:
+ * 1. grid() produce cada combinación de valores exactamente una vez, en orden.
+ * 2. random() elige solo valores listados, la tasa de aprendizaje queda entre el mínimo y el
+ *    máximo con distribución log-uniforme, y la misma semilla repite la muestra.
+ * 3. run_sweep da los mismos resultados en el mismo orden con 1, 3 y 8 hilos, y el orden
+ *    respeta las claves: tasa de golpes, época hasta el objetivo y pérdida final.
+ */
+
+#include "../include/agent/RolloutGenerator.h"
+#include "../include/agent/Sweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <tuple>
+#include <vector>
+
+using namespace utec::nn;
+
+namespace {
+
+using Key = std::tuple<size_t, float, int, size_t, int, bool>;
+
+Key key(const TrainConfig<float>& c) {
+    return {c.hidden_size, c.learning_rate, static_cast<int>(c.optimizer), c.batch_size, c.epochs, c.normalize_inputs};
+}
+
+bool same_result(const SweepResult<float>& a, const SweepResult<float>& b) {
+    return key(a.config) == key(b.config) && a.config.seed == b.config.seed && a.final_loss == b.final_loss
+           && a.eval.hits == b.eval.hits && a.eval.misses == b.eval.misses && a.eval.steps == b.eval.steps
+           && a.epoch_to_quality == b.epoch_to_quality;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+
+    // 1. Grilla
+    {
+        SweepSpace<float> space;
+        space.hidden_sizes = {4, 8};
+        space.learning_rates = {0.01f, 0.001f};
+        space.optimizers = {OptimizerKind::SGD, OptimizerKind::Adam};
+        space.batch_sizes = {1, 8};
+        space.epochs = {3, 5};
+        space.normalize = {false, true};
+        const auto grilla = space.grid();
+
+        std::set<Key> distintas;
+        for (const auto& c : grilla) distintas.insert(key(c));
+        // Orden: la oculta cambia más lento y normalize más rápido
+        const bool orden = key(grilla.front()) == Key{4, 0.01f, 0, 1, 3, false}
+                           && key(grilla[1]) == Key{4, 0.01f, 0, 1, 3, true}
+                           && key(grilla.back()) == Key{8, 0.001f, 1, 8, 5, true};
+        std::cout << "Grilla 2x2x2x2x2x2: " << grilla.size() << " configuraciones, " << distintas.size()
+                  << " distintas, orden " << (orden ? "correcto" : "INCORRECTO") << "\n";
+        if (grilla.size() != 64 || distintas.size() != 64 || !orden) ++errores;
+    }
+
+    // 2. Muestreo aleatorio
+    {
+        SweepSpace<float> space;
+        space.hidden_sizes = {4, 8, 16};
+        space.learning_rates = {1e-5f, 1e-1f};
+        space.optimizers = {OptimizerKind::SGD, OptimizerKind::Adam};
+        space.batch_sizes = {1, 32};
+        space.epochs = {10, 20};
+        space.normalize = {false, true};
+        const auto muestra = space.random(4000, 7);
+
+        std::size_t fuera = 0, bajo_media_geo = 0;
+        std::set<size_t> ocultas;
+        for (const auto& c : muestra) {
+            fuera += std::find(space.hidden_sizes.begin(), space.hidden_sizes.end(), c.hidden_size) == space.hidden_sizes.end()
+                     || (c.batch_size != 1 && c.batch_size != 32) || (c.epochs != 10 && c.epochs != 20)
+                     || c.learning_rate < 1e-5f * 0.9999f || c.learning_rate > 1e-1f * 1.0001f;
+            bajo_media_geo += c.learning_rate < 1e-3f;   // 1e-3 es la media geométrica de 1e-5 y 1e-1
+            ocultas.insert(c.hidden_size);
+        }
+        const double frac = static_cast<double>(bajo_media_geo) / muestra.size();
+        const auto repetida = space.random(4000, 7);
+        const auto otra = space.random(4000, 8);
+        bool igual = true, distinta = false;
+        for (std::size_t i = 0; i < muestra.size(); ++i) {
+            igual &= key(muestra[i]) == key(repetida[i]);
+            distinta |= key(muestra[i]) != key(otra[i]);
+        }
+        std::cout << "Muestreo aleatorio de 4000: " << fuera << " fuera de los valores, " << ocultas.size()
+                  << " ocultas usadas, " << frac << " de las tasas bajo 1e-3 (log-uniforme: ~0.5), misma semilla "
+                  << (igual ? "repite" : "NO REPITE") << ", otra semilla " << (distinta ? "cambia" : "NO CAMBIA")
+                  << "\n";
+        if (fuera || ocultas.size() != 3 || std::abs(frac - 0.5) > 0.05 || !igual || !distinta) ++errores;
+    }
+
+    // 3. Ranking independiente de los hilos
+    {
+        RolloutConfig rc;
+        rc.rows = 3000;
+        rc.epsilon = 0.1;
+        rc.seed = 2;
+        const auto datos = RolloutGenerator(rc).generate();
+
+        SweepSpace<float> space;
+        space.hidden_sizes = {4, 8};
+        space.learning_rates = {1.0f, 0.2f};
+        space.batch_sizes = {8, 32};
+        space.epochs = {40};
+        const auto configs = space.grid();
+
+        SweepOptions opts;
+        opts.eval_steps = 3000;
+        opts.eval_every = 2;
+        opts.target_hit_rate = 0.3;
+        opts.seed = 9;
+
+        std::vector<std::vector<SweepResult<float>>> corridas;
+        for (size_t hilos : {1u, 3u, 8u}) {
+            opts.threads = hilos;
+            corridas.push_back(run_sweep<float>(datos, configs, opts));
+        }
+
+        std::size_t distintos = 0;
+        for (std::size_t c = 1; c < corridas.size(); ++c)
+            for (std::size_t i = 0; i < corridas[0].size(); ++i) distintos += !same_result(corridas[0][i], corridas[c][i]);
+
+        std::size_t desordenados = 0, alcanzan = 0;
+        const auto& r = corridas[0];
+        for (std::size_t i = 0; i < r.size(); ++i) {
+            alcanzan += r[i].epoch_to_quality >= 0;
+            if (i == 0) continue;
+            const auto& a = r[i - 1];
+            const auto& b = r[i];
+            const int ea = a.epoch_to_quality < 0 ? 1 << 30 : a.epoch_to_quality;
+            const int eb = b.epoch_to_quality < 0 ? 1 << 30 : b.epoch_to_quality;
+            desordenados += std::make_tuple(-a.eval.hit_rate(), ea, a.final_loss)
+                            > std::make_tuple(-b.eval.hit_rate(), eb, b.final_loss);
+        }
+
+        std::cout << "run_sweep con 1, 3 y 8 hilos: " << distintos << " resultados distintos o en otra posicion de "
+                  << 2 * r.size() << ", " << desordenados << " pares fuera de orden; " << alcanzan << " de " << r.size()
+                  << " llegan a " << opts.target_hit_rate << " (mejor: " << r.front().eval.hit_rate() << ")\n";
+        if (r.size() != configs.size() || distintos || desordenados) ++errores;
+    }
+
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nBarrido de hiperparametros verificado\n";
+    return 0;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file test_telemetry.cpp
+ * @brief Verifica la telemetría de entrenamiento (nn/telemetry.h).
+ *
+ * Se compila junto con src/utec/nn/TelemetryAllocHooks.cpp (lo mismo que la opción de CMake
+ * PONG_TELEMETRY_ALLOC_HOOKS) para que se cuenten las asignaciones.
+ *
+ * ### Flujo principal:
+ * 1. CSV: una fila por época y capa, con pasos y muestras de la época, tiempos de forward,
+ *    backward y update por capa (la suma de las fases no supera la duración de la época) y
+ *    asignaciones por paso reportadas (la red interpretada asigna; la compilada no).
+ *    La inferencia compilada con predict(X, out) tampoco asigna.
+ * 2. JSON lines: un registro por época con una entrada por capa.
+ * 3. Sin telemetría (nullptr) no se escribe nada, y medir no cambia lo que se entrena.
+ */
+
+#include "../include/nn/activation.h"
+#include "../include/nn/dense.h"
+#include "../include/nn/neural_network.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace utec::neural_network;
+using utec::algebra::Tensor;
+
+namespace {
+
+void init_weights(Tensor<float, 2>& t) {
+    for (size_t i = 0; i < t.size(); ++i) t[i] = std::sin(static_cast<float>(i * 7 + t.shape()[1])) * 0.5f;
+}
+
+void build(NeuralNetwork<float>& net) {
+    net.add_layer(std::make_unique<Dense<float>>(4, 32, init_weights));
+    net.add_layer(std::make_unique<ReLU<float>>());
+    net.add_layer(std::make_unique<Dense<float>>(32, 2, init_weights));
+    net.add_layer(std::make_unique<Sigmoid<float>>());
+}
+
+/// @brief Fila del CSV de telemetría
+struct Row {
+    std::size_t run, epoch, layer, steps, samples;
+    std::string name;
+    double forward_ms, backward_ms, update_ms, seconds, bytes_per_step, allocs_per_step;
+};
+
+std::vector<Row> read_csv(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);   // encabezado
+    std::vector<Row> rows;
+    while (std::getline(in, line)) {
+        std::stringstream ss(line);
+        std::vector<std::string> f;
+        for (std::string cell; std::getline(ss, cell, ',');) f.push_back(cell);
+        if (f.size() != 15) continue;
+        rows.push_back({std::stoul(f[0]), std::stoul(f[2]), std::stoul(f[3]), std::stoul(f[9]), std::stoul(f[10]), f[4],
+                        std::stod(f[5]), std::stod(f[6]), std::stod(f[7]), std::stod(f[11]), std::stod(f[13]),
+                        std::stod(f[14])});
+    }
+    return rows;
+}
+
+std::vector<float> weights_of(NeuralNetwork<float>& net) {
+    std::vector<float> w;
+    for (size_t i : {0u, 2u}) {
+        auto& d = dynamic_cast<Dense<float>&>(net.layer(i));
+        w.insert(w.end(), d.weights().begin(), d.weights().end());
+        w.insert(w.end(), d.bias().begin(), d.bias().end());
+    }
+    return w;
+}
+
+} // namespace
+
+int main() {
+    int errores = 0;
+    const std::string csv = "/tmp/pong_telemetria.csv", jsonl = "/tmp/pong_telemetria.jsonl";
+    std::remove(csv.c_str());
+    std::remove(jsonl.c_str());
+
+    Tensor<float, 2> X(256, 4), Y(256, 2);
+    for (size_t i = 0; i < X.size(); ++i) X[i] = std::sin(static_cast<float>(i) * 0.37f);
+    for (size_t r = 0; r < 256; ++r) {
+        Y(r, 0) = X(r, 0) > 0 ? 1.0f : 0.0f;
+        Y(r, 1) = 1.0f - Y(r, 0);
+    }
+    const size_t epocas = 5, lote = 32, pasos = 256 / lote;
+
+    // 1. CSV: red interpretada (corrida 1) y compilada (corrida 2)
+    {
+        TrainingTelemetry telemetria(csv, TelemetryFormat::Csv);
+        NeuralNetwork<float> interpretada, compilada;
+        build(interpretada);
+        build(compilada);
+        compilada.compile(lote);
+        interpretada.set_telemetry(&telemetria);
+        compilada.set_telemetry(&telemetria);
+        interpretada.train<MSELoss>(X, Y, epocas, lote, 0.1f);
+        compilada.train<MSELoss>(X, Y, epocas, lote, 0.1f);
+        telemetria.end_run();
+
+        const auto filas = read_csv(csv);
+        std::size_t filas_run[3] = {0, 0, 0}, contadores_mal = 0, sin_tiempo = 0, excede = 0;
+        double asign_interpretada = -1, asign_compilada = -1;
+        for (std::size_t run = 1; run <= 2; ++run) {
+            for (std::size_t e = 0; e < epocas; ++e) {
+                double fases = 0, segundos = 0;
+                for (const auto& f : filas) {
+                    if (f.run != run || f.epoch != e) continue;
+                    ++filas_run[run];
+                    contadores_mal += f.steps != pasos || f.samples != 256;
+                    // Todas las capas o pasos tienen forward; backward y update solo si hacen algo
+                    sin_tiempo += !(f.forward_ms > 0);
+                    fases += f.forward_ms + f.backward_ms + f.update_ms;
+                    segundos = f.seconds;
+                    (run == 1 ? asign_interpretada : asign_compilada) = f.allocs_per_step;
+                }
+                excede += fases > segundos * 1000 * 1.01 + 0.01;
+            }
+        }
+        // La interpretada instrumenta 4 capas; la compilada 2 pasos fusionados (Dense+ReLU, Dense+Sigmoid)
+        const bool forma = filas_run[1] == epocas * 4 && filas_run[2] == epocas * 2;
+        const bool asignaciones = asign_interpretada > 0 && asign_compilada == 0;
+
+        // Inferencia compilada en un buffer del llamador: sin asignaciones después de la primera
+        const Tensor<float, 2> lote_x = X.slice(0, lote);
+        Tensor<float, 2> salida;
+        compilada.predict(lote_x, salida);
+        const std::size_t antes = telemetry_counters::allocation_count;
+        for (int rep = 0; rep < 100; ++rep) compilada.predict(lote_x, salida);
+        const std::size_t asign_predict = telemetry_counters::allocation_count - antes;
+
+        std::cout << "CSV: " << filas_run[1] << " filas de la red interpretada y " << filas_run[2]
+                  << " de la compilada (esperadas " << epocas * 4 << " y " << epocas * 2 << "), " << contadores_mal
+                  << " con pasos o muestras mal, " << sin_tiempo << " sin tiempo de forward, " << excede
+                  << " epocas con fases mas largas que la epoca\n"
+                  << "Asignaciones por paso: " << asign_interpretada << " interpretada, " << asign_compilada
+                  << " compilada; " << asign_predict << " en 100 predict(X, out) compilados\n";
+        if (!forma || contadores_mal || sin_tiempo || excede || !asignaciones || asign_predict) ++errores;
+    }
+
+    // 2. JSON lines
+    {
+        {
+            TrainingTelemetry telemetria(jsonl);
+            NeuralNetwork<float> red;
+            build(red);
+            red.set_telemetry(&telemetria);
+            red.train<MSELoss>(X, Y, epocas, lote, 0.1f);
+        }
+        std::ifstream in(jsonl);
+        std::size_t registros = 0, bien = 0;
+        for (std::string linea; std::getline(in, linea);) {
+            ++registros;
+            std::size_t capas = 0;
+            for (std::size_t p = linea.find("\"forward_ms\""); p != std::string::npos; p = linea.find("\"forward_ms\"", p + 1))
+                ++capas;
+            bien += linea.front() == '{' && linea.back() == '}' && capas == 4
+                    && linea.find("\"steps\":" + std::to_string(pasos)) != std::string::npos
+                    && linea.find("\"allocs_per_step\":-1") == std::string::npos;
+        }
+        std::cout << "JSON lines: " << registros << " registros, " << bien << " con 4 capas, pasos y asignaciones\n";
+        if (registros != epocas || bien != epocas) ++errores;
+    }
+
+    // 3. Sin telemetría
+    {
+        NeuralNetwork<float> medida, sin_medir;
+        build(medida);
+        build(sin_medir);
+        const auto antes = std::filesystem::file_size(csv);
+        {
+            TrainingTelemetry telemetria(csv, TelemetryFormat::Csv);
+            medida.set_telemetry(&telemetria);
+            medida.train<MSELoss>(X, Y, 2, lote, 0.1f);
+            medida.set_telemetry(nullptr);
+        }
+        const auto con = std::filesystem::file_size(csv);
+        medida.train<MSELoss>(X, Y, 2, lote, 0.1f);
+        sin_medir.train<MSELoss>(X, Y, 4, lote, 0.1f);
+        const auto despues = std::filesystem::file_size(csv);
+        const bool nada = con > antes && despues == con;
+        const bool iguales = weights_of(medida) == weights_of(sin_medir);
+        std::cout << "Sin telemetria: " << (nada ? "no se escribio nada" : "SE ESCRIBIO") << "; medir "
+                  << (iguales ? "no cambia" : "CAMBIA") << " los pesos entrenados\n";
+        if (!nada || !iguales) ++errores;
+    }
+
+    std::remove(csv.c_str());
+    std::remove(jsonl.c_str());
+    if (errores) {
+        std::cout << "\nERROR: " << errores << " verificaciones fallaron\n";
+        return 1;
+    }
+    std::cout << "\nTelemetria verificada\n";
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_vec_env.cpp
+ * @brief Verifica que VecEnvGym reproduzca paso a paso a EnvGym y mide su throughput.
+ *
+ * ### Flujo principal:
+ * 1. Crea N entornos EnvGym y un VecEnvGym de N entornos con los mismos estados y velocidades.
+ * 2. Los avanza con las mismas acciones aleatorias y compara estado, recompensa y done
+ *    hasta que cada entorno termina su primer episodio (después los reinicios difieren).
+ * 3. Comprueba que los entornos terminados se reiniciaron al centro.
+ * 4. Mide pasos de entorno por segundo.
+ */
+
+#include "../include/agent/EnvGym.h"
+#include "../include/agent/VecEnvGym.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace utec::nn;
+
+int main() {
+    constexpr std::size_t N = 510;  // no múltiplo de 4: también prueba el paso escalar
+    constexpr int STEPS = 200;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> pos(0.05f, 0.95f);
+    std::uniform_real_distribution<float> vel(0.02f, 0.1f);
+    std::uniform_int_distribution<int> action(-1, 1);
+
+    std::vector<EnvGym> envs(N);
+    VecEnvGym vec(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        State s{pos(gen), pos(gen), pos(gen)};
+        float vx = vel(gen) * (gen() % 2 ? 1 : -1);
+        float vy = vel(gen) * (gen() % 2 ? 1 : -1);
+        envs[i].set_state(s, vx, vy);
+        vec.set_env(i, s, vx, vy);
+    }
+
+    std::vector<int> actions(N);
+    std::vector<bool> finished(N, false);
+    std::size_t compared = 0, mismatches = 0, episodes = 0;
+    for (int t = 0; t < STEPS; ++t) {
+        for (auto& a : actions) a = action(gen);
+        vec.step(actions);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            if (finished[i]) continue;
+            float reward;
+            bool done;
+            State s = envs[i].step(actions[i], reward, done);
+            ++compared;
+            if (done) {
+                // El entorno vectorizado ya se reinició: solo se comparan recompensa y done
+                finished[i] = true;
+                ++episodes;
+                State r = vec.state(i);
+                if (!vec.dones()[i] || vec.rewards()[i] != reward
+                    || r.ball_x != 0.5f || r.ball_y != 0.5f || r.paddle_y != 0.5f)
+                    ++mismatches;
+                continue;
+            }
+            State v = vec.state(i);
+            if (vec.dones()[i] || vec.rewards()[i] != reward || v.ball_x != s.ball_x
+                || v.ball_y != s.ball_y || v.paddle_y != s.paddle_y
+                || vec.ball_vx()[i] != envs[i].ball_vx() || vec.ball_vy()[i] != envs[i].ball_vy())
+                ++mismatches;
+        }
+    }
+
+    std::cout << "=== EQUIVALENCIA CON EnvGym ===\n";
+    std::cout << "Pasos comparados: " << compared << "\n";
+    std::cout << "Episodios terminados: " << episodes << "\n";
+    std::cout << "Diferencias: " << mismatches << "\n";
+
+    constexpr std::size_t BENCH_ENVS = 4096;
+    constexpr int BENCH_STEPS = 2000;
+    VecEnvGym bench(BENCH_ENVS);
+    std::vector<int> bench_actions(BENCH_ENVS);
+    for (auto& a : bench_actions) a = action(gen);
+    std::size_t dones = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < BENCH_STEPS; ++t) {
+        bench.step(bench_actions);
+        dones += bench.dones()[t % BENCH_ENVS];
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n=== RENDIMIENTO ===\n";
+    std::cout << "Entornos: " << BENCH_ENVS << " | Pasos: " << BENCH_STEPS << "\n";
+    std::cout << "Pasos de entorno por segundo: "
+              << static_cast<double>(BENCH_ENVS) * BENCH_STEPS / seconds << "\n";
+    std::cout << "(muestra de dones: " << dones << ")\n";
+
+    if (mismatches != 0 || episodes == 0) {
+        std::cout << "ERROR: VecEnvGym no coincide con EnvGym\n";
+        return 1;
+    }
+    std::cout << "VecEnvGym coincide con EnvGym\n";
+    return 0;
+}